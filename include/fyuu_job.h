@@ -0,0 +1,42 @@
+#pragma once
+#include "api_macro.h"
+#if defined(__cplusplus)
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif // defined(__cplusplus)
+
+#if defined(__cplusplus)
+extern "C" {
+#endif // defined(__cplusplus)
+
+	typedef enum Fyuu_JobPriority {
+		FYUU_JOB_PRIORITY_HIGH,
+		FYUU_JOB_PRIORITY_NORMAL,
+		FYUU_JOB_PRIORITY_LOW
+	} Fyuu_JobPriority;
+
+	typedef struct Fyuu_JobCounter Fyuu_JobCounter;
+
+	typedef void(*Fyuu_JobFunc)(void* user_data);
+	typedef void(*Fyuu_RangeFunc)(size_t begin, size_t end, void* user_data);
+
+	LIB_API uint32_t LIB_CALL Fyuu_GetJobWorkerCount(void);
+
+	LIB_API Fyuu_JobCounter* LIB_CALL Fyuu_CreateJobCounter(void);
+	LIB_API void LIB_CALL Fyuu_DestroyJobCounter(Fyuu_JobCounter* counter);
+
+	/* `counter` may be NULL for fire-and-forget jobs. */
+	LIB_API void LIB_CALL Fyuu_SubmitJob(Fyuu_JobFunc func, void* user_data, Fyuu_JobPriority priority, Fyuu_JobCounter* counter);
+
+	/* Runs other jobs until every job submitted with `counter` has finished. */
+	LIB_API void LIB_CALL Fyuu_WaitJobCounter(Fyuu_JobCounter* counter);
+
+	/* Calls `func` on disjoint subranges of [first, last); a grain of 0 picks one automatically. */
+	LIB_API void LIB_CALL Fyuu_ParallelFor(size_t first, size_t last, size_t grain, Fyuu_RangeFunc func, void* user_data);
+
+#if defined(__cplusplus)
+}
+#endif // defined(__cplusplus)
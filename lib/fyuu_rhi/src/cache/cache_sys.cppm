@@ -11,6 +11,9 @@ module;
 #include <format>
 #include <source_location>
 #include <ranges>
+#include <exception>
+#include <system_error>
+#include <vector>
 #endif // !defined(__cpp_lib_modules)
 #include <boost/hash2/xxhash.hpp>
 #if defined(__ANDROID__)
@@ -23,6 +26,7 @@ import std;
 #endif // defined(__cpp_lib_modules)
 import :core_types;
 import :log;
+import plastic.timer_wheel;
 
 namespace fs = std::filesystem;
 
@@ -41,59 +45,80 @@ namespace {
 	std::once_flag s_cache_init_flag;
 	
 	std::atomic_size_t s_max_cache_size_bytes{ 500u * 1024 * 1024 };
-	std::mutex s_cleanup_mutex;
-	std::chrono::steady_clock::time_point s_last_check_time{};
-	constexpr auto CHECK_COOLDOWN = std::chrono::seconds(30);
+	constexpr auto CLEANUP_INTERVAL = std::chrono::seconds(30);
+
+	// The scan runs on the housekeeping thread while other threads add and
+	// remove cache files, so it only uses the std::error_code overloads and
+	// skips whatever vanished or cannot be read.
 
 	std::size_t CalculateDirSize(fs::path const& dir) {
 		std::size_t size = 0;
 		std::error_code ec;
-		for (auto const& entry : fs::recursive_directory_iterator(dir, ec)) {
-			if (ec) {
-				break;
+		for (fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end;
+			!ec && it != end;
+			it.increment(ec)) {
+			std::error_code entry_ec;
+			if (!it->is_regular_file(entry_ec)) {
+				continue;
 			}
-			if (entry.is_regular_file()) {
-				size += entry.file_size();
+			std::uintmax_t file_size = it->file_size(entry_ec);
+			if (!entry_ec) {
+				size += static_cast<std::size_t>(file_size);
 			}
 		}
 		return size;
 	}
+
 	std::vector<CacheEntry> CollectEntries() {
 		std::vector<CacheEntry> entries;
-		if (s_cache_root.empty() || !fs::exists(s_cache_root)) {
+		std::error_code ec;
+		if (s_cache_root.empty() || !fs::exists(s_cache_root, ec)) {
 			return entries;
 		}
-		std::error_code ec;
-		for (auto const& entry : fs::directory_iterator(s_cache_root, ec)) {
-			if (ec) {
-				break;
+		for (fs::directory_iterator it(s_cache_root, fs::directory_options::skip_permission_denied, ec), end;
+			!ec && it != end;
+			it.increment(ec)) {
+			std::error_code entry_ec;
+			if (!it->is_regular_file(entry_ec)) {
+				continue;
+			}
+			std::uintmax_t size = it->file_size(entry_ec);
+			if (entry_ec) {
+				continue;
 			}
-			if (!entry.is_regular_file()) {
+			fs::file_time_type last_modified = it->last_write_time(entry_ec);
+			if (entry_ec) {
 				continue;
 			}
 			entries.push_back(
 				{
-					.path = entry.path(),
-					.size = entry.file_size(),
-					.last_modified = entry.last_write_time(),
+					.path = it->path(),
+					.size = static_cast<std::size_t>(size),
+					.last_modified = last_modified,
 					.is_bundle = false
 				}
 			);
 		}
 		auto bundles_dir = s_cache_root / "bundles";
-		if (!fs::exists(bundles_dir)) return entries;
-		for (auto const& entry : fs::directory_iterator(bundles_dir, ec)) {
-			if (ec) {
-				break;
+		if (!fs::exists(bundles_dir, ec)) {
+			return entries;
+		}
+		for (fs::directory_iterator it(bundles_dir, fs::directory_options::skip_permission_denied, ec), end;
+			!ec && it != end;
+			it.increment(ec)) {
+			std::error_code entry_ec;
+			if (!it->is_directory(entry_ec)) {
+				continue;
 			}
-			if (!entry.is_directory()) {
+			fs::file_time_type last_modified = it->last_write_time(entry_ec);
+			if (entry_ec) {
 				continue;
 			}
 			entries.push_back(
 				{
-					.path = entry.path(),
-					.size = CalculateDirSize(entry.path()),
-					.last_modified = entry.last_write_time(),
+					.path = it->path(),
+					.size = CalculateDirSize(it->path()),
+					.last_modified = last_modified,
 					.is_bundle = true
 				}
 			);
@@ -101,21 +126,12 @@ namespace {
 		return entries;
 	}
 
-	void LazyCleanup() {
+	/// Evicts the least recently used entries until the cache fits its budget.
+	void Cleanup() {
 		std::size_t max_size = s_max_cache_size_bytes.load(std::memory_order_relaxed);
 		if (max_size == 0) {
 			return;
 		}
-		std::unique_lock lock(s_cleanup_mutex, std::try_to_lock);
-		if (!lock.owns_lock()) {
-			return;
-		}
-
-		auto now = std::chrono::steady_clock::now();
-		if (now - s_last_check_time < CHECK_COOLDOWN) {
-			return;
-		}
-		s_last_check_time = now;
 
 		auto entries = CollectEntries();
 		std::size_t total = 0;
@@ -140,6 +156,26 @@ namespace {
 		}
 	}
 
+	/// Runs cache housekeeping off the request path; started by Initialize().
+	plastic::concurrency::TimerThread& HousekeepingTimer() {
+		static plastic::concurrency::TimerThread timer(
+			std::chrono::seconds(1),
+			nullptr,
+			[](std::exception_ptr ex) {
+				try {
+					std::rethrow_exception(ex);
+				}
+				catch (std::exception const& e) {
+					LOG_ERROR(std::format("cache::Cleanup(): {}", e.what()));
+				}
+				catch (...) {
+					LOG_ERROR("cache::Cleanup(): unknown exception");
+				}
+			}
+		);
+		return timer;
+	}
+
 	fs::path BuildSubdirectory(std::string_view app_name, Version const& app_ver, std::string_view engine_name, Version const& engine_ver) {
 		std::string subdir = std::format("{}/v{}_{}_{}/{}/v{}_{}_{}", engine_name, engine_ver.major, engine_ver.minor, engine_ver.patch, app_name, app_ver.major, app_ver.minor, app_ver.patch);
 		return { subdir };
@@ -265,14 +301,13 @@ namespace fyuu_rhi::cache {
 #endif // defined(_WIN32)
 				s_cache_root /= BuildSubdirectory(app_name, app_ver, engine_name, engine_ver);
 				fs::create_directories(s_cache_root);
+				HousekeepingTimer().ScheduleEvery(CLEANUP_INTERVAL, &Cleanup, std::chrono::seconds(0));
 			}
 		);
 	}
 
 	fs::path GetCacheFilePath(std::string_view key) {
 
-		LazyCleanup();
-
 		auto dot_pos = key.rfind('.');
 		std::string_view ext = dot_pos != std::string_view::npos && dot_pos != 0 ? key.substr(dot_pos) : std::string_view{};
 		boost::hash2::xxhash_64 hasher;
@@ -293,8 +328,6 @@ namespace fyuu_rhi::cache {
 
 	fs::path GetCacheDirectory(std::string_view key) {
 
-		LazyCleanup();
-
 		boost::hash2::xxhash_64 hasher;
 		hasher.update(key.data(), key.size());
 		std::uint64_t hash = hasher.result();
@@ -6,9 +6,8 @@
 #include <atomic>
 #include <thread>
 #include <optional>
+#include <span>
 #endif
-#include <boost/lockfree/policies.hpp>
-#include <boost/lockfree/queue.hpp>
 #if defined(_WIN32)
 #include <DescriptorHeap.h>
 #endif // defined(_WIN32)
@@ -17,39 +16,60 @@ export module fyuu_rhi:d3d12_descriptor_allocator;
 #if defined(__cpp_lib_modules)
 import std;
 #endif
+import plastic.index_allocator;
+import plastic.wait_strategy;
 
 namespace {
 
 	class DescriptorHeap : public DirectX::DescriptorHeap {
 	private:
-		boost::lockfree::queue<std::size_t> m_free_indices;
+		plastic::concurrency::IndexAllocator m_free_indices;
 
-	public:
-		DescriptorHeap(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, std::size_t total_desc, bool shader_visible)
-			: DirectX::DescriptorHeap(dev, type, shader_visible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE, total_desc),
-			m_free_indices(total_desc) {
-			for (std::size_t i = 0; i < total_desc; ++i) {
-				m_free_indices.push(i);
-			}
-		}
-
-		std::size_t Acquire() {
-			std::size_t index;
+		// Waits for other threads to release descriptors once the heap is exhausted.
+		template <class TryAcquire>
+		static void WaitFor(TryAcquire&& try_acquire) {
+			plastic::concurrency::Backoff backoff;
 			std::size_t spin_count = 0;
-			while (!m_free_indices.pop(index)) {
-				if (++spin_count > 100u) {
-					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			while (!try_acquire()) {
+				if (backoff.IsSpinning()) {
+					backoff.Pause();
+				}
+				else if (++spin_count > 100u) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
 					spin_count = 0;
 				}
 				else {
 					std::this_thread::yield();
 				}
 			}
-			return index;
 		}
 
-		void Release(std::size_t index) {
-			m_free_indices.push(index);
+	public:
+		DescriptorHeap(ID3D12Device* dev, D3D12_DESCRIPTOR_HEAP_TYPE type, std::size_t total_desc, bool shader_visible)
+			: DirectX::DescriptorHeap(dev, type, shader_visible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE, total_desc),
+			m_free_indices(total_desc) {
+		}
+
+		std::size_t Acquire() {
+			std::optional<std::size_t> index;
+			WaitFor([this, &index]() {
+				index = m_free_indices.Allocate();
+				return index.has_value();
+			});
+			return *index;
+		}
+
+		/// Fills `indices` with free descriptor slots, claiming them a word at a time.
+		void AcquireBulk(std::span<std::size_t> indices) {
+			std::size_t acquired = 0;
+			WaitFor([this, indices, &acquired]() {
+				acquired += m_free_indices.AllocateBulk(indices.subspan(acquired));
+				return acquired == indices.size();
+			});
+		}
+
+		void Release(std::size_t index) noexcept {
+			m_free_indices.Free(index);
 		}
 	};
 
@@ -78,10 +98,9 @@ namespace fyuu_rhi::d3d12 {
 
 		ManagedDescriptorHandle(ManagedDescriptorHandle&& other) noexcept
 			: m_heap(std::move(other.m_heap)),
-			m_idx(std::move(other.m_idx)),
+			m_idx(std::exchange(other.m_idx, std::nullopt)),
 			m_cpu(std::exchange(other.m_cpu, {})),
 			m_gpu(std::exchange(other.m_gpu, {})) {
-			m_idx.reset();
 		}
 
 		ManagedDescriptorHandle& operator=(ManagedDescriptorHandle&& other) noexcept {
@@ -90,8 +109,7 @@ namespace fyuu_rhi::d3d12 {
 					m_heap->Release(*m_idx);
 				}
 				m_heap = std::move(other.m_heap);
-				m_idx = std::move(other.m_idx);
-				m_idx.reset();
+				m_idx = std::exchange(other.m_idx, std::nullopt);
 				m_cpu = std::exchange(other.m_cpu, {});
 				m_gpu = std::exchange(other.m_gpu, {});
 			}
@@ -129,8 +147,8 @@ namespace fyuu_rhi::d3d12 {
 		DescriptorAllocator(DescriptorAllocator const& other) noexcept = default;
 		DescriptorAllocator(DescriptorAllocator&& other) noexcept = default;
 
-		std::shared_ptr<ManagedDescriptorHandle> Allocate() {
-			std::size_t idx = m_heap->Acquire();
+	private:
+		std::shared_ptr<ManagedDescriptorHandle> MakeHandle(std::size_t idx) {
 			D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle = m_heap->GetCpuHandle(idx);
 			if (m_heap->Flags() & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) {
 				D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle = m_heap->GetGpuHandle(idx);
@@ -141,11 +159,28 @@ namespace fyuu_rhi::d3d12 {
 			}
 		}
 
+	public:
+		std::shared_ptr<ManagedDescriptorHandle> Allocate() {
+			return MakeHandle(m_heap->Acquire());
+		}
+
 		template <std::size_t Count>
 		std::array<std::shared_ptr<ManagedDescriptorHandle>, Count> AllocateBatch() {
+			std::array<std::size_t, Count> indices;
+			m_heap->AcquireBulk(indices);
 			std::array<std::shared_ptr<ManagedDescriptorHandle>, Count> allocations;
-			for (std::size_t i = 0; i < Count; ++i) {
-				allocations[i] = Allocate();
+			std::size_t i = 0;
+			try {
+				for (; i < Count; ++i) {
+					allocations[i] = MakeHandle(indices[i]);
+				}
+			}
+			catch (...) {
+				// Handles already built release their own index.
+				for (; i < Count; ++i) {
+					m_heap->Release(indices[i]);
+				}
+				throw;
 			}
 			return allocations;
 		}
@@ -56,6 +56,7 @@ import :native_pipeline_binding;
 import plastic.static_list;
 import plastic.static_hash_table;
 import plastic.lru;
+import plastic.object_pool;
 
 namespace fs = std::filesystem;
 
@@ -65,7 +66,7 @@ namespace {
 	using namespace fyuu_rhi::pipeline;
 	using namespace fyuu_rhi::d3d12;
 
-	std::pmr::synchronized_pool_resource s_res_pool{};
+	plastic::concurrency::PoolResource s_res_pool{};
 
 	DXGI_FORMAT ExtractFormat(ResourceFlags const& flags);
 	UINT ExtractSampleCount(ResourceFlags const& flags);
@@ -352,60 +353,52 @@ namespace {
 			}
 		};
 
-		using List = plastic::ds::StaticList<std::pair<MSAAQualityCacheKey const, UINT>, 64u>;
+		static plastic::ds::ShardedLRUCache<MSAAQualityCacheKey, UINT, 64u, 8u, MSAAQualityCacheKeyHash> cache;
+
+		return cache.GetOrCompute(
+			MSAAQualityCacheKey{ device, format, sample_cnt, flags },
+			[device, format, sample_cnt, flags]() {
+				D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS query = {
+					.Format = format,
+					.SampleCount = sample_cnt,
+					.Flags = flags,
+					.NumQualityLevels = 0,
+				};
+
+				HRESULT hr = device->CheckFeatureSupport(
+					D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS,
+					&query,
+					sizeof(query)
+				);
+				return SUCCEEDED(hr) ? query.NumQualityLevels : 0u;
+			}
+		);
 
-		static plastic::ds::LRUCache<
-			plastic::ds::StaticHashTable<MSAAQualityCacheKey, typename List::iterator, 64u, MSAAQualityCacheKeyHash>,
-			List,
-			64u
-		> cache;
-		static std::mutex mutex;
+	}
 
-		MSAAQualityCacheKey key{ device, format, sample_cnt, flags };
-		if (std::unique_lock<std::mutex> lock(mutex); cache.Contains(key)) {
-			return cache.Get(key);
+	constexpr auto kAllocationTypeTable = AllocationTypeFlags::MakeTable([](ResourceFlagBits bit) -> D3D12MA::ALLOCATION_FLAGS {
+		switch (bit) {
+		case ResourceFlagBits::UndedicatedAllocation: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_NEVER_ALLOCATE;
+		case ResourceFlagBits::DedicatedAllocation: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_COMMITTED;
+		default: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_NONE;
 		}
+	});
 
-		D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS query = {
-			.Format = format,
-			.SampleCount = sample_cnt,
-			.Flags = flags,
-			.NumQualityLevels = 0,
-		};
-
-		HRESULT hr = device->CheckFeatureSupport(
-			D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS,
-			&query,
-			sizeof(query)
-		);
-		UINT quality_lvls = SUCCEEDED(hr) ? query.NumQualityLevels : 0u;
-
-		{
-			std::unique_lock<std::mutex> lock(mutex);
-			cache.Put(key, quality_lvls);
+	constexpr auto kAllocationStrategyTable = AllocationStrategyFlags::MakeTable([](ResourceFlagBits bit) -> D3D12MA::ALLOCATION_FLAGS {
+		switch (bit) {
+		case ResourceFlagBits::MinOffsetAllocation: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_MIN_OFFSET;
+		case ResourceFlagBits::BestFitAllocation: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_BEST_FIT;
+		case ResourceFlagBits::FirstFitAllocation: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_FIRST_FIT;
+		default: return D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_NONE;
 		}
-
-		return quality_lvls;
-
-	}
+	});
 
 	D3D12MA::ALLOCATION_FLAGS ExtractAllocationFlags(ResourceFlags const& flags) {
 
 		D3D12MA::ALLOCATION_FLAGS d3d12ma_flags{};
 
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::UndedicatedAllocation, ResourceFlagBits::DedicatedAllocation);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractAllocationFlags(): UndedicatedAllocation and DedicatedAllocation are set simultaneously");
-		}
-		
-		if (flags.Test(ResourceFlagBits::UndedicatedAllocation)) {
-			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_NEVER_ALLOCATE;
-		}
-		else if (flags.Test(ResourceFlagBits::DedicatedAllocation)) {
-			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_COMMITTED;
-		}
-		else {
-
+		if (auto type = AllocationTypeFlags::Select(flags, "ExtractAllocationFlags(): UndedicatedAllocation and DedicatedAllocation are set simultaneously")) {
+			d3d12ma_flags |= kAllocationTypeTable[*type];
 		}
 
 		if (flags.Test(ResourceFlagBits::AllocationWithinBudget)) {
@@ -418,67 +411,45 @@ namespace {
 			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_CAN_ALIAS;
 		}
 
-		is_conflicting = flags.TestSingleInRange(ResourceFlagBits::MinOffsetAllocation, ResourceFlagBits::FirstFitAllocation);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractAllocationFlags(): MinOffsetAllocation BestFitAllocation or FirstFitAllocation are set simultaneously");
-		}
-		else if (flags.Test(ResourceFlagBits::MinOffsetAllocation)) {
-			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_MIN_OFFSET;
-		}
-		else if (flags.Test(ResourceFlagBits::BestFitAllocation)) {
-			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_BEST_FIT;
-		}
-		else if (flags.Test(ResourceFlagBits::FirstFitAllocation)) {
-			d3d12ma_flags |= D3D12MA::ALLOCATION_FLAGS::ALLOCATION_FLAG_STRATEGY_FIRST_FIT;
-		}
-		else {
-
+		if (auto strategy = AllocationStrategyFlags::Select(flags, "ExtractAllocationFlags(): MinOffsetAllocation BestFitAllocation or FirstFitAllocation are set simultaneously")) {
+			d3d12ma_flags |= kAllocationStrategyTable[*strategy];
 		}
 
 		return d3d12ma_flags;
 
 	}
 
-	D3D12_HEAP_TYPE ExtractHeapType(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractHeapType(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-
-		if (flags.Test(ResourceFlagBits::DeviceLocal)) {
-			return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_DEFAULT;
-		}
-		else if (flags.Test(ResourceFlagBits::HostVisible)) {
-			return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_UPLOAD;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_READBACK;
-		} 
-		else {
-			return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_DEFAULT;
+	constexpr auto kHeapTypeTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_HEAP_TYPE {
+		switch (bit) {
+		case ResourceFlagBits::DeviceLocal: return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_DEFAULT;
+		case ResourceFlagBits::HostVisible: return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_UPLOAD;
+		case ResourceFlagBits::DeviceReadback: return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_READBACK;
+		default: return D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_DEFAULT;
 		}
+	});
 
+	D3D12_HEAP_TYPE ExtractHeapType(ResourceFlags const& flags) {
+		auto member = MemoryLocationFlags::Select(flags, "ExtractHeapType(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
+		return member ? kHeapTypeTable[*member] : D3D12_HEAP_TYPE::D3D12_HEAP_TYPE_DEFAULT;
 	}
 
 	D3D12_RESOURCE_FLAGS ExtractResourceFlags(ResourceFlags const& flags) noexcept {
 		
 		D3D12_RESOURCE_FLAGS res_flags = D3D12_RESOURCE_FLAG_NONE;
 
-		if (flags.Test(ResourceFlagBits::StorageTexelBuffer) ||
-			flags.Test(ResourceFlagBits::StorageBuffer) ||
-			flags.Test(ResourceFlagBits::StorageBinding) ||
-			flags.Test(ResourceFlagBits::StorageAttachment)) {
+		constexpr ResourceFlags kUnorderedAccess(
+			ResourceFlagBits::StorageTexelBuffer,
+			ResourceFlagBits::StorageBuffer,
+			ResourceFlagBits::StorageBinding,
+			ResourceFlagBits::StorageAttachment
+		);
+		if (flags.TestAny(kUnorderedAccess)) {
 			res_flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
 		}
 
 		if (flags.Test(ResourceFlagBits::RenderAttachment)) {
-			bool is_ds =
-				flags.Test(ResourceFlagBits::D16Unorm) ||
-				flags.Test(ResourceFlagBits::D24UnormS8Uint) ||
-				flags.Test(ResourceFlagBits::D32Float) ||
-				flags.Test(ResourceFlagBits::D32FloatS8X24Uint);
-
-			if (is_ds) {
+			constexpr ResourceFlags kDepthStencilFormats = ResourceFlags::FromRange(ResourceFlagBits::D16Unorm, ResourceFlagBits::D32FloatS8X24Uint);
+			if (flags.TestAny(kDepthStencilFormats)) {
 				res_flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
 			}
 			else {
@@ -490,239 +461,205 @@ namespace {
 
 	}
 
-	D3D12_RESOURCE_STATES DetermineInitialState(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("DetermineInitialState(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::DeviceLocal)) {
-			return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
-		}
-		else if (flags.Test(ResourceFlagBits::HostVisible)) {
-			return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_GENERIC_READ;
+	constexpr auto kInitialStateTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_RESOURCE_STATES {
+		switch (bit) {
+		case ResourceFlagBits::DeviceLocal: return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
+		case ResourceFlagBits::HostVisible: return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_GENERIC_READ;
+		case ResourceFlagBits::DeviceReadback: return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COPY_DEST;
+		default: return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
 		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COPY_DEST;
-		}
-		else {
-			return D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
-		}
-	}
+	});
 
-	DXGI_FORMAT ExtractFormat(ResourceFlags const& flags) {
-
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::R8Unorm, ResourceFlagBits::Bc7UnormSrgb);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractFormat(): Only one format can be set");
-		}
+	D3D12_RESOURCE_STATES DetermineInitialState(ResourceFlags const& flags) {
+		auto member = MemoryLocationFlags::Select(flags, "DetermineInitialState(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
+		return member ? kInitialStateTable[*member] : D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
+	}
 
+	constexpr auto kFormatTable = FormatFlags::MakeTable([](ResourceFlagBits bit) -> DXGI_FORMAT {
+		switch (bit) {
 		// 8‑bit per component (1‑channel)
-		if (flags.Test(ResourceFlagBits::R8Unorm)) return DXGI_FORMAT_R8_UNORM;
-		else if (flags.Test(ResourceFlagBits::R8Snorm)) return DXGI_FORMAT_R8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8Uint)) return DXGI_FORMAT_R8_UINT;
-		else if (flags.Test(ResourceFlagBits::R8Sint)) return DXGI_FORMAT_R8_SINT;
-	
+		case ResourceFlagBits::R8Unorm: return DXGI_FORMAT_R8_UNORM;
+		case ResourceFlagBits::R8Snorm: return DXGI_FORMAT_R8_SNORM;
+		case ResourceFlagBits::R8Uint: return DXGI_FORMAT_R8_UINT;
+		case ResourceFlagBits::R8Sint: return DXGI_FORMAT_R8_SINT;
+
 		// 8‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8Unorm)) return DXGI_FORMAT_R8G8_UNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8Snorm)) return DXGI_FORMAT_R8G8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8Uint)) return DXGI_FORMAT_R8G8_UINT;
-		else if (flags.Test(ResourceFlagBits::R8G8Sint)) return DXGI_FORMAT_R8G8_SINT;
-	
+		case ResourceFlagBits::R8G8Unorm: return DXGI_FORMAT_R8G8_UNORM;
+		case ResourceFlagBits::R8G8Snorm: return DXGI_FORMAT_R8G8_SNORM;
+		case ResourceFlagBits::R8G8Uint: return DXGI_FORMAT_R8G8_UINT;
+		case ResourceFlagBits::R8G8Sint: return DXGI_FORMAT_R8G8_SINT;
+
 		// 8‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Unorm)) return DXGI_FORMAT_R8G8B8A8_UNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Snorm)) return DXGI_FORMAT_R8G8B8A8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Uint)) return DXGI_FORMAT_R8G8B8A8_UINT;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Sint)) return DXGI_FORMAT_R8G8B8A8_SINT;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Srgb)) return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
-		else if (flags.Test(ResourceFlagBits::B8G8R8A8Srgb)) return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
-	
+		case ResourceFlagBits::R8G8B8A8Unorm: return DXGI_FORMAT_R8G8B8A8_UNORM;
+		case ResourceFlagBits::R8G8B8A8Snorm: return DXGI_FORMAT_R8G8B8A8_SNORM;
+		case ResourceFlagBits::R8G8B8A8Uint: return DXGI_FORMAT_R8G8B8A8_UINT;
+		case ResourceFlagBits::R8G8B8A8Sint: return DXGI_FORMAT_R8G8B8A8_SINT;
+		case ResourceFlagBits::R8G8B8A8Srgb: return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+		case ResourceFlagBits::B8G8R8A8Srgb: return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+
 		// 16‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R16Unorm)) return DXGI_FORMAT_R16_UNORM;
-		else if (flags.Test(ResourceFlagBits::R16Snorm)) return DXGI_FORMAT_R16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16Uint)) return DXGI_FORMAT_R16_UINT;
-		else if (flags.Test(ResourceFlagBits::R16Sint)) return DXGI_FORMAT_R16_SINT;
-		else if (flags.Test(ResourceFlagBits::R16Float)) return DXGI_FORMAT_R16_FLOAT;
-	
+		case ResourceFlagBits::R16Unorm: return DXGI_FORMAT_R16_UNORM;
+		case ResourceFlagBits::R16Snorm: return DXGI_FORMAT_R16_SNORM;
+		case ResourceFlagBits::R16Uint: return DXGI_FORMAT_R16_UINT;
+		case ResourceFlagBits::R16Sint: return DXGI_FORMAT_R16_SINT;
+		case ResourceFlagBits::R16Float: return DXGI_FORMAT_R16_FLOAT;
+
 		// 16‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16Unorm)) return DXGI_FORMAT_R16G16_UNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16Snorm)) return DXGI_FORMAT_R16G16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16Uint)) return DXGI_FORMAT_R16G16_UINT;
-		else if (flags.Test(ResourceFlagBits::R16G16Sint)) return DXGI_FORMAT_R16G16_SINT;
-		else if (flags.Test(ResourceFlagBits::R16G16Float)) return DXGI_FORMAT_R16G16_FLOAT;
-	
+		case ResourceFlagBits::R16G16Unorm: return DXGI_FORMAT_R16G16_UNORM;
+		case ResourceFlagBits::R16G16Snorm: return DXGI_FORMAT_R16G16_SNORM;
+		case ResourceFlagBits::R16G16Uint: return DXGI_FORMAT_R16G16_UINT;
+		case ResourceFlagBits::R16G16Sint: return DXGI_FORMAT_R16G16_SINT;
+		case ResourceFlagBits::R16G16Float: return DXGI_FORMAT_R16G16_FLOAT;
+
 		// 16‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Unorm)) return DXGI_FORMAT_R16G16B16A16_UNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Snorm)) return DXGI_FORMAT_R16G16B16A16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Uint)) return DXGI_FORMAT_R16G16B16A16_UINT;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Sint)) return DXGI_FORMAT_R16G16B16A16_SINT;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Float)) return DXGI_FORMAT_R16G16B16A16_FLOAT;
-	
+		case ResourceFlagBits::R16G16B16A16Unorm: return DXGI_FORMAT_R16G16B16A16_UNORM;
+		case ResourceFlagBits::R16G16B16A16Snorm: return DXGI_FORMAT_R16G16B16A16_SNORM;
+		case ResourceFlagBits::R16G16B16A16Uint: return DXGI_FORMAT_R16G16B16A16_UINT;
+		case ResourceFlagBits::R16G16B16A16Sint: return DXGI_FORMAT_R16G16B16A16_SINT;
+		case ResourceFlagBits::R16G16B16A16Float: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+
 		// 32‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R32Uint)) return DXGI_FORMAT_R32_UINT;
-		else if (flags.Test(ResourceFlagBits::R32Sint)) return DXGI_FORMAT_R32_SINT;
-		else if (flags.Test(ResourceFlagBits::R32Float)) return DXGI_FORMAT_R32_FLOAT;
-	
+		case ResourceFlagBits::R32Uint: return DXGI_FORMAT_R32_UINT;
+		case ResourceFlagBits::R32Sint: return DXGI_FORMAT_R32_SINT;
+		case ResourceFlagBits::R32Float: return DXGI_FORMAT_R32_FLOAT;
+
 		// 32‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32Uint)) return DXGI_FORMAT_R32G32_UINT;
-		else if (flags.Test(ResourceFlagBits::R32G32Sint)) return DXGI_FORMAT_R32G32_SINT;
-		else if (flags.Test(ResourceFlagBits::R32G32Float)) return DXGI_FORMAT_R32G32_FLOAT;
-	
+		case ResourceFlagBits::R32G32Uint: return DXGI_FORMAT_R32G32_UINT;
+		case ResourceFlagBits::R32G32Sint: return DXGI_FORMAT_R32G32_SINT;
+		case ResourceFlagBits::R32G32Float: return DXGI_FORMAT_R32G32_FLOAT;
+
 		// 32‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Uint)) return DXGI_FORMAT_R32G32B32A32_UINT;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Sint)) return DXGI_FORMAT_R32G32B32A32_SINT;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Float)) return DXGI_FORMAT_R32G32B32A32_FLOAT;
-	
+		case ResourceFlagBits::R32G32B32A32Uint: return DXGI_FORMAT_R32G32B32A32_UINT;
+		case ResourceFlagBits::R32G32B32A32Sint: return DXGI_FORMAT_R32G32B32A32_SINT;
+		case ResourceFlagBits::R32G32B32A32Float: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+
 		// Packed formats (note: DXGI uses BGR ordering for 5/6/5 and 5/5/5/1)
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Unorm)) return DXGI_FORMAT_R10G10B10A2_UNORM;
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Uint)) return DXGI_FORMAT_R10G10B10A2_UINT;
-		else if (flags.Test(ResourceFlagBits::R11G11B10Float)) return DXGI_FORMAT_R11G11B10_FLOAT;
-		else if (flags.Test(ResourceFlagBits::R9G9B9E5SharedExp)) return DXGI_FORMAT_R9G9B9E5_SHAREDEXP;
-	
+		case ResourceFlagBits::R10G10B10A2Unorm: return DXGI_FORMAT_R10G10B10A2_UNORM;
+		case ResourceFlagBits::R10G10B10A2Uint: return DXGI_FORMAT_R10G10B10A2_UINT;
+		case ResourceFlagBits::R11G11B10Float: return DXGI_FORMAT_R11G11B10_FLOAT;
+		case ResourceFlagBits::R9G9B9E5SharedExp: return DXGI_FORMAT_R9G9B9E5_SHAREDEXP;
+
 		// Depth/stencil
-		else if (flags.Test(ResourceFlagBits::D16Unorm)) return DXGI_FORMAT_D16_UNORM;
-		else if (flags.Test(ResourceFlagBits::D24UnormS8Uint)) return DXGI_FORMAT_D24_UNORM_S8_UINT;
-		else if (flags.Test(ResourceFlagBits::D32Float)) return DXGI_FORMAT_D32_FLOAT;
-		else if (flags.Test(ResourceFlagBits::D32FloatS8X24Uint)) return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
-	
+		case ResourceFlagBits::D16Unorm: return DXGI_FORMAT_D16_UNORM;
+		case ResourceFlagBits::D24UnormS8Uint: return DXGI_FORMAT_D24_UNORM_S8_UINT;
+		case ResourceFlagBits::D32Float: return DXGI_FORMAT_D32_FLOAT;
+		case ResourceFlagBits::D32FloatS8X24Uint: return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+
 		// BC compressed formats
-		else if (flags.Test(ResourceFlagBits::Bc1Unorm)) return DXGI_FORMAT_BC1_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc1UnormSrgb)) return DXGI_FORMAT_BC1_UNORM_SRGB;
-		else if (flags.Test(ResourceFlagBits::Bc2Unorm)) return DXGI_FORMAT_BC2_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc2UnormSrgb)) return DXGI_FORMAT_BC2_UNORM_SRGB;
-		else if (flags.Test(ResourceFlagBits::Bc3Unorm)) return DXGI_FORMAT_BC3_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc3UnormSrgb)) return DXGI_FORMAT_BC3_UNORM_SRGB;
-		else if (flags.Test(ResourceFlagBits::Bc4Unorm)) return DXGI_FORMAT_BC4_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc4Snorm)) return DXGI_FORMAT_BC4_SNORM;
-		else if (flags.Test(ResourceFlagBits::Bc5Unorm)) return DXGI_FORMAT_BC5_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc5Snorm)) return DXGI_FORMAT_BC5_SNORM;
-		else if (flags.Test(ResourceFlagBits::Bc6HUfloat)) return DXGI_FORMAT_BC6H_UF16;
-		else if (flags.Test(ResourceFlagBits::Bc6HSfloat)) return DXGI_FORMAT_BC6H_SF16;
-		else if (flags.Test(ResourceFlagBits::Bc7Unorm)) return DXGI_FORMAT_BC7_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc7UnormSrgb)) return DXGI_FORMAT_BC7_UNORM_SRGB;
-
-		else return DXGI_FORMAT_UNKNOWN;
+		case ResourceFlagBits::Bc1Unorm: return DXGI_FORMAT_BC1_UNORM;
+		case ResourceFlagBits::Bc1UnormSrgb: return DXGI_FORMAT_BC1_UNORM_SRGB;
+		case ResourceFlagBits::Bc2Unorm: return DXGI_FORMAT_BC2_UNORM;
+		case ResourceFlagBits::Bc2UnormSrgb: return DXGI_FORMAT_BC2_UNORM_SRGB;
+		case ResourceFlagBits::Bc3Unorm: return DXGI_FORMAT_BC3_UNORM;
+		case ResourceFlagBits::Bc3UnormSrgb: return DXGI_FORMAT_BC3_UNORM_SRGB;
+		case ResourceFlagBits::Bc4Unorm: return DXGI_FORMAT_BC4_UNORM;
+		case ResourceFlagBits::Bc4Snorm: return DXGI_FORMAT_BC4_SNORM;
+		case ResourceFlagBits::Bc5Unorm: return DXGI_FORMAT_BC5_UNORM;
+		case ResourceFlagBits::Bc5Snorm: return DXGI_FORMAT_BC5_SNORM;
+		case ResourceFlagBits::Bc6HUfloat: return DXGI_FORMAT_BC6H_UF16;
+		case ResourceFlagBits::Bc6HSfloat: return DXGI_FORMAT_BC6H_SF16;
+		case ResourceFlagBits::Bc7Unorm: return DXGI_FORMAT_BC7_UNORM;
+		case ResourceFlagBits::Bc7UnormSrgb: return DXGI_FORMAT_BC7_UNORM_SRGB;
+		default: return DXGI_FORMAT_UNKNOWN;
+		}
+	});
 
+	DXGI_FORMAT ExtractFormat(ResourceFlags const& flags) {
+		auto member = FormatFlags::Select(flags, "ExtractFormat(): Only one format can be set");
+		return member ? kFormatTable[*member] : DXGI_FORMAT_UNKNOWN;
 	}
 
-	UINT ExtractSampleCount(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Sample1, ResourceFlagBits::Sample64);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractSampleCount(): Only sample count can be set");
-		}
-		else if (flags.Test(ResourceFlagBits::Sample1)) {
-			return 1u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample2)) {
-			return 2u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample4)) {
-			return 4u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample8)) {
-			return 8u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample16)) {
-			return 16u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample32)) {
-			return 32u;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample64)) {
-			return 64u;
-		}
-		else {
-			return 1u;
+	constexpr auto kSampleCountTable = SampleCountFlags::MakeTable([](ResourceFlagBits bit) -> UINT {
+		switch (bit) {
+		case ResourceFlagBits::Sample1: return 1u;
+		case ResourceFlagBits::Sample2: return 2u;
+		case ResourceFlagBits::Sample4: return 4u;
+		case ResourceFlagBits::Sample8: return 8u;
+		case ResourceFlagBits::Sample16: return 16u;
+		case ResourceFlagBits::Sample32: return 32u;
+		case ResourceFlagBits::Sample64: return 64u;
+		default: return 1u;
 		}
+	});
 
+	UINT ExtractSampleCount(ResourceFlags const& flags) {
+		auto member = SampleCountFlags::Select(flags, "ExtractSampleCount(): Only sample count can be set");
+		return member ? kSampleCountTable[*member] : 1u;
 	}
 
-	D3D12_TEXTURE_LAYOUT ExtractTextureLayout(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractTextureLayout(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceLocal)) {
-			return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_UNKNOWN;
-		}
-		else if (flags.Test(ResourceFlagBits::HostVisible)) {
-			return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-		}
-		else {
-			return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_UNKNOWN;			
+	constexpr auto kTextureLayoutTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_TEXTURE_LAYOUT {
+		switch (bit) {
+		case ResourceFlagBits::DeviceLocal: return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_UNKNOWN;
+		case ResourceFlagBits::HostVisible: return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+		case ResourceFlagBits::DeviceReadback: return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+		default: return D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_UNKNOWN;
 		}
+	});
+
+	D3D12_TEXTURE_LAYOUT ExtractTextureLayout(ResourceFlags const& flags) {
+		auto member = MemoryLocationFlags::Select(flags, "ExtractTextureLayout(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
+		return member ? kTextureLayoutTable[*member] : D3D12_TEXTURE_LAYOUT::D3D12_TEXTURE_LAYOUT_UNKNOWN;
 	}
 
+	constexpr auto kSRVDimensionTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_SRV_DIMENSION {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return D3D12_SRV_DIMENSION_TEXTURE1D;
+		case ResourceFlagBits::TextureView2D: return D3D12_SRV_DIMENSION_TEXTURE2D;
+		case ResourceFlagBits::TextureView2DArray: return D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+		case ResourceFlagBits::TextureView3D: return D3D12_SRV_DIMENSION_TEXTURE3D;
+		case ResourceFlagBits::TextureViewCube: return D3D12_SRV_DIMENSION_TEXTURECUBE;
+		case ResourceFlagBits::TextureViewCubeArray: return D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
+		default: return D3D12_SRV_DIMENSION_TEXTURE2D;
+		}
+	});
+
 	D3D12_SRV_DIMENSION ExtractSRVDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractSRVDimension(): Only one texture view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return D3D12_SRV_DIMENSION_TEXTURE1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return D3D12_SRV_DIMENSION_TEXTURE2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
-		else if (flags.Test(ResourceFlagBits::TextureView3D))
-			return D3D12_SRV_DIMENSION_TEXTURE3D;
-		else if (flags.Test(ResourceFlagBits::TextureViewCube))
-			return D3D12_SRV_DIMENSION_TEXTURECUBE;
-		else if (flags.Test(ResourceFlagBits::TextureViewCubeArray))
-			return D3D12_SRV_DIMENSION_TEXTURECUBEARRAY;
-		else 
-			return D3D12_SRV_DIMENSION_TEXTURE2D;
+		auto member = TextureViewTypeFlags::Select(flags, "ExtractSRVDimension(): Only one texture view type can be set");
+		return member ? kSRVDimensionTable[*member] : D3D12_SRV_DIMENSION_TEXTURE2D;
 	}
 
+	constexpr auto kUAVDimensionTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_UAV_DIMENSION {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return D3D12_UAV_DIMENSION_TEXTURE1D;
+		case ResourceFlagBits::TextureView2D: return D3D12_UAV_DIMENSION_TEXTURE2D;
+		case ResourceFlagBits::TextureView2DArray: return D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
+		case ResourceFlagBits::TextureView3D: return D3D12_UAV_DIMENSION_TEXTURE3D;
+		default: return D3D12_UAV_DIMENSION_TEXTURE2D;
+		}
+	});
+
 	D3D12_UAV_DIMENSION ExtractUAVDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractUAVDimension(): Only one texture view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return D3D12_UAV_DIMENSION_TEXTURE1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return D3D12_UAV_DIMENSION_TEXTURE2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return D3D12_UAV_DIMENSION_TEXTURE2DARRAY;
-		else if (flags.Test(ResourceFlagBits::TextureView3D))
-			return D3D12_UAV_DIMENSION_TEXTURE3D;
-		else
-			return D3D12_UAV_DIMENSION_TEXTURE2D;
+		auto member = TextureViewTypeFlags::Select(flags, "ExtractUAVDimension(): Only one texture view type can be set");
+		return member ? kUAVDimensionTable[*member] : D3D12_UAV_DIMENSION_TEXTURE2D;
 	}
 
+	constexpr auto kRTVDimensionTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_RTV_DIMENSION {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return D3D12_RTV_DIMENSION_TEXTURE1D;
+		case ResourceFlagBits::TextureView2D: return D3D12_RTV_DIMENSION_TEXTURE2D;
+		case ResourceFlagBits::TextureView2DArray: return D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+		case ResourceFlagBits::TextureView3D: return D3D12_RTV_DIMENSION_TEXTURE3D;
+		default: return D3D12_RTV_DIMENSION_TEXTURE2D;
+		}
+	});
+
 	D3D12_RTV_DIMENSION ExtractRTVDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractRTVDimension(): Only one texture view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return D3D12_RTV_DIMENSION_TEXTURE1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return D3D12_RTV_DIMENSION_TEXTURE2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
-		else if (flags.Test(ResourceFlagBits::TextureView3D))
-			return D3D12_RTV_DIMENSION_TEXTURE3D;
-		else
-			return D3D12_RTV_DIMENSION_TEXTURE2D;
+		auto member = TextureViewTypeFlags::Select(flags, "ExtractRTVDimension(): Only one texture view type can be set");
+		return member ? kRTVDimensionTable[*member] : D3D12_RTV_DIMENSION_TEXTURE2D;
 	}
 
+	constexpr auto kDSVDimensionTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> D3D12_DSV_DIMENSION {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return D3D12_DSV_DIMENSION_TEXTURE1D;
+		case ResourceFlagBits::TextureView2D: return D3D12_DSV_DIMENSION_TEXTURE2D;
+		case ResourceFlagBits::TextureView2DArray: return D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+		default: return D3D12_DSV_DIMENSION_TEXTURE2D;
+		}
+	});
+
 	D3D12_DSV_DIMENSION ExtractDSVDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractDSVDimension(): Only one texture view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return D3D12_DSV_DIMENSION_TEXTURE1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return D3D12_DSV_DIMENSION_TEXTURE2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
-		else
-			return D3D12_DSV_DIMENSION_TEXTURE2D;
+		auto member = TextureViewTypeFlags::Select(flags, "ExtractDSVDimension(): Only one texture view type can be set");
+		return member ? kDSVDimensionTable[*member] : D3D12_DSV_DIMENSION_TEXTURE2D;
 	}
 
 	bool IsDepthStencilFormat(DXGI_FORMAT format) noexcept {
@@ -930,7 +867,7 @@ namespace {
 		using List = plastic::ds::StaticList<std::pair<LUID const, DXDriverVersion>, 8u>;
 
 		static plastic::ds::LRUCache<
-			plastic::ds::StaticHashTable<LUID, typename List::iterator, 8u, LUIDHasher, LUIDEqual>,
+			plastic::ds::StaticSwissTable<LUID, typename List::iterator, 8u, LUIDHasher, LUIDEqual>,
 			List,
 			8u
 		> cache;
@@ -1098,10 +1035,7 @@ namespace fyuu_rhi::d3d12 {
 		D3D12_RESOURCE_FLAGS res_flags = ExtractResourceFlags(flags);
 		D3D12_TEXTURE_LAYOUT tex_layout = ExtractTextureLayout(flags);
 		auto ResourceDescriptor = [&]() {
-			bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Texture1D, ResourceFlagBits::Texture3D);
-			if (is_conflicting) {
-				throw std::invalid_argument("CreateTexture(): Texture1D Texture2D or Texture3D are set simultaneously");
-			}
+			TextureDimensionFlags::Validate(flags, "CreateTexture(): Texture1D Texture2D or Texture3D are set simultaneously");
 			if (flags.Test(ResourceFlagBits::Texture1D)) {
 				return CD3DX12_RESOURCE_DESC::Tex1D(
 					format, width, static_cast<UINT16>(depth_arr_layers), 
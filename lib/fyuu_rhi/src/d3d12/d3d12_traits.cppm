@@ -107,7 +107,7 @@ namespace fyuu_rhi::d3d12 {
 			Microsoft::WRL::ComPtr<ID3D12RootSignature> root_signature;
 			Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
 			D3D_PRIMITIVE_TOPOLOGY primitive_topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
-			std::vector<PipelineBindingMetadata> bindings;
+			PipelineBindingLayout bindings;
 		};
 
 		using PipelineResourceGroup = NativePipelineResourceGroup<Backend>;
@@ -21,6 +21,7 @@ export module fyuu_rhi:d3d12_utility;
 #if defined(__cpp_lib_modules)
 import std;
 #endif // defined(__cpp_lib_modules)
+import plastic.object_pool;
 
 namespace {
 	thread_local std::vector<wil::unique_event> s_events;
@@ -58,7 +59,7 @@ namespace fyuu_rhi::d3d12 {
 			buffer.data(), buffer.size(),
 			std::pmr::null_memory_resource()
 		);
-		static std::pmr::synchronized_pool_resource pool(&s_buffer_resource);
+		static plastic::concurrency::PoolResource pool({ .upstream = &s_buffer_resource });
 
 		std::pmr::polymorphic_allocator<ManagedEvent> alloc(&pool);
 
@@ -31,6 +31,7 @@ export import :scheduler;
 export import :pipeline_types;
 export import :pipeline;
 import :logical_device;
+export import :handle_table;
 import :physical_device;
 import :instance;
 
@@ -54,6 +55,7 @@ namespace fyuu_rhi {
 	export using D3D12Resource = Resource<d3d12::Backend>;
 	export using D3D12View = View<d3d12::Backend>;
 	export using D3D12Sampler = Sampler<d3d12::Backend>;
+	export using D3D12HandleTable = HandleTable<d3d12::Backend>;
 #endif // defined(_WIN32)
 #if defined(__APPLE__)
 	export using MetalInstance = Instance<metal::Backend>;
@@ -68,6 +70,7 @@ namespace fyuu_rhi {
 	export using VulkanResource = Resource<vulkan::Backend>;
 	export using VulkanView = View<vulkan::Backend>;
 	export using VulkanSampler = Sampler<vulkan::Backend>;
+	export using VulkanHandleTable = HandleTable<vulkan::Backend>;
 
 	export using OpenGLInstance = Instance<opengl::Backend>;
 	export using OpenGLPhysicalDevice = PhysicalDevice<opengl::Backend>;
@@ -75,6 +78,7 @@ namespace fyuu_rhi {
 	export using OpenGLResource = Resource<opengl::Backend>;
 	export using OpenGLView = View<opengl::Backend>;
 	export using OpenGLSampler = Sampler<opengl::Backend>;
+	export using OpenGLHandleTable = HandleTable<opengl::Backend>;
 #endif // defined(__APPLE__)
 	export using WebGPUInstance = Instance<webgpu::Backend>;
 	export using WebGPUPhysicalDevice = PhysicalDevice<webgpu::Backend>;
@@ -82,6 +86,7 @@ namespace fyuu_rhi {
 	export using WebGPUResource = Resource<webgpu::Backend>;
 	export using WebGPUView = View<webgpu::Backend>;
 	export using WebGPUSampler = Sampler<webgpu::Backend>;
+	export using WebGPUHandleTable = HandleTable<webgpu::Backend>;
 
 	export template <class T> T BestPerformance(std::span<T const> phys_devs) {
 
@@ -0,0 +1,183 @@
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#endif // !defined(__cpp_lib_modules)
+
+export module fyuu_rhi:handle_table;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import :resource_types;
+import :resource;
+import :view;
+import :sampler_types;
+import :sampler;
+import :pipeline_types;
+import :pipeline;
+import :logical_device;
+import plastic.slot_map;
+
+namespace fyuu_rhi {
+
+	export struct ResourceHandleTag;
+	export struct ViewHandleTag;
+	export struct SamplerHandleTag;
+	export struct PipelineHandleTag;
+
+	// 32-bit index + generation handles; trivially copyable and backend independent.
+	export using ResourceHandle = plastic::concurrency::SlotHandle<ResourceHandleTag>;
+	export using ViewHandle = plastic::concurrency::SlotHandle<ViewHandleTag>;
+	export using SamplerHandle = plastic::concurrency::SlotHandle<SamplerHandleTag>;
+	export using PipelineHandle = plastic::concurrency::SlotHandle<PipelineHandleTag>;
+
+	/// Creation parameters of a resource; `width` is the size in bytes for buffers.
+	export struct ResourceDescription {
+		ResourceFlags flags;
+		std::size_t width = 0;
+		std::size_t height = 1;
+		std::size_t depth_arr_layers = 1;
+		std::size_t mip_lvl_cnt = 1;
+	};
+
+	export struct ViewDescription {
+		ResourceHandle resource;
+		ResourceFlags flags;
+	};
+
+	/**
+	 * @brief Optional handle mode: owns RHI objects and addresses them by generational handles.
+	 *
+	 * The backend objects are the hot data of each slot map and the creation
+	 * parameters the cold data. Objects live until Destroy() is called on
+	 * their handle (or the table is destroyed), so views must be destroyed
+	 * before the resources they view. Get() validates handles in debug builds
+	 * only; Contains() and Destroy() always do.
+	 */
+	export template <class Backend> class HandleTable {
+	private:
+		plastic::concurrency::SlotMap<ResourceHandleTag, Resource<Backend>, ResourceDescription> m_resources;
+		plastic::concurrency::SlotMap<ViewHandleTag, View<Backend>, ViewDescription> m_views;
+		plastic::concurrency::SlotMap<SamplerHandleTag, Sampler<Backend>, SamplerDescriptor> m_samplers;
+		plastic::concurrency::SlotMap<PipelineHandleTag, pipeline::Pipeline<Backend>> m_pipelines;
+
+	public:
+		explicit HandleTable(std::size_t capacity_per_kind = 64 * 1024)
+			: m_resources(capacity_per_kind),
+			m_views(capacity_per_kind),
+			m_samplers(capacity_per_kind),
+			m_pipelines(capacity_per_kind) {
+
+		}
+
+		HandleTable(HandleTable const&) = delete;
+		HandleTable& operator=(HandleTable const&) = delete;
+
+		ResourceHandle CreateBuffer(LogicalDevice<Backend>& device, std::size_t size_in_bytes, ResourceFlags const& flags) {
+			return m_resources.Insert(
+				device.CreateBuffer(size_in_bytes, flags),
+				ResourceDescription{ .flags = flags, .width = size_in_bytes }
+			);
+		}
+
+		ResourceHandle CreateTexture(LogicalDevice<Backend>& device, std::size_t width, std::size_t height, std::size_t depth_arr_layers, std::size_t mip_lvl_cnt, ResourceFlags const& flags) {
+			return m_resources.Insert(
+				device.CreateTexture(width, height, depth_arr_layers, mip_lvl_cnt, flags),
+				ResourceDescription{
+					.flags = flags,
+					.width = width,
+					.height = height,
+					.depth_arr_layers = depth_arr_layers,
+					.mip_lvl_cnt = mip_lvl_cnt
+				}
+			);
+		}
+
+		ViewHandle CreateBufferView(LogicalDevice<Backend>& device, ResourceHandle buf, std::size_t offset, std::size_t range, ResourceFlags const& flags) {
+			return m_views.Insert(
+				device.CreateBufferView(Get(buf), offset, range, flags),
+				ViewDescription{ .resource = buf, .flags = flags }
+			);
+		}
+
+		ViewHandle CreateTextureView(LogicalDevice<Backend>& device, ResourceHandle tex, std::size_t base_mip_lvl, std::size_t mip_lvl_cnt, std::size_t base_arr_layer, std::size_t arr_layer_cnt, ResourceFlags const& flags) {
+			return m_views.Insert(
+				device.CreateTextureView(Get(tex), base_mip_lvl, mip_lvl_cnt, base_arr_layer, arr_layer_cnt, flags),
+				ViewDescription{ .resource = tex, .flags = flags }
+			);
+		}
+
+		SamplerHandle CreateSampler(LogicalDevice<Backend>& device, SamplerDescriptor const& descriptor) {
+			return m_samplers.Insert(device.CreateSampler(descriptor), descriptor);
+		}
+
+		PipelineHandle CreateGraphicsPipeline(LogicalDevice<Backend>& device, pipeline::GraphicsPipelineDescriptor const& descriptor) {
+			return m_pipelines.Insert(device.CreateGraphicsPipeline(descriptor));
+		}
+
+		Resource<Backend> const& Get(ResourceHandle handle) const noexcept {
+			return m_resources.HotOf(handle);
+		}
+
+		View<Backend> const& Get(ViewHandle handle) const noexcept {
+			return m_views.HotOf(handle);
+		}
+
+		Sampler<Backend> const& Get(SamplerHandle handle) const noexcept {
+			return m_samplers.HotOf(handle);
+		}
+
+		pipeline::Pipeline<Backend> const& Get(PipelineHandle handle) const noexcept {
+			return m_pipelines.HotOf(handle);
+		}
+
+		ResourceDescription const& Describe(ResourceHandle handle) const noexcept {
+			return m_resources.ColdOf(handle);
+		}
+
+		ViewDescription const& Describe(ViewHandle handle) const noexcept {
+			return m_views.ColdOf(handle);
+		}
+
+		SamplerDescriptor const& Describe(SamplerHandle handle) const noexcept {
+			return m_samplers.ColdOf(handle);
+		}
+
+		bool Contains(ResourceHandle handle) const noexcept {
+			return m_resources.Contains(handle);
+		}
+
+		bool Contains(ViewHandle handle) const noexcept {
+			return m_views.Contains(handle);
+		}
+
+		bool Contains(SamplerHandle handle) const noexcept {
+			return m_samplers.Contains(handle);
+		}
+
+		bool Contains(PipelineHandle handle) const noexcept {
+			return m_pipelines.Contains(handle);
+		}
+
+		/// Releases the object; returns false if the handle was already destroyed.
+		bool Destroy(ResourceHandle handle) noexcept {
+			return m_resources.Erase(handle);
+		}
+
+		bool Destroy(ViewHandle handle) noexcept {
+			return m_views.Erase(handle);
+		}
+
+		bool Destroy(SamplerHandle handle) noexcept {
+			return m_samplers.Erase(handle);
+		}
+
+		bool Destroy(PipelineHandle handle) noexcept {
+			return m_pipelines.Erase(handle);
+		}
+	};
+
+}
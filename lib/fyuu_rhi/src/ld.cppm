@@ -4,6 +4,7 @@ module;
 #include <string_view>
 #include <concepts>
 #include <vector>
+#include <memory_resource>
 #include <cstdint>
 #include <span>
 #endif // !defined(__cpp_lib_modules)
@@ -22,6 +23,7 @@ import :scheduler;
 import :pipeline_types;
 import :pipeline;
 import :native_pipeline_binding;
+import plastic.arena;
 
 namespace fyuu_rhi {
 
@@ -115,7 +117,8 @@ namespace fyuu_rhi {
 			std::uint32_t space,
 			std::span<pipeline::PipelineResourceBinding<Backend> const> bindings
 		) {
-			std::vector<pipeline::NativePipelineResourceBinding<Backend>> native_bindings;
+			plastic::concurrency::ArenaScope scratch;
+			std::pmr::vector<pipeline::NativePipelineResourceBinding<Backend>> native_bindings(scratch.resource());
 			native_bindings.reserve(bindings.size());
 			for (auto const& binding : bindings) {
 				auto const& value = binding.value;
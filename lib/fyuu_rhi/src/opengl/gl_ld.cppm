@@ -68,6 +68,7 @@ import :cache_system;
 import :native_pipeline_binding;
 
 import plastic.static_hash_table;
+import plastic.object_pool;
 
 namespace fs = std::filesystem;
 
@@ -77,7 +78,7 @@ namespace {
 	using namespace fyuu_rhi::pipeline;
 	using namespace fyuu_rhi::opengl;
 
-	std::pmr::synchronized_pool_resource s_obj_pool{};
+	plastic::concurrency::PoolResource s_obj_pool{};
 	std::mutex s_pipeline_cache_mutex;
 
 	GLbitfield ExtractBufferFlags(ResourceFlags const& flags) noexcept {
@@ -114,10 +115,7 @@ namespace {
 
 	GLenum ExtractTextureTarget(ResourceFlags const& flags, std::size_t depth_arr_layers, GLsizei sample_cnt) {
 		
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Texture1D, ResourceFlagBits::Texture3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("Texture1D Texture2D or Texture3D are set simultaneously");
-		}
+		TextureDimensionFlags::Validate(flags, "Texture1D Texture2D or Texture3D are set simultaneously");
 
 		bool is_1d = false;
 		bool is_2d = false;
@@ -163,137 +161,132 @@ namespace {
 
 	}
 
+	constexpr auto kSampleCountTable = SampleCountFlags::MakeTable([](ResourceFlagBits bit) -> GLsizei {
+		switch (bit) {
+		case ResourceFlagBits::Sample1: return 1;
+		case ResourceFlagBits::Sample2: return 2;
+		case ResourceFlagBits::Sample4: return 4;
+		case ResourceFlagBits::Sample8: return 8;
+		case ResourceFlagBits::Sample16: return 16;
+		case ResourceFlagBits::Sample32: return 32;
+		case ResourceFlagBits::Sample64: return 64;
+		default: return 1;
+		}
+	});
+
 	GLsizei ExtractSampleCount(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Sample1, ResourceFlagBits::Sample64);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one sample count can be set");
-		}
-		if (flags.Test(ResourceFlagBits::Sample1)) return 1;
-		else if (flags.Test(ResourceFlagBits::Sample2)) return 2;
-		else if (flags.Test(ResourceFlagBits::Sample4)) return 4;
-		else if (flags.Test(ResourceFlagBits::Sample8)) return 8;
-		else if (flags.Test(ResourceFlagBits::Sample16)) return 16;
-		else if (flags.Test(ResourceFlagBits::Sample32)) return 32;
-		else if (flags.Test(ResourceFlagBits::Sample64)) return 64;
-		else return 1;
+		auto member = SampleCountFlags::Select(flags, "Only one sample count can be set");
+		return member ? kSampleCountTable[*member] : 1;
 	}
 
-	GLenum ExtractInternalFormat(ResourceFlags const& flags) {
+	constexpr auto kInternalFormatTable = FormatFlags::MakeTable([](ResourceFlagBits bit) -> GLenum {
+		switch (bit) {
+		case ResourceFlagBits::R8Unorm: return GL_R8;
+		case ResourceFlagBits::R8Snorm: return GL_R8_SNORM;
+		case ResourceFlagBits::R8Uint: return GL_R8UI;
+		case ResourceFlagBits::R8Sint: return GL_R8I;
 
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::R8Unorm, ResourceFlagBits::Bc7UnormSrgb);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one format can be set");
-		}
-
-		if (flags.Test(ResourceFlagBits::R8Unorm)) return GL_R8;
-		else if (flags.Test(ResourceFlagBits::R8Snorm)) return GL_R8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8Uint)) return GL_R8UI;
-		else if (flags.Test(ResourceFlagBits::R8Sint)) return GL_R8I;
-	
 		// 8‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8Unorm)) return GL_RG8;
-		else if (flags.Test(ResourceFlagBits::R8G8Snorm)) return GL_RG8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8Uint)) return GL_RG8UI;
-		else if (flags.Test(ResourceFlagBits::R8G8Sint)) return GL_RG8I;
-	
+		case ResourceFlagBits::R8G8Unorm: return GL_RG8;
+		case ResourceFlagBits::R8G8Snorm: return GL_RG8_SNORM;
+		case ResourceFlagBits::R8G8Uint: return GL_RG8UI;
+		case ResourceFlagBits::R8G8Sint: return GL_RG8I;
+
 		// 8‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Unorm)) return GL_RGBA8;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Snorm)) return GL_RGBA8_SNORM;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Uint)) return GL_RGBA8UI;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Sint)) return GL_RGBA8I;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Srgb)) return GL_SRGB8_ALPHA8;
-		else if (flags.Test(ResourceFlagBits::B8G8R8A8Srgb)) return GL_SRGB8_ALPHA8;
-	
+		case ResourceFlagBits::R8G8B8A8Unorm: return GL_RGBA8;
+		case ResourceFlagBits::R8G8B8A8Snorm: return GL_RGBA8_SNORM;
+		case ResourceFlagBits::R8G8B8A8Uint: return GL_RGBA8UI;
+		case ResourceFlagBits::R8G8B8A8Sint: return GL_RGBA8I;
+		case ResourceFlagBits::R8G8B8A8Srgb: return GL_SRGB8_ALPHA8;
+		case ResourceFlagBits::B8G8R8A8Srgb: return GL_SRGB8_ALPHA8;
+
 		// 16‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R16Unorm)) return GL_R16;
-		else if (flags.Test(ResourceFlagBits::R16Snorm)) return GL_R16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16Uint)) return GL_R16UI;
-		else if (flags.Test(ResourceFlagBits::R16Sint)) return GL_R16I;
-		else if (flags.Test(ResourceFlagBits::R16Float)) return GL_R16F;
-	
+		case ResourceFlagBits::R16Unorm: return GL_R16;
+		case ResourceFlagBits::R16Snorm: return GL_R16_SNORM;
+		case ResourceFlagBits::R16Uint: return GL_R16UI;
+		case ResourceFlagBits::R16Sint: return GL_R16I;
+		case ResourceFlagBits::R16Float: return GL_R16F;
+
 		// 16‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16Unorm)) return GL_RG16;
-		else if (flags.Test(ResourceFlagBits::R16G16Snorm)) return GL_RG16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16Uint)) return GL_RG16UI;
-		else if (flags.Test(ResourceFlagBits::R16G16Sint)) return GL_RG16I;
-		else if (flags.Test(ResourceFlagBits::R16G16Float)) return GL_RG16F;
-	
+		case ResourceFlagBits::R16G16Unorm: return GL_RG16;
+		case ResourceFlagBits::R16G16Snorm: return GL_RG16_SNORM;
+		case ResourceFlagBits::R16G16Uint: return GL_RG16UI;
+		case ResourceFlagBits::R16G16Sint: return GL_RG16I;
+		case ResourceFlagBits::R16G16Float: return GL_RG16F;
+
 		// 16‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Unorm)) return GL_RGBA16;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Snorm)) return GL_RGBA16_SNORM;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Uint)) return GL_RGBA16UI;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Sint)) return GL_RGBA16I;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Float)) return GL_RGBA16F;
-	
+		case ResourceFlagBits::R16G16B16A16Unorm: return GL_RGBA16;
+		case ResourceFlagBits::R16G16B16A16Snorm: return GL_RGBA16_SNORM;
+		case ResourceFlagBits::R16G16B16A16Uint: return GL_RGBA16UI;
+		case ResourceFlagBits::R16G16B16A16Sint: return GL_RGBA16I;
+		case ResourceFlagBits::R16G16B16A16Float: return GL_RGBA16F;
+
 		// 32‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R32Uint)) return GL_R32UI;
-		else if (flags.Test(ResourceFlagBits::R32Sint)) return GL_R32I;
-		else if (flags.Test(ResourceFlagBits::R32Float)) return GL_R32F;
-	
+		case ResourceFlagBits::R32Uint: return GL_R32UI;
+		case ResourceFlagBits::R32Sint: return GL_R32I;
+		case ResourceFlagBits::R32Float: return GL_R32F;
+
 		// 32‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32Uint)) return GL_RG32UI;
-		else if (flags.Test(ResourceFlagBits::R32G32Sint)) return GL_RG32I;
-		else if (flags.Test(ResourceFlagBits::R32G32Float)) return GL_RG32F;
-	
+		case ResourceFlagBits::R32G32Uint: return GL_RG32UI;
+		case ResourceFlagBits::R32G32Sint: return GL_RG32I;
+		case ResourceFlagBits::R32G32Float: return GL_RG32F;
+
 		// 32‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Uint)) return GL_RGBA32UI;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Sint)) return GL_RGBA32I;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Float)) return GL_RGBA32F;
-	
+		case ResourceFlagBits::R32G32B32A32Uint: return GL_RGBA32UI;
+		case ResourceFlagBits::R32G32B32A32Sint: return GL_RGBA32I;
+		case ResourceFlagBits::R32G32B32A32Float: return GL_RGBA32F;
+
 		// Packed formats
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Unorm)) return GL_RGB10_A2;
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Uint)) return GL_RGB10_A2UI;
-		else if (flags.Test(ResourceFlagBits::R11G11B10Float)) return GL_R11F_G11F_B10F;
-		else if (flags.Test(ResourceFlagBits::R9G9B9E5SharedExp)) return GL_RGB9_E5;
-	
+		case ResourceFlagBits::R10G10B10A2Unorm: return GL_RGB10_A2;
+		case ResourceFlagBits::R10G10B10A2Uint: return GL_RGB10_A2UI;
+		case ResourceFlagBits::R11G11B10Float: return GL_R11F_G11F_B10F;
+		case ResourceFlagBits::R9G9B9E5SharedExp: return GL_RGB9_E5;
+
 		// Depth/stencil
-		else if (flags.Test(ResourceFlagBits::D16Unorm)) return GL_DEPTH_COMPONENT16;
-		else if (flags.Test(ResourceFlagBits::D24UnormS8Uint)) return GL_DEPTH24_STENCIL8;
-		else if (flags.Test(ResourceFlagBits::D32Float)) return GL_DEPTH_COMPONENT32F;
-		else if (flags.Test(ResourceFlagBits::D32FloatS8X24Uint)) return GL_DEPTH32F_STENCIL8;
-	
+		case ResourceFlagBits::D16Unorm: return GL_DEPTH_COMPONENT16;
+		case ResourceFlagBits::D24UnormS8Uint: return GL_DEPTH24_STENCIL8;
+		case ResourceFlagBits::D32Float: return GL_DEPTH_COMPONENT32F;
+		case ResourceFlagBits::D32FloatS8X24Uint: return GL_DEPTH32F_STENCIL8;
+
 		// BC compressed formats (using standard EXT/ARB constants)
-		else if (flags.Test(ResourceFlagBits::Bc1Unorm)) return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc1UnormSrgb)) return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc2Unorm)) return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc2UnormSrgb)) return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc3Unorm)) return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc3UnormSrgb)) return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-		else if (flags.Test(ResourceFlagBits::Bc4Unorm)) return GL_COMPRESSED_RED_RGTC1;
-		else if (flags.Test(ResourceFlagBits::Bc4Snorm)) return GL_COMPRESSED_SIGNED_RED_RGTC1;
-		else if (flags.Test(ResourceFlagBits::Bc5Unorm)) return GL_COMPRESSED_RG_RGTC2;
-		else if (flags.Test(ResourceFlagBits::Bc5Snorm)) return GL_COMPRESSED_SIGNED_RG_RGTC2;
-		else if (flags.Test(ResourceFlagBits::Bc6HUfloat)) return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
-		else if (flags.Test(ResourceFlagBits::Bc6HSfloat)) return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
-		else if (flags.Test(ResourceFlagBits::Bc7Unorm)) return GL_COMPRESSED_RGBA_BPTC_UNORM;
-		else if (flags.Test(ResourceFlagBits::Bc7UnormSrgb)) return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
-	
-		else return GL_RGBA8UI;
+		case ResourceFlagBits::Bc1Unorm: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case ResourceFlagBits::Bc1UnormSrgb: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+		case ResourceFlagBits::Bc2Unorm: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+		case ResourceFlagBits::Bc2UnormSrgb: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+		case ResourceFlagBits::Bc3Unorm: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case ResourceFlagBits::Bc3UnormSrgb: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+		case ResourceFlagBits::Bc4Unorm: return GL_COMPRESSED_RED_RGTC1;
+		case ResourceFlagBits::Bc4Snorm: return GL_COMPRESSED_SIGNED_RED_RGTC1;
+		case ResourceFlagBits::Bc5Unorm: return GL_COMPRESSED_RG_RGTC2;
+		case ResourceFlagBits::Bc5Snorm: return GL_COMPRESSED_SIGNED_RG_RGTC2;
+		case ResourceFlagBits::Bc6HUfloat: return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+		case ResourceFlagBits::Bc6HSfloat: return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+		case ResourceFlagBits::Bc7Unorm: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		case ResourceFlagBits::Bc7UnormSrgb: return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+		default: return GL_RGBA8UI;
+		}
+	});
 
+	GLenum ExtractInternalFormat(ResourceFlags const& flags) {
+		auto member = FormatFlags::Select(flags, "Only one format can be set");
+		return member ? kInternalFormatTable[*member] : GL_RGBA8UI;
 	}
 
-	GLenum ExtractTextureViewTarget(ResourceFlags const& flags) {
-
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one texture view type can be set");
+	constexpr auto kTextureViewTargetTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> GLenum {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return GL_TEXTURE_1D;
+		case ResourceFlagBits::TextureView2D: return GL_TEXTURE_2D;
+		case ResourceFlagBits::TextureView2DArray: return GL_TEXTURE_2D_ARRAY;
+		case ResourceFlagBits::TextureViewCube: return GL_TEXTURE_CUBE_MAP;
+		case ResourceFlagBits::TextureViewCubeArray: return GL_TEXTURE_CUBE_MAP_ARRAY;
+		case ResourceFlagBits::TextureView3D: return GL_TEXTURE_3D;
+		default: return GL_TEXTURE_2D;
 		}
+	});
 
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return GL_TEXTURE_1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return GL_TEXTURE_2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return GL_TEXTURE_2D_ARRAY;
-		else if (flags.Test(ResourceFlagBits::TextureViewCube))
-			return GL_TEXTURE_CUBE_MAP;
-		else if (flags.Test(ResourceFlagBits::TextureViewCubeArray))
-			return GL_TEXTURE_CUBE_MAP_ARRAY;
-		else if (flags.Test(ResourceFlagBits::TextureView3D))
-			return GL_TEXTURE_3D;
-		else
-			return GL_TEXTURE_2D;
-
+	GLenum ExtractTextureViewTarget(ResourceFlags const& flags) {
+		auto member = TextureViewTypeFlags::Select(flags, "Only one texture view type can be set");
+		return member ? kTextureViewTargetTable[*member] : GL_TEXTURE_2D;
 	}
 
 	GLenum MapAddressMode(AddressMode mode) noexcept {
@@ -190,7 +190,7 @@ namespace fyuu_rhi::opengl {
 			MultisampleState multisample;
 			std::optional<DepthStencilState> depth_stencil;
 			std::vector<ColorTargetState> color_targets;
-			std::vector<PipelineBindingMetadata> bindings;
+			PipelineBindingLayout bindings;
 
 			~GLPipeline() noexcept {
 				if (impl) {
@@ -9,7 +9,6 @@ module;
 #include <span>
 #include <stdexcept>
 #include <variant>
-#include <vector>
 #endif // !defined(__cpp_lib_modules)
 
 module fyuu_rhi:native_pipeline_binding;
@@ -19,6 +18,7 @@ import std;
 import :pipeline_types;
 import :resource_types;
 import :slang_pipeline_interface;
+import plastic.small_vector;
 
 namespace fyuu_rhi::pipeline {
 
@@ -68,10 +68,13 @@ namespace fyuu_rhi::pipeline {
 		std::uint32_t count = 1;
 	};
 
-	std::vector<PipelineBindingMetadata> MakePipelineBindingMetadata(
+	// Pipelines and resource groups rarely have more than a handful of bindings.
+	using PipelineBindingLayout = plastic::ds::SmallVector<PipelineBindingMetadata, 8>;
+
+	PipelineBindingLayout MakePipelineBindingMetadata(
 		SlangPipelineInterface const& pipeline_interface
 	) {
-		std::vector<PipelineBindingMetadata> result;
+		PipelineBindingLayout result;
 		result.reserve(pipeline_interface.bindings.size());
 		for (auto const& binding : pipeline_interface.bindings) {
 			result.push_back(
@@ -94,8 +97,8 @@ namespace fyuu_rhi::pipeline {
 			NativePipelineBindingValue<Backend> value;
 		};
 
-		std::vector<Binding> bindings;
-		std::vector<PipelineBindingMetadata> layout;
+		plastic::ds::SmallVector<Binding, 8> bindings;
+		PipelineBindingLayout layout;
 	};
 
 	template <class Backend>
@@ -1,14 +1,19 @@
 module;
 #include <version>
 #if !defined(__cpp_lib_modules)
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 #endif // !defined(__cpp_lib_modules)
 
 export module fyuu_rhi:resource_types;
 #if defined(__cpp_lib_modules)
 import std;
 #endif // defined(__cpp_lib_modules)
-import plastic.atomic_flags;
+import plastic.flags;
 namespace fyuu_rhi {
 
 	export enum class ResourceFlagBits : std::uint32_t {
@@ -159,6 +164,61 @@ namespace fyuu_rhi {
 		Count
 	};
 
-	export using ResourceFlags = plastic::concurrency::AtomicFlags<ResourceFlagBits>;
+	export using ResourceFlags = plastic::ds::Flags<ResourceFlagBits>;
+
+	/**
+	 * @brief A run of mutually exclusive ResourceFlagBits, such as the formats
+	 * or the sample counts.
+	 *
+	 * Backends translate a member to its native value by building a table
+	 * with MakeTable() at compile time and indexing it with Select(), which
+	 * finds the member with a single mask, popcount and countr_zero.
+	 */
+	export template <ResourceFlagBits First, ResourceFlagBits Last>
+	struct ExclusiveFlagRange {
+		static_assert(First <= Last, "Invalid flag range");
+
+		static constexpr std::size_t kSize = static_cast<std::size_t>(Last) - static_cast<std::size_t>(First) + 1;
+		static constexpr ResourceFlags kMask = ResourceFlags::FromRange(First, Last);
+
+		/// Offset of the member set in `flags`, or std::nullopt if none is.
+		/// Throws std::invalid_argument(error) if more than one member is set.
+		static constexpr std::optional<std::size_t> Select(ResourceFlags const& flags, char const* error) {
+			ResourceFlags members = flags & kMask;
+			switch (members.Count()) {
+			case 0:
+				return std::nullopt;
+			case 1:
+				return static_cast<std::size_t>(*members.First()) - static_cast<std::size_t>(First);
+			default:
+				throw std::invalid_argument(error);
+			}
+		}
+
+		/// Throws std::invalid_argument(error) if more than one member is set in `flags`.
+		static constexpr void Validate(ResourceFlags const& flags, char const* error) {
+			if ((flags & kMask).Count() > 1) {
+				throw std::invalid_argument(error);
+			}
+		}
+
+		/// Table of map(member) for every member, indexed like Select().
+		template <class Map>
+		static consteval auto MakeTable(Map map) {
+			std::array<std::invoke_result_t<Map&, ResourceFlagBits>, kSize> table{};
+			for (std::size_t i = 0; i < kSize; ++i) {
+				table[i] = map(static_cast<ResourceFlagBits>(static_cast<std::size_t>(First) + i));
+			}
+			return table;
+		}
+	};
+
+	export using AllocationTypeFlags = ExclusiveFlagRange<ResourceFlagBits::UndedicatedAllocation, ResourceFlagBits::DedicatedAllocation>;
+	export using AllocationStrategyFlags = ExclusiveFlagRange<ResourceFlagBits::MinOffsetAllocation, ResourceFlagBits::FirstFitAllocation>;
+	export using MemoryLocationFlags = ExclusiveFlagRange<ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback>;
+	export using TextureDimensionFlags = ExclusiveFlagRange<ResourceFlagBits::Texture1D, ResourceFlagBits::Texture3D>;
+	export using TextureViewTypeFlags = ExclusiveFlagRange<ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D>;
+	export using SampleCountFlags = ExclusiveFlagRange<ResourceFlagBits::Sample1, ResourceFlagBits::Sample64>;
+	export using FormatFlags = ExclusiveFlagRange<ResourceFlagBits::R8Unorm, ResourceFlagBits::Bc7UnormSrgb>;
 
 }
@@ -8,7 +8,7 @@ export module fyuu_rhi:scheduler_types;
 #if defined(__cpp_lib_modules)
 import std;
 #endif // defined(__cpp_lib_modules)
-import plastic.atomic_flags;
+import plastic.flags;
 
 namespace fyuu_rhi::execution {
 
@@ -20,7 +20,7 @@ namespace fyuu_rhi::execution {
 		Count
 	};
 
-	export using SchedulerFlags = plastic::concurrency::AtomicFlags<SchedulerFlagBits>;
+	export using SchedulerFlags = plastic::ds::Flags<SchedulerFlagBits>;
 
 	export struct SchedulerDescriptor {
 		SchedulerFlags flags;
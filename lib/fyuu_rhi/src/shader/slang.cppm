@@ -11,7 +11,6 @@ module;
 #include <iterator>
 #include <limits>
 #include <mutex>
-#include <shared_mutex>
 #include <span>
 #include <stdexcept>
 #include <string>
@@ -37,6 +36,7 @@ import :pipeline_types;
 import :slang_pipeline_interface;
 import :log;
 import :cache_system;
+import plastic.read_mostly_map;
 
 namespace fs = std::filesystem;
 
@@ -186,15 +186,11 @@ namespace fyuu_rhi::shader {
 			slang::TargetDesc const& target,
 			SlangPipelineProgramDescriptor const& desc
 		) {
-			static std::unordered_map<std::uint64_t, Slang::ComPtr<slang::ISession>> session_cache;
-			static std::shared_mutex mutex;
+			static plastic::concurrency::ReadMostlyMap<std::uint64_t, Slang::ComPtr<slang::ISession>> session_cache;
 			auto key = SessionHash(target, desc);
 
-			{
-				std::shared_lock lock(mutex);
-				if (auto it = session_cache.find(key); it != session_cache.end()) {
-					return it->second;
-				}
+			if (auto session = session_cache.find(key)) {
+				return *std::move(session);
 			}
 
 			std::vector<std::string> path_storage;
@@ -248,9 +244,7 @@ namespace fyuu_rhi::shader {
 			auto result = GlobalSession()->createSession(session_desc, created.writeRef());
 			Check(result, nullptr, "Creating Slang session");
 
-			std::unique_lock lock(mutex);
-			auto [it, inserted] = session_cache.try_emplace(key, created);
-			return it->second;
+			return session_cache.try_emplace(key, std::move(created)).first;
 		}
 
 		static bool ReadBinary(fs::path const& path, std::vector<std::byte>& output) {
@@ -54,8 +54,8 @@ import :slang;
 import :cache_system;
 import :native_pipeline_binding;
 import plastic.lru;
-import plastic.static_list;
-import plastic.static_hash_table;
+import plastic.object_pool;
+import plastic.arena;
 
 namespace fs = std::filesystem;
 
@@ -65,7 +65,7 @@ namespace {
 	using namespace fyuu_rhi::pipeline;
 	using namespace fyuu_rhi::vulkan;
 
-	std::pmr::synchronized_pool_resource s_pool{};
+	plastic::concurrency::PoolResource s_pool{};
 
 	struct GetTextureHandle {
 		vk::Image operator()(std::shared_ptr<Backend::Resource::Texture> const& resource) const {
@@ -87,22 +87,37 @@ namespace {
 		}
 	};
 
-	VmaAllocationCreateFlags ExtractAllocationFlags(ResourceFlags const& flags) {
-		
-		VmaAllocationCreateFlags vma_flags{};
-		
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::UndedicatedAllocation, ResourceFlagBits::DedicatedAllocation);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractAllocationFlags(): UndedicatedAllocation and DedicatedAllocation are set simultaneously");
+	constexpr auto kAllocationTypeTable = AllocationTypeFlags::MakeTable([](ResourceFlagBits bit) -> VmaAllocationCreateFlags {
+		switch (bit) {
+		case ResourceFlagBits::UndedicatedAllocation: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_NEVER_ALLOCATE_BIT;
+		case ResourceFlagBits::DedicatedAllocation: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+		default: return 0;
 		}
-		if (flags.Test(ResourceFlagBits::UndedicatedAllocation)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_NEVER_ALLOCATE_BIT;
+	});
+
+	constexpr auto kAllocationStrategyTable = AllocationStrategyFlags::MakeTable([](ResourceFlagBits bit) -> VmaAllocationCreateFlags {
+		switch (bit) {
+		case ResourceFlagBits::MinOffsetAllocation: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_MIN_OFFSET_BIT;
+		case ResourceFlagBits::BestFitAllocation: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_BEST_FIT_BIT;
+		case ResourceFlagBits::FirstFitAllocation: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_FIRST_FIT_BIT;
+		default: return 0;
 		}
-		else if (flags.Test(ResourceFlagBits::DedicatedAllocation)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+	});
+
+	constexpr auto kHostAccessTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> VmaAllocationCreateFlags {
+		switch (bit) {
+		case ResourceFlagBits::HostVisible: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+		case ResourceFlagBits::DeviceReadback: return VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+		default: return 0;
 		}
-		else {
+	});
 
+	VmaAllocationCreateFlags ExtractAllocationFlags(ResourceFlags const& flags) {
+		
+		VmaAllocationCreateFlags vma_flags{};
+		
+		if (auto type = AllocationTypeFlags::Select(flags, "ExtractAllocationFlags(): UndedicatedAllocation and DedicatedAllocation are set simultaneously")) {
+			vma_flags |= kAllocationTypeTable[*type];
 		}
 
 		if (flags.Test(ResourceFlagBits::AllocationWithinBudget)) {
@@ -115,58 +130,30 @@ namespace {
 			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
 		}
 
-		is_conflicting = flags.TestSingleInRange(ResourceFlagBits::MinOffsetAllocation, ResourceFlagBits::FirstFitAllocation);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractAllocationFlags(): MinOffsetAllocation BestFitAllocation or FirstFitAllocation are set simultaneously");
-		}
-		else if (flags.Test(ResourceFlagBits::MinOffsetAllocation)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_MIN_OFFSET_BIT;
-		}
-		else if (flags.Test(ResourceFlagBits::BestFitAllocation)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_BEST_FIT_BIT;
-		}
-		else if (flags.Test(ResourceFlagBits::FirstFitAllocation)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_STRATEGY_FIRST_FIT_BIT;
+		if (auto strategy = AllocationStrategyFlags::Select(flags, "ExtractAllocationFlags(): MinOffsetAllocation BestFitAllocation or FirstFitAllocation are set simultaneously")) {
+			vma_flags |= kAllocationStrategyTable[*strategy];
 		}
-		else {
-
-		}
-
-		is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractAllocationFlags(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::HostVisible)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			vma_flags |= VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
-		}
-		else {
 
+		if (auto location = MemoryLocationFlags::Select(flags, "ExtractAllocationFlags(): DeviceLocal HostVisible or DeviceReadback are set simultaneously")) {
+			vma_flags |= kHostAccessTable[*location];
 		}
 
 		return vma_flags;
 
 	}
 
-	VmaMemoryUsage ExtractMemoryUsage(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractMemoryUsage(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::DeviceLocal)) {
-			return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-		}
-		else if (flags.Test(ResourceFlagBits::HostVisible)) {
-			return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO;
-		}
-		else {
-			return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+	constexpr auto kMemoryUsageTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> VmaMemoryUsage {
+		switch (bit) {
+		case ResourceFlagBits::DeviceLocal: return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+		case ResourceFlagBits::HostVisible: return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO;
+		case ResourceFlagBits::DeviceReadback: return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO;
+		default: return VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 		}
+	});
+
+	VmaMemoryUsage ExtractMemoryUsage(ResourceFlags const& flags) {
+		auto member = MemoryLocationFlags::Select(flags, "ExtractMemoryUsage(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
+		return member ? kMemoryUsageTable[*member] : VmaMemoryUsage::VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 	}
 
 	vk::BufferUsageFlags ExtractBufferUsage(ResourceFlags const& flags) noexcept {
@@ -201,161 +188,135 @@ namespace {
 		return vk_flags;
 	}
 
-	vk::ImageType ExtractTextureDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Texture1D, ResourceFlagBits::Texture3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractTextureDimension(): Texture1D Texture2D or Texture3D are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::Texture1D)) {
-			return vk::ImageType::e1D;
-		}
-		else if (flags.Test(ResourceFlagBits::Texture2D)) {
-			return vk::ImageType::e2D;
-		}
-		else if (flags.Test(ResourceFlagBits::Texture3D)) {
-			return vk::ImageType::e3D;
+	constexpr auto kTextureDimensionTable = TextureDimensionFlags::MakeTable([](ResourceFlagBits bit) -> vk::ImageType {
+		switch (bit) {
+		case ResourceFlagBits::Texture1D: return vk::ImageType::e1D;
+		case ResourceFlagBits::Texture2D: return vk::ImageType::e2D;
+		case ResourceFlagBits::Texture3D: return vk::ImageType::e3D;
+		default: return vk::ImageType::e2D;
 		}
-		else {
-			return vk::ImageType::e2D;
-		}
-	}
+	});
 
-	vk::Format ExtractFormat(ResourceFlags const& flags) {
+	vk::ImageType ExtractTextureDimension(ResourceFlags const& flags) {
+		auto member = TextureDimensionFlags::Select(flags, "ExtractTextureDimension(): Texture1D Texture2D or Texture3D are set simultaneously");
+		return member ? kTextureDimensionTable[*member] : vk::ImageType::e2D;
+	}
 
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::R8Unorm, ResourceFlagBits::Bc7UnormSrgb);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractFormat(): Only one format can be set");
-		}
-
-		if (flags.Test(ResourceFlagBits::R8Unorm)) return vk::Format::eR8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8Snorm)) return vk::Format::eR8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8Uint)) return vk::Format::eR8Uint;
-		else if (flags.Test(ResourceFlagBits::R8Sint)) return vk::Format::eR8Sint;
-
-		else if (flags.Test(ResourceFlagBits::R8G8Unorm)) return vk::Format::eR8G8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8G8Snorm)) return vk::Format::eR8G8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8G8Uint)) return vk::Format::eR8G8Uint;
-		else if (flags.Test(ResourceFlagBits::R8G8Sint)) return vk::Format::eR8G8Sint;
-
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Unorm)) return vk::Format::eR8G8B8A8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Snorm)) return vk::Format::eR8G8B8A8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Uint)) return vk::Format::eR8G8B8A8Uint;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Sint)) return vk::Format::eR8G8B8A8Sint;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Srgb)) return vk::Format::eR8G8B8A8Srgb;
-		else if (flags.Test(ResourceFlagBits::B8G8R8A8Srgb)) return vk::Format::eB8G8R8A8Srgb;
-
-		else if (flags.Test(ResourceFlagBits::R16Unorm)) return vk::Format::eR16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16Snorm)) return vk::Format::eR16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16Uint)) return vk::Format::eR16Uint;
-		else if (flags.Test(ResourceFlagBits::R16Sint)) return vk::Format::eR16Sint;
-		else if (flags.Test(ResourceFlagBits::R16Float)) return vk::Format::eR16Sfloat;
-
-		else if (flags.Test(ResourceFlagBits::R16G16Unorm)) return vk::Format::eR16G16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16G16Snorm)) return vk::Format::eR16G16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16G16Uint)) return vk::Format::eR16G16Uint;
-		else if (flags.Test(ResourceFlagBits::R16G16Sint)) return vk::Format::eR16G16Sint;
-		else if (flags.Test(ResourceFlagBits::R16G16Float)) return vk::Format::eR16G16Sfloat;
-
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Unorm)) return vk::Format::eR16G16B16A16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Snorm)) return vk::Format::eR16G16B16A16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Uint)) return vk::Format::eR16G16B16A16Uint;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Sint)) return vk::Format::eR16G16B16A16Sint;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Float)) return vk::Format::eR16G16B16A16Sfloat;
-
-		else if (flags.Test(ResourceFlagBits::R32Uint)) return vk::Format::eR32Uint;
-		else if (flags.Test(ResourceFlagBits::R32Sint)) return vk::Format::eR32Sint;
-		else if (flags.Test(ResourceFlagBits::R32Float)) return vk::Format::eR32Sfloat;
-
-		else if (flags.Test(ResourceFlagBits::R32G32Uint)) return vk::Format::eR32G32Uint;
-		else if (flags.Test(ResourceFlagBits::R32G32Sint)) return vk::Format::eR32G32Sint;
-		else if (flags.Test(ResourceFlagBits::R32G32Float)) return vk::Format::eR32G32Sfloat;
-
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Uint)) return vk::Format::eR32G32B32A32Uint;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Sint)) return vk::Format::eR32G32B32A32Sint;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Float)) return vk::Format::eR32G32B32A32Sfloat;
+	constexpr auto kFormatTable = FormatFlags::MakeTable([](ResourceFlagBits bit) -> vk::Format {
+		switch (bit) {
+		case ResourceFlagBits::R8Unorm: return vk::Format::eR8Unorm;
+		case ResourceFlagBits::R8Snorm: return vk::Format::eR8Snorm;
+		case ResourceFlagBits::R8Uint: return vk::Format::eR8Uint;
+		case ResourceFlagBits::R8Sint: return vk::Format::eR8Sint;
+
+		case ResourceFlagBits::R8G8Unorm: return vk::Format::eR8G8Unorm;
+		case ResourceFlagBits::R8G8Snorm: return vk::Format::eR8G8Snorm;
+		case ResourceFlagBits::R8G8Uint: return vk::Format::eR8G8Uint;
+		case ResourceFlagBits::R8G8Sint: return vk::Format::eR8G8Sint;
+
+		case ResourceFlagBits::R8G8B8A8Unorm: return vk::Format::eR8G8B8A8Unorm;
+		case ResourceFlagBits::R8G8B8A8Snorm: return vk::Format::eR8G8B8A8Snorm;
+		case ResourceFlagBits::R8G8B8A8Uint: return vk::Format::eR8G8B8A8Uint;
+		case ResourceFlagBits::R8G8B8A8Sint: return vk::Format::eR8G8B8A8Sint;
+		case ResourceFlagBits::R8G8B8A8Srgb: return vk::Format::eR8G8B8A8Srgb;
+		case ResourceFlagBits::B8G8R8A8Srgb: return vk::Format::eB8G8R8A8Srgb;
+
+		case ResourceFlagBits::R16Unorm: return vk::Format::eR16Unorm;
+		case ResourceFlagBits::R16Snorm: return vk::Format::eR16Snorm;
+		case ResourceFlagBits::R16Uint: return vk::Format::eR16Uint;
+		case ResourceFlagBits::R16Sint: return vk::Format::eR16Sint;
+		case ResourceFlagBits::R16Float: return vk::Format::eR16Sfloat;
+
+		case ResourceFlagBits::R16G16Unorm: return vk::Format::eR16G16Unorm;
+		case ResourceFlagBits::R16G16Snorm: return vk::Format::eR16G16Snorm;
+		case ResourceFlagBits::R16G16Uint: return vk::Format::eR16G16Uint;
+		case ResourceFlagBits::R16G16Sint: return vk::Format::eR16G16Sint;
+		case ResourceFlagBits::R16G16Float: return vk::Format::eR16G16Sfloat;
+
+		case ResourceFlagBits::R16G16B16A16Unorm: return vk::Format::eR16G16B16A16Unorm;
+		case ResourceFlagBits::R16G16B16A16Snorm: return vk::Format::eR16G16B16A16Snorm;
+		case ResourceFlagBits::R16G16B16A16Uint: return vk::Format::eR16G16B16A16Uint;
+		case ResourceFlagBits::R16G16B16A16Sint: return vk::Format::eR16G16B16A16Sint;
+		case ResourceFlagBits::R16G16B16A16Float: return vk::Format::eR16G16B16A16Sfloat;
+
+		case ResourceFlagBits::R32Uint: return vk::Format::eR32Uint;
+		case ResourceFlagBits::R32Sint: return vk::Format::eR32Sint;
+		case ResourceFlagBits::R32Float: return vk::Format::eR32Sfloat;
+
+		case ResourceFlagBits::R32G32Uint: return vk::Format::eR32G32Uint;
+		case ResourceFlagBits::R32G32Sint: return vk::Format::eR32G32Sint;
+		case ResourceFlagBits::R32G32Float: return vk::Format::eR32G32Sfloat;
+
+		case ResourceFlagBits::R32G32B32A32Uint: return vk::Format::eR32G32B32A32Uint;
+		case ResourceFlagBits::R32G32B32A32Sint: return vk::Format::eR32G32B32A32Sint;
+		case ResourceFlagBits::R32G32B32A32Float: return vk::Format::eR32G32B32A32Sfloat;
 
 		// Packed formats
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Unorm)) return vk::Format::eA2R10G10B10UnormPack32;
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Uint)) return vk::Format::eA2R10G10B10UintPack32;
-		else if (flags.Test(ResourceFlagBits::R11G11B10Float)) return vk::Format::eB10G11R11UfloatPack32;
-		else if (flags.Test(ResourceFlagBits::R9G9B9E5SharedExp)) return vk::Format::eE5B9G9R9UfloatPack32;
+		case ResourceFlagBits::R10G10B10A2Unorm: return vk::Format::eA2R10G10B10UnormPack32;
+		case ResourceFlagBits::R10G10B10A2Uint: return vk::Format::eA2R10G10B10UintPack32;
+		case ResourceFlagBits::R11G11B10Float: return vk::Format::eB10G11R11UfloatPack32;
+		case ResourceFlagBits::R9G9B9E5SharedExp: return vk::Format::eE5B9G9R9UfloatPack32;
 
 		// Depth/stencil
-		else if (flags.Test(ResourceFlagBits::D16Unorm)) return vk::Format::eD16Unorm;
-		else if (flags.Test(ResourceFlagBits::D24UnormS8Uint)) return vk::Format::eD24UnormS8Uint;
-		else if (flags.Test(ResourceFlagBits::D32Float)) return vk::Format::eD32Sfloat;
-		else if (flags.Test(ResourceFlagBits::D32FloatS8X24Uint)) return vk::Format::eD32SfloatS8Uint;
+		case ResourceFlagBits::D16Unorm: return vk::Format::eD16Unorm;
+		case ResourceFlagBits::D24UnormS8Uint: return vk::Format::eD24UnormS8Uint;
+		case ResourceFlagBits::D32Float: return vk::Format::eD32Sfloat;
+		case ResourceFlagBits::D32FloatS8X24Uint: return vk::Format::eD32SfloatS8Uint;
 
 		// BC compressed
-		else if (flags.Test(ResourceFlagBits::Bc1Unorm)) return vk::Format::eBc1RgbaUnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc1UnormSrgb)) return vk::Format::eBc1RgbaSrgbBlock;
-		else if (flags.Test(ResourceFlagBits::Bc2Unorm)) return vk::Format::eBc2UnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc2UnormSrgb)) return vk::Format::eBc2SrgbBlock;
-		else if (flags.Test(ResourceFlagBits::Bc3Unorm)) return vk::Format::eBc3UnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc3UnormSrgb)) return vk::Format::eBc3SrgbBlock;
-		else if (flags.Test(ResourceFlagBits::Bc4Unorm)) return vk::Format::eBc4UnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc4Snorm)) return vk::Format::eBc4SnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc5Unorm)) return vk::Format::eBc5UnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc5Snorm)) return vk::Format::eBc5SnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc6HUfloat)) return vk::Format::eBc6HUfloatBlock;
-		else if (flags.Test(ResourceFlagBits::Bc6HSfloat)) return vk::Format::eBc6HSfloatBlock;
-		else if (flags.Test(ResourceFlagBits::Bc7Unorm)) return vk::Format::eBc7UnormBlock;
-		else if (flags.Test(ResourceFlagBits::Bc7UnormSrgb)) return vk::Format::eBc7SrgbBlock;
-
-		else return vk::Format::eUndefined;
+		case ResourceFlagBits::Bc1Unorm: return vk::Format::eBc1RgbaUnormBlock;
+		case ResourceFlagBits::Bc1UnormSrgb: return vk::Format::eBc1RgbaSrgbBlock;
+		case ResourceFlagBits::Bc2Unorm: return vk::Format::eBc2UnormBlock;
+		case ResourceFlagBits::Bc2UnormSrgb: return vk::Format::eBc2SrgbBlock;
+		case ResourceFlagBits::Bc3Unorm: return vk::Format::eBc3UnormBlock;
+		case ResourceFlagBits::Bc3UnormSrgb: return vk::Format::eBc3SrgbBlock;
+		case ResourceFlagBits::Bc4Unorm: return vk::Format::eBc4UnormBlock;
+		case ResourceFlagBits::Bc4Snorm: return vk::Format::eBc4SnormBlock;
+		case ResourceFlagBits::Bc5Unorm: return vk::Format::eBc5UnormBlock;
+		case ResourceFlagBits::Bc5Snorm: return vk::Format::eBc5SnormBlock;
+		case ResourceFlagBits::Bc6HUfloat: return vk::Format::eBc6HUfloatBlock;
+		case ResourceFlagBits::Bc6HSfloat: return vk::Format::eBc6HSfloatBlock;
+		case ResourceFlagBits::Bc7Unorm: return vk::Format::eBc7UnormBlock;
+		case ResourceFlagBits::Bc7UnormSrgb: return vk::Format::eBc7SrgbBlock;
+		default: return vk::Format::eUndefined;
+		}
+	});
 
+	vk::Format ExtractFormat(ResourceFlags const& flags) {
+		auto member = FormatFlags::Select(flags, "ExtractFormat(): Only one format can be set");
+		return member ? kFormatTable[*member] : vk::Format::eUndefined;
 	}
 
-	vk::SampleCountFlagBits ExtractSampleCount(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Sample1, ResourceFlagBits::Sample64);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractSampleCount(): Only sample count can be set");
-		}
-		if (flags.Test(ResourceFlagBits::Sample1)) {
-			return vk::SampleCountFlagBits::e1;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample2)) {
-			return vk::SampleCountFlagBits::e2;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample4)) {
-			return vk::SampleCountFlagBits::e4;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample8)) {
-			return vk::SampleCountFlagBits::e8;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample16)) {
-			return vk::SampleCountFlagBits::e16;
-		}
-		else if (flags.Test(ResourceFlagBits::Sample32)) {
-			return vk::SampleCountFlagBits::e32;
+	constexpr auto kSampleCountTable = SampleCountFlags::MakeTable([](ResourceFlagBits bit) -> vk::SampleCountFlagBits {
+		switch (bit) {
+		case ResourceFlagBits::Sample1: return vk::SampleCountFlagBits::e1;
+		case ResourceFlagBits::Sample2: return vk::SampleCountFlagBits::e2;
+		case ResourceFlagBits::Sample4: return vk::SampleCountFlagBits::e4;
+		case ResourceFlagBits::Sample8: return vk::SampleCountFlagBits::e8;
+		case ResourceFlagBits::Sample16: return vk::SampleCountFlagBits::e16;
+		case ResourceFlagBits::Sample32: return vk::SampleCountFlagBits::e32;
+		case ResourceFlagBits::Sample64: return vk::SampleCountFlagBits::e64;
+		default: return vk::SampleCountFlagBits::e1;
 		}
-		else if (flags.Test(ResourceFlagBits::Sample64)) {
-			return vk::SampleCountFlagBits::e64;
-		}
-		else {
-			return vk::SampleCountFlagBits::e1;
-		}
-		
+	});
+
+	vk::SampleCountFlagBits ExtractSampleCount(ResourceFlags const& flags) {
+		auto member = SampleCountFlags::Select(flags, "ExtractSampleCount(): Only sample count can be set");
+		return member ? kSampleCountTable[*member] : vk::SampleCountFlagBits::e1;
 	}
 
-	vk::ImageTiling ExtractTiling(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractTiling(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::DeviceLocal)) {
-			return vk::ImageTiling::eOptimal;
-		}
-		else if (flags.Test(ResourceFlagBits::HostVisible)) {
-			return vk::ImageTiling::eLinear;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			return vk::ImageTiling::eLinear;
+	constexpr auto kTilingTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> vk::ImageTiling {
+		switch (bit) {
+		case ResourceFlagBits::DeviceLocal: return vk::ImageTiling::eOptimal;
+		case ResourceFlagBits::HostVisible: return vk::ImageTiling::eLinear;
+		case ResourceFlagBits::DeviceReadback: return vk::ImageTiling::eLinear;
+		default: return vk::ImageTiling::eOptimal;
 		}
-		else {
-			return vk::ImageTiling::eOptimal;
-		}
-		
+	});
+
+	vk::ImageTiling ExtractTiling(ResourceFlags const& flags) {
+		auto member = MemoryLocationFlags::Select(flags, "ExtractTiling(): DeviceLocal HostVisible or DeviceReadback are set simultaneously");
+		return member ? kTilingTable[*member] : vk::ImageTiling::eOptimal;
 	}
 
 	vk::ImageUsageFlags ExtractTextureUsage(ResourceFlags const& flags) {
@@ -398,32 +359,55 @@ namespace {
 		return usage;
 	}
 
-	vk::ImageViewType ExtractTextureViewType(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("ExtractTextureViewType(): Only one texture view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D)) {
-			return vk::ImageViewType::e1D;
-		}
-		else if (flags.Test(ResourceFlagBits::TextureView2D)) {
-			return vk::ImageViewType::e2D;
-		}
-		else if (flags.Test(ResourceFlagBits::TextureView3D)) {
-			return vk::ImageViewType::e3D;
-		}
-		else if (flags.Test(ResourceFlagBits::TextureViewCube)) {
-			return vk::ImageViewType::eCube;
+	constexpr auto kTextureViewTypeTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> vk::ImageViewType {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return vk::ImageViewType::e1D;
+		case ResourceFlagBits::TextureView2D: return vk::ImageViewType::e2D;
+		case ResourceFlagBits::TextureView3D: return vk::ImageViewType::e3D;
+		case ResourceFlagBits::TextureViewCube: return vk::ImageViewType::eCube;
+		case ResourceFlagBits::TextureView2DArray: return vk::ImageViewType::e2DArray;
+		case ResourceFlagBits::TextureViewCubeArray: return vk::ImageViewType::eCubeArray;
+		default: return vk::ImageViewType::e2D;
 		}
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray)) {
-			return vk::ImageViewType::e2DArray;
-		}
-		else if (flags.Test(ResourceFlagBits::TextureViewCubeArray)) {
-			return vk::ImageViewType::eCubeArray;
+	});
+
+	vk::ImageViewType ExtractTextureViewType(ResourceFlags const& flags) {
+		auto member = TextureViewTypeFlags::Select(flags, "ExtractTextureViewType(): Only one texture view type can be set");
+		return member ? kTextureViewTypeTable[*member] : vk::ImageViewType::e2D;
+	}
+
+	std::uint32_t QueryMultiPlaneCount(Backend::LogicalDevice const& ld, vk::Format format) {
+
+		vk::FormatProperties2 fmt_props = ld.phys_dev.impl->getFormatProperties2(format, *ld.dispatcher);
+		bool disjoint_supported = (fmt_props.formatProperties.optimalTilingFeatures &
+			vk::FormatFeatureFlagBits::eDisjoint) != vk::FormatFeatureFlags{};
+		if (!disjoint_supported) {
+			return 0u;
 		}
-		else {
-			return vk::ImageViewType::e2D;
+
+		std::uint32_t plane_count = 0;
+		std::array planes = {
+			vk::ImageAspectFlagBits::ePlane0,
+			vk::ImageAspectFlagBits::ePlane1,
+			vk::ImageAspectFlagBits::ePlane2
+		};
+		vk::Result res;
+		for (auto plane : planes) {
+			vk::ImagePlaneMemoryRequirementsInfo plane_info(plane);
+			vk::ImageFormatProperties2 img_props({}, &plane_info);
+			vk::PhysicalDeviceImageFormatInfo2 fmt_info(
+				format,
+				vk::ImageType::e2D,
+				vk::ImageTiling::eOptimal,
+				vk::ImageUsageFlagBits::eSampled,
+				vk::ImageCreateFlagBits::eDisjoint,
+				nullptr
+			);
+			res = ld.phys_dev.impl->getImageFormatProperties2(&fmt_info, &img_props, *ld.dispatcher);
+			plane_count += res == vk::Result::eSuccess;
 		}
+		return plane_count;
+
 	}
 
 	std::uint32_t GetMultiPlaneCount(Backend::LogicalDevice const& ld, vk::Format format) {
@@ -440,74 +424,22 @@ namespace {
 			}
 		};
 
-		using List = plastic::ds::StaticList<std::pair<CacheKey const, std::uint32_t>, 64u>;
-
-		static plastic::ds::LRUCache<
-			plastic::ds::StaticHashTable<CacheKey, typename List::iterator, 64u, CacheKeyHash>,
-			List,
-			64u
-		> cache;
-
-		static std::mutex mutex;
-
-		CacheKey key{ *ld.impl, format };
-
-		if (std::unique_lock<std::mutex> lock(mutex); cache.Contains(key)) {
-			return cache.Get(key);
-		}
+		static plastic::ds::ShardedLRUCache<CacheKey, std::uint32_t, 64u, 8u, CacheKeyHash> cache;
 
 		try {
-			vk::FormatProperties2 fmt_props = ld.phys_dev.impl->getFormatProperties2(format, *ld.dispatcher);
-			bool disjoint_supported = (fmt_props.formatProperties.optimalTilingFeatures &
-				vk::FormatFeatureFlagBits::eDisjoint) != vk::FormatFeatureFlags{};
-			if (!disjoint_supported) {
-				{
-					std::unique_lock<std::mutex> lock(mutex);
-					cache.Put(key, 0u);
-				}
-				return 0u;
-			}
+			// A failed query throws out of the factory, so it is retried next time instead of cached.
+			return cache.GetOrCompute(
+				CacheKey{ *ld.impl, format },
+				[&ld, format]() { return QueryMultiPlaneCount(ld, format); }
+			);
 		}
 		catch (std::exception const& ex) {
 			LOG_WARNING(
-				std::format("GetMultiPlaneCount(): Calling getFormatProperties2() but failed, Vulkan reports {}", ex.what())
+				std::format("GetMultiPlaneCount(): Querying format properties failed, Vulkan reports {}", ex.what())
 			);
 			return 0u;
 		}
 
-		try {
-			std::uint32_t plane_count = 0;
-			std::array planes = {
-				vk::ImageAspectFlagBits::ePlane0,
-				vk::ImageAspectFlagBits::ePlane1,
-				vk::ImageAspectFlagBits::ePlane2
-			};
-			vk::Result res;
-			for (auto plane : planes) {
-				vk::ImagePlaneMemoryRequirementsInfo plane_info(plane);
-				vk::ImageFormatProperties2 img_props({}, &plane_info);
-				vk::PhysicalDeviceImageFormatInfo2 fmt_info(
-					format,
-					vk::ImageType::e2D,
-					vk::ImageTiling::eOptimal,
-					vk::ImageUsageFlagBits::eSampled,
-					vk::ImageCreateFlagBits::eDisjoint,
-					nullptr
-				);
-				res = ld.phys_dev.impl->getImageFormatProperties2(&fmt_info, &img_props, *ld.dispatcher);
-				plane_count += res == vk::Result::eSuccess;
-			}
-			{
-				std::unique_lock<std::mutex> lock(mutex);
-				cache.Put(key, plane_count);
-			}
-			return plane_count;
-		}
-		catch (std::exception const& ex) {
-			LOG_WARNING(std::format("GetMultiPlaneCount(): Calling getImageFormatProperties2() but failed, Vulkan reports {}", ex.what()));
-			return 0u;
-		}
-
 	}
 
 	vk::ImageAspectFlags ExtractTextureAspect(std::size_t base_mip_lvl, std::size_t mip_lvl_cnt, std::size_t base_arr_layer, std::size_t arr_layer_cnt, ResourceFlags const& flags, Backend::LogicalDevice const& ld) {
@@ -737,33 +669,21 @@ namespace {
 				return std::hash<void*>{}(reinterpret_cast<void*>(key));
 			}
 		};
-		using List = plastic::ds::StaticList<std::pair<Key const, bool>, 64u>;
-		static plastic::ds::LRUCache<
-			plastic::ds::StaticHashTable<Key, typename List::iterator, 64u, KeyHash>,
-			List,
-			64u
-		> cache;
-		static std::mutex mutex;
-
-		Key key = static_cast<VkDevice>(*ld.impl);
-		if (std::unique_lock<std::mutex> lock(mutex); cache.Contains(key)) {
-			return cache.Get(key);
-		}
-
-		auto properties = ld.phys_dev.impl->getProperties(*ld.dispatcher);
-		bool extension = std::ranges::contains(
-			ld.enabled_extensions,
-			std::string_view(vk::KHRDynamicRenderingExtensionName)
+		static plastic::ds::ShardedLRUCache<Key, bool, 64u, 8u, KeyHash> cache;
+
+		return cache.GetOrCompute(
+			static_cast<VkDevice>(*ld.impl),
+			[&ld]() {
+				bool extension = std::ranges::contains(
+					ld.enabled_extensions,
+					std::string_view(vk::KHRDynamicRenderingExtensionName)
+				);
+				vk::PhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features;
+				vk::PhysicalDeviceFeatures2 features({}, &dynamic_rendering_features);
+				ld.phys_dev.impl->getFeatures2(&features, *ld.dispatcher);
+				return extension && static_cast<bool>(dynamic_rendering_features.dynamicRendering);
+			}
 		);
-		vk::PhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features;
-		vk::PhysicalDeviceFeatures2 features({}, &dynamic_rendering_features);
-		ld.phys_dev.impl->getFeatures2(&features, *ld.dispatcher);
-		bool enabled = extension && dynamic_rendering_features.dynamicRendering;
-		{
-			std::unique_lock<std::mutex> lock(mutex);
-			cache.Put(key, enabled);
-		}
-		return enabled;
 	}
 
 
@@ -864,8 +784,7 @@ namespace fyuu_rhi::vulkan {
 			throw std::runtime_error(std::format("Calling vmaCreateImage() failed, VMA reported: {}", vk::to_string(result)));
 		}
 
-		static std::pmr::synchronized_pool_resource pool(&s_pool);
-		std::pmr::polymorphic_allocator<Backend::Resource::Texture> pmr_alloc(&pool);
+		std::pmr::polymorphic_allocator<Backend::Resource::Texture> pmr_alloc(&s_pool);
 
 		return { std::allocate_shared<Backend::Resource::Texture>(pmr_alloc, ld.mem_alloc, tex_info, tex, alloc, alloc_info, vk::ImageLayout::eUndefined, vk::ImageLayout::eUndefined) };
 
@@ -963,12 +882,15 @@ namespace fyuu_rhi::vulkan {
 			spirv_profile
 		);
 		shader::SlangProgram program(target, descriptor.program, cache_tag);
+		// Create-info scratch lives in the thread's arena and is dropped on return.
+		plastic::concurrency::ArenaScope scratch;
 		auto binding_metadata = MakePipelineBindingMetadata(program.Interface());
 
 		std::uint32_t max_space = 0;
 		for (auto const& binding : program.Interface().bindings) max_space = std::max(max_space, binding.space);
-		std::vector<std::vector<vk::DescriptorSetLayoutBinding>> set_bindings(
-			program.Interface().bindings.empty() ? 0 : max_space + 1
+		std::pmr::vector<std::pmr::vector<vk::DescriptorSetLayoutBinding>> set_bindings(
+			program.Interface().bindings.empty() ? 0 : max_space + 1,
+			scratch.resource()
 		);
 		for (auto const& binding : program.Interface().bindings) {
 			set_bindings[binding.space].emplace_back(
@@ -981,7 +903,7 @@ namespace fyuu_rhi::vulkan {
 
 		Backend::Pipeline pipeline;
 		pipeline.bindings = std::move(binding_metadata);
-		std::vector<vk::DescriptorSetLayout> raw_set_layouts;
+		std::pmr::vector<vk::DescriptorSetLayout> raw_set_layouts(scratch.resource());
 		for (auto& bindings : set_bindings) {
 			std::ranges::sort(bindings, {}, &vk::DescriptorSetLayoutBinding::binding);
 			vk::DescriptorSetLayoutCreateInfo info({}, bindings);
@@ -991,7 +913,7 @@ namespace fyuu_rhi::vulkan {
 			);
 			raw_set_layouts.push_back(raw);
 		}
-		std::vector<vk::PushConstantRange> push_constants;
+		std::pmr::vector<vk::PushConstantRange> push_constants(scratch.resource());
 		for (auto const& range : program.Interface().push_constants) {
 			push_constants.emplace_back(MapPipelineStageFlags(range.visibility), range.offset, range.size);
 		}
@@ -999,8 +921,8 @@ namespace fyuu_rhi::vulkan {
 		auto raw_layout = ld.impl->createPipelineLayout(layout_info, nullptr, *ld.dispatcher);
 		pipeline.layout = vk::SharedPipelineLayout(raw_layout, ld.impl, { nullptr, *ld.dispatcher });
 
-		std::vector<vk::SharedShaderModule> modules;
-		std::vector<vk::PipelineShaderStageCreateInfo> stages;
+		std::pmr::vector<vk::SharedShaderModule> modules(scratch.resource());
+		std::pmr::vector<vk::PipelineShaderStageCreateInfo> stages(scratch.resource());
 		for (auto const& entry : program.EntryPoints()) {
 			if (entry.code.size() % sizeof(std::uint32_t) != 0) {
 				throw std::runtime_error("Slang returned misaligned SPIR-V bytecode");
@@ -1015,7 +937,7 @@ namespace fyuu_rhi::vulkan {
 			stages.emplace_back(vk::PipelineShaderStageCreateFlags{}, MapPipelineStage(entry.stage), raw, entry.name.c_str());
 		}
 
-		std::vector<vk::VertexInputBindingDescription> vertex_bindings;
+		std::pmr::vector<vk::VertexInputBindingDescription> vertex_bindings(scratch.resource());
 		for (auto const& binding : descriptor.vertex.buffers) {
 			vertex_bindings.emplace_back(
 				binding.slot,
@@ -1023,7 +945,7 @@ namespace fyuu_rhi::vulkan {
 				binding.input_rate == VertexInputRate::Vertex ? vk::VertexInputRate::eVertex : vk::VertexInputRate::eInstance
 			);
 		}
-		std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
+		std::pmr::vector<vk::VertexInputAttributeDescription> vertex_attributes(scratch.resource());
 		for (auto const& attribute : descriptor.vertex.attributes) {
 			vertex_attributes.emplace_back(
 				attribute.location,
@@ -1067,8 +989,8 @@ namespace fyuu_rhi::vulkan {
 				false, state.stencil_enabled, MapPipelineStencilFace(state.stencil_front), MapPipelineStencilFace(state.stencil_back)
 			);
 		}
-		std::vector<vk::PipelineColorBlendAttachmentState> blend_attachments;
-		std::vector<vk::Format> color_formats;
+		std::pmr::vector<vk::PipelineColorBlendAttachmentState> blend_attachments(scratch.resource());
+		std::pmr::vector<vk::Format> color_formats(scratch.resource());
 		for (auto const& target_state : descriptor.color_targets) {
 			color_formats.push_back(ExtractFormat(ResourceFlags(target_state.format)));
 			vk::PipelineColorBlendAttachmentState attachment;
@@ -1097,8 +1019,8 @@ namespace fyuu_rhi::vulkan {
 		auto dynamic_rendering_enabled = IsDynamicRenderingEnabled(ld);
 		if (!dynamic_rendering_enabled) {
 			auto samples = ExtractSampleCount(ResourceFlags(descriptor.multisample.sample_count));
-			std::vector<vk::AttachmentDescription> attachments;
-			std::vector<vk::AttachmentReference> color_references;
+			std::pmr::vector<vk::AttachmentDescription> attachments(scratch.resource());
+			std::pmr::vector<vk::AttachmentReference> color_references(scratch.resource());
 			attachments.reserve(color_formats.size() + (depth_format != vk::Format::eUndefined ? 1u : 0u));
 			color_references.reserve(color_formats.size());
 			for (auto format : color_formats) {
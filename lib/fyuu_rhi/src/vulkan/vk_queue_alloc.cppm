@@ -4,11 +4,10 @@ module;
 #include <stdexcept>
 #include <memory>
 #include <random>
+#include <algorithm>
 #include <array>
 #include <vector>
-#include <unordered_set>
 #include <unordered_map>
-#include <mutex>
 #include <optional>
 #include <span>
 #endif
@@ -17,6 +16,7 @@ export module fyuu_rhi:vulkan_queue_allocator;
 #if defined(__cpp_lib_modules)
 import std;
 #endif
+import plastic.index_allocator;
 
 namespace fyuu_rhi::vulkan {
 
@@ -49,14 +49,12 @@ namespace {
 		CommandQueueInfo info;
 		std::vector<float> priorities;
 
-		std::unordered_set<std::uint32_t> allocated_queue; // Indices that are currently in use
-		std::mutex allocated_queue_mutex;
+		plastic::concurrency::IndexAllocator allocated_queue; // Indices that are currently in use
 
 		QueueSet(CommandQueueInfo const& info_, std::span<float const> priorities_)
 			: info(info_),
 			priorities(priorities_.begin(), priorities_.end()),
-			allocated_queue(),
-			allocated_queue_mutex() {
+			allocated_queue(std::max<std::size_t>(priorities.size(), 1u)) {
 
 		}
 	};
@@ -97,8 +95,7 @@ namespace fyuu_rhi::vulkan {
 
 		~ManagedQueue() {
 			if (m_queue_set) {
-				std::lock_guard<std::mutex> lock(m_queue_set->allocated_queue_mutex);
-				m_queue_set->allocated_queue.erase(m_index);
+				m_queue_set->allocated_queue.Free(m_index);
 			}
 		}
 
@@ -269,11 +266,8 @@ namespace fyuu_rhi::vulkan {
 		if (candidates.empty())
 			throw std::runtime_error("No queue satisfies the priorities");
 
-		std::lock_guard<std::mutex> lock(queue_set->allocated_queue_mutex);
 		for (std::uint32_t index : candidates) {
-			auto& allocated_queue = queue_set->allocated_queue;
-			if (allocated_queue.find(index) == allocated_queue.end()) {
-				allocated_queue.insert(index);
+			if (queue_set->allocated_queue.TryAllocate(index)) {
 				// Return a shared_ptr to a handle that keeps the queue_set alive
 				return std::make_shared<ManagedQueue>(queue_set, index);
 			}
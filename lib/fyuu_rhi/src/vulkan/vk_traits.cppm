@@ -63,6 +63,7 @@ import :sampler_types;
 import :scheduler_types;
 import :pipeline_types;
 import :native_pipeline_binding;
+import plastic.small_vector;
 
 namespace fyuu_rhi::vulkan {
 
@@ -156,8 +157,8 @@ namespace fyuu_rhi::vulkan {
 		using Sampler = vk::SharedSampler;
 
 		struct Pipeline {
-			std::vector<vk::SharedDescriptorSetLayout> descriptor_set_layouts;
-			std::vector<PipelineBindingMetadata> bindings;
+			plastic::ds::SmallVector<vk::SharedDescriptorSetLayout, 4> descriptor_set_layouts;
+			PipelineBindingLayout bindings;
 			vk::SharedPipelineLayout layout;
 			vk::SharedRenderPass compatible_render_pass;
 			vk::SharedPipeline state;
@@ -25,6 +25,14 @@ namespace {
 	using namespace fyuu_rhi;
 	using namespace fyuu_rhi::pipeline;
 
+	constexpr auto kMapUsageTable = MemoryLocationFlags::MakeTable([](ResourceFlagBits bit) -> wgpu::BufferUsage {
+		switch (bit) {
+		case ResourceFlagBits::HostVisible: return wgpu::BufferUsage::MapWrite;
+		case ResourceFlagBits::DeviceReadback: return wgpu::BufferUsage::MapRead;
+		default: return wgpu::BufferUsage::None;
+		}
+	});
+
 	wgpu::BufferUsage ExtractBufferUsageFlags(ResourceFlags const& flags) {
 
 		wgpu::BufferUsage wgpu_flags{};
@@ -57,19 +65,8 @@ namespace {
 			wgpu_flags |= wgpu::BufferUsage::Indirect;
 		}
 
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::DeviceLocal, ResourceFlagBits::DeviceReadback);
-		if (is_conflicting) {
-			throw std::invalid_argument("DeviceLocal HostVisible or DeviceReadback are set simultaneously");
-		}
-	
-		if (flags.Test(ResourceFlagBits::HostVisible)) {
-			wgpu_flags |= wgpu::BufferUsage::MapWrite;
-		}
-		else if (flags.Test(ResourceFlagBits::DeviceReadback)) {
-			wgpu_flags |= wgpu::BufferUsage::MapRead;
-		}
-		else {
-
+		if (auto location = MemoryLocationFlags::Select(flags, "DeviceLocal HostVisible or DeviceReadback are set simultaneously")) {
+			wgpu_flags |= kMapUsageTable[*location];
 		}
 	
 		return wgpu_flags;
@@ -106,154 +103,147 @@ namespace {
 
 	}
 
-	wgpu::TextureDimension ExtractTextureDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Texture1D, ResourceFlagBits::Texture3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("Texture1D Texture2D or Texture3D are set simultaneously");
-		}
-		if (flags.Test(ResourceFlagBits::Texture1D)) {
-			return wgpu::TextureDimension::e1D;
-		}
-		else if (flags.Test(ResourceFlagBits::Texture2D)) {
-			return wgpu::TextureDimension::e2D;
-		}
-		else if (flags.Test(ResourceFlagBits::Texture3D)) {
-			return wgpu::TextureDimension::e3D;
-		}
-		else {
-			return wgpu::TextureDimension::e2D;
+	constexpr auto kTextureDimensionTable = TextureDimensionFlags::MakeTable([](ResourceFlagBits bit) -> wgpu::TextureDimension {
+		switch (bit) {
+		case ResourceFlagBits::Texture1D: return wgpu::TextureDimension::e1D;
+		case ResourceFlagBits::Texture2D: return wgpu::TextureDimension::e2D;
+		case ResourceFlagBits::Texture3D: return wgpu::TextureDimension::e3D;
+		default: return wgpu::TextureDimension::e2D;
 		}
-	}
+	});
 
-	wgpu::TextureFormat ExtractFormat(ResourceFlags const& flags) {
+	wgpu::TextureDimension ExtractTextureDimension(ResourceFlags const& flags) {
+		auto member = TextureDimensionFlags::Select(flags, "Texture1D Texture2D or Texture3D are set simultaneously");
+		return member ? kTextureDimensionTable[*member] : wgpu::TextureDimension::e2D;
+	}
 
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::R8Unorm, ResourceFlagBits::Bc7UnormSrgb);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one format can be set");
-		}
-	
+	constexpr auto kFormatTable = FormatFlags::MakeTable([](ResourceFlagBits bit) -> wgpu::TextureFormat {
+		switch (bit) {
 		// 8‑bit per component (1‑channel)
-		if (flags.Test(ResourceFlagBits::R8Unorm)) return wgpu::TextureFormat::R8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8Snorm)) return wgpu::TextureFormat::R8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8Uint)) return wgpu::TextureFormat::R8Uint;
-		else if (flags.Test(ResourceFlagBits::R8Sint)) return wgpu::TextureFormat::R8Sint;
-	
+		case ResourceFlagBits::R8Unorm: return wgpu::TextureFormat::R8Unorm;
+		case ResourceFlagBits::R8Snorm: return wgpu::TextureFormat::R8Snorm;
+		case ResourceFlagBits::R8Uint: return wgpu::TextureFormat::R8Uint;
+		case ResourceFlagBits::R8Sint: return wgpu::TextureFormat::R8Sint;
+
 		// 8‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8Unorm)) return wgpu::TextureFormat::RG8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8G8Snorm)) return wgpu::TextureFormat::RG8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8G8Uint)) return wgpu::TextureFormat::RG8Uint;
-		else if (flags.Test(ResourceFlagBits::R8G8Sint)) return wgpu::TextureFormat::RG8Sint;
-	
+		case ResourceFlagBits::R8G8Unorm: return wgpu::TextureFormat::RG8Unorm;
+		case ResourceFlagBits::R8G8Snorm: return wgpu::TextureFormat::RG8Snorm;
+		case ResourceFlagBits::R8G8Uint: return wgpu::TextureFormat::RG8Uint;
+		case ResourceFlagBits::R8G8Sint: return wgpu::TextureFormat::RG8Sint;
+
 		// 8‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Unorm)) return wgpu::TextureFormat::RGBA8Unorm;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Snorm)) return wgpu::TextureFormat::RGBA8Snorm;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Uint)) return wgpu::TextureFormat::RGBA8Uint;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Sint)) return wgpu::TextureFormat::RGBA8Sint;
-		else if (flags.Test(ResourceFlagBits::R8G8B8A8Srgb)) return wgpu::TextureFormat::RGBA8UnormSrgb;
-		else if (flags.Test(ResourceFlagBits::B8G8R8A8Srgb)) return wgpu::TextureFormat::BGRA8UnormSrgb;
-	
+		case ResourceFlagBits::R8G8B8A8Unorm: return wgpu::TextureFormat::RGBA8Unorm;
+		case ResourceFlagBits::R8G8B8A8Snorm: return wgpu::TextureFormat::RGBA8Snorm;
+		case ResourceFlagBits::R8G8B8A8Uint: return wgpu::TextureFormat::RGBA8Uint;
+		case ResourceFlagBits::R8G8B8A8Sint: return wgpu::TextureFormat::RGBA8Sint;
+		case ResourceFlagBits::R8G8B8A8Srgb: return wgpu::TextureFormat::RGBA8UnormSrgb;
+		case ResourceFlagBits::B8G8R8A8Srgb: return wgpu::TextureFormat::BGRA8UnormSrgb;
+
 		// 16‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R16Unorm)) return wgpu::TextureFormat::R16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16Snorm)) return wgpu::TextureFormat::R16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16Uint)) return wgpu::TextureFormat::R16Uint;
-		else if (flags.Test(ResourceFlagBits::R16Sint)) return wgpu::TextureFormat::R16Sint;
-		else if (flags.Test(ResourceFlagBits::R16Float)) return wgpu::TextureFormat::R16Float;
-	
+		case ResourceFlagBits::R16Unorm: return wgpu::TextureFormat::R16Unorm;
+		case ResourceFlagBits::R16Snorm: return wgpu::TextureFormat::R16Snorm;
+		case ResourceFlagBits::R16Uint: return wgpu::TextureFormat::R16Uint;
+		case ResourceFlagBits::R16Sint: return wgpu::TextureFormat::R16Sint;
+		case ResourceFlagBits::R16Float: return wgpu::TextureFormat::R16Float;
+
 		// 16‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16Unorm)) return wgpu::TextureFormat::RG16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16G16Snorm)) return wgpu::TextureFormat::RG16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16G16Uint)) return wgpu::TextureFormat::RG16Uint;
-		else if (flags.Test(ResourceFlagBits::R16G16Sint)) return wgpu::TextureFormat::RG16Sint;
-		else if (flags.Test(ResourceFlagBits::R16G16Float)) return wgpu::TextureFormat::RG16Float;
-	
+		case ResourceFlagBits::R16G16Unorm: return wgpu::TextureFormat::RG16Unorm;
+		case ResourceFlagBits::R16G16Snorm: return wgpu::TextureFormat::RG16Snorm;
+		case ResourceFlagBits::R16G16Uint: return wgpu::TextureFormat::RG16Uint;
+		case ResourceFlagBits::R16G16Sint: return wgpu::TextureFormat::RG16Sint;
+		case ResourceFlagBits::R16G16Float: return wgpu::TextureFormat::RG16Float;
+
 		// 16‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Unorm)) return wgpu::TextureFormat::RGBA16Unorm;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Snorm)) return wgpu::TextureFormat::RGBA16Snorm;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Uint)) return wgpu::TextureFormat::RGBA16Uint;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Sint)) return wgpu::TextureFormat::RGBA16Sint;
-		else if (flags.Test(ResourceFlagBits::R16G16B16A16Float)) return wgpu::TextureFormat::RGBA16Float;
-	
+		case ResourceFlagBits::R16G16B16A16Unorm: return wgpu::TextureFormat::RGBA16Unorm;
+		case ResourceFlagBits::R16G16B16A16Snorm: return wgpu::TextureFormat::RGBA16Snorm;
+		case ResourceFlagBits::R16G16B16A16Uint: return wgpu::TextureFormat::RGBA16Uint;
+		case ResourceFlagBits::R16G16B16A16Sint: return wgpu::TextureFormat::RGBA16Sint;
+		case ResourceFlagBits::R16G16B16A16Float: return wgpu::TextureFormat::RGBA16Float;
+
 		// 32‑bit per component (1‑channel)
-		else if (flags.Test(ResourceFlagBits::R32Uint)) return wgpu::TextureFormat::R32Uint;
-		else if (flags.Test(ResourceFlagBits::R32Sint)) return wgpu::TextureFormat::R32Sint;
-		else if (flags.Test(ResourceFlagBits::R32Float)) return wgpu::TextureFormat::R32Float;
-	
+		case ResourceFlagBits::R32Uint: return wgpu::TextureFormat::R32Uint;
+		case ResourceFlagBits::R32Sint: return wgpu::TextureFormat::R32Sint;
+		case ResourceFlagBits::R32Float: return wgpu::TextureFormat::R32Float;
+
 		// 32‑bit per component (2‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32Uint)) return wgpu::TextureFormat::RG32Uint;
-		else if (flags.Test(ResourceFlagBits::R32G32Sint)) return wgpu::TextureFormat::RG32Sint;
-		else if (flags.Test(ResourceFlagBits::R32G32Float)) return wgpu::TextureFormat::RG32Float;
-	
+		case ResourceFlagBits::R32G32Uint: return wgpu::TextureFormat::RG32Uint;
+		case ResourceFlagBits::R32G32Sint: return wgpu::TextureFormat::RG32Sint;
+		case ResourceFlagBits::R32G32Float: return wgpu::TextureFormat::RG32Float;
+
 		// 32‑bit per component (4‑channel)
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Uint)) return wgpu::TextureFormat::RGBA32Uint;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Sint)) return wgpu::TextureFormat::RGBA32Sint;
-		else if (flags.Test(ResourceFlagBits::R32G32B32A32Float)) return wgpu::TextureFormat::RGBA32Float;
-	
+		case ResourceFlagBits::R32G32B32A32Uint: return wgpu::TextureFormat::RGBA32Uint;
+		case ResourceFlagBits::R32G32B32A32Sint: return wgpu::TextureFormat::RGBA32Sint;
+		case ResourceFlagBits::R32G32B32A32Float: return wgpu::TextureFormat::RGBA32Float;
+
 		// Packed formats
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Unorm)) return wgpu::TextureFormat::RGB10A2Unorm;
-		else if (flags.Test(ResourceFlagBits::R10G10B10A2Uint)) return wgpu::TextureFormat::RGB10A2Uint;
-		else if (flags.Test(ResourceFlagBits::R11G11B10Float)) return wgpu::TextureFormat::RG11B10Ufloat;
-		else if (flags.Test(ResourceFlagBits::R9G9B9E5SharedExp)) return wgpu::TextureFormat::RGB9E5Ufloat;
-	
+		case ResourceFlagBits::R10G10B10A2Unorm: return wgpu::TextureFormat::RGB10A2Unorm;
+		case ResourceFlagBits::R10G10B10A2Uint: return wgpu::TextureFormat::RGB10A2Uint;
+		case ResourceFlagBits::R11G11B10Float: return wgpu::TextureFormat::RG11B10Ufloat;
+		case ResourceFlagBits::R9G9B9E5SharedExp: return wgpu::TextureFormat::RGB9E5Ufloat;
+
 		// Depth/stencil
-		else if (flags.Test(ResourceFlagBits::D16Unorm)) return wgpu::TextureFormat::Depth16Unorm;
-		else if (flags.Test(ResourceFlagBits::D24UnormS8Uint)) return wgpu::TextureFormat::Depth24PlusStencil8;
-		else if (flags.Test(ResourceFlagBits::D32Float)) return wgpu::TextureFormat::Depth32Float;
-		else if (flags.Test(ResourceFlagBits::D32FloatS8X24Uint)) return wgpu::TextureFormat::Depth32FloatStencil8;
-	
+		case ResourceFlagBits::D16Unorm: return wgpu::TextureFormat::Depth16Unorm;
+		case ResourceFlagBits::D24UnormS8Uint: return wgpu::TextureFormat::Depth24PlusStencil8;
+		case ResourceFlagBits::D32Float: return wgpu::TextureFormat::Depth32Float;
+		case ResourceFlagBits::D32FloatS8X24Uint: return wgpu::TextureFormat::Depth32FloatStencil8;
+
 		// BC compressed formats
-		else if (flags.Test(ResourceFlagBits::Bc1Unorm)) return wgpu::TextureFormat::BC1RGBAUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc1UnormSrgb)) return wgpu::TextureFormat::BC1RGBAUnormSrgb;
-		else if (flags.Test(ResourceFlagBits::Bc2Unorm)) return wgpu::TextureFormat::BC2RGBAUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc2UnormSrgb)) return wgpu::TextureFormat::BC2RGBAUnormSrgb;
-		else if (flags.Test(ResourceFlagBits::Bc3Unorm)) return wgpu::TextureFormat::BC3RGBAUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc3UnormSrgb)) return wgpu::TextureFormat::BC3RGBAUnormSrgb;
-		else if (flags.Test(ResourceFlagBits::Bc4Unorm)) return wgpu::TextureFormat::BC4RUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc4Snorm)) return wgpu::TextureFormat::BC4RSnorm;
-		else if (flags.Test(ResourceFlagBits::Bc5Unorm)) return wgpu::TextureFormat::BC5RGUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc5Snorm)) return wgpu::TextureFormat::BC5RGSnorm;
-		else if (flags.Test(ResourceFlagBits::Bc6HUfloat)) return wgpu::TextureFormat::BC6HRGBUfloat;
-		else if (flags.Test(ResourceFlagBits::Bc6HSfloat)) return wgpu::TextureFormat::BC6HRGBFloat;
-		else if (flags.Test(ResourceFlagBits::Bc7Unorm)) return wgpu::TextureFormat::BC7RGBAUnorm;
-		else if (flags.Test(ResourceFlagBits::Bc7UnormSrgb)) return wgpu::TextureFormat::BC7RGBAUnormSrgb;
-		
-		else return wgpu::TextureFormat::Undefined;
+		case ResourceFlagBits::Bc1Unorm: return wgpu::TextureFormat::BC1RGBAUnorm;
+		case ResourceFlagBits::Bc1UnormSrgb: return wgpu::TextureFormat::BC1RGBAUnormSrgb;
+		case ResourceFlagBits::Bc2Unorm: return wgpu::TextureFormat::BC2RGBAUnorm;
+		case ResourceFlagBits::Bc2UnormSrgb: return wgpu::TextureFormat::BC2RGBAUnormSrgb;
+		case ResourceFlagBits::Bc3Unorm: return wgpu::TextureFormat::BC3RGBAUnorm;
+		case ResourceFlagBits::Bc3UnormSrgb: return wgpu::TextureFormat::BC3RGBAUnormSrgb;
+		case ResourceFlagBits::Bc4Unorm: return wgpu::TextureFormat::BC4RUnorm;
+		case ResourceFlagBits::Bc4Snorm: return wgpu::TextureFormat::BC4RSnorm;
+		case ResourceFlagBits::Bc5Unorm: return wgpu::TextureFormat::BC5RGUnorm;
+		case ResourceFlagBits::Bc5Snorm: return wgpu::TextureFormat::BC5RGSnorm;
+		case ResourceFlagBits::Bc6HUfloat: return wgpu::TextureFormat::BC6HRGBUfloat;
+		case ResourceFlagBits::Bc6HSfloat: return wgpu::TextureFormat::BC6HRGBFloat;
+		case ResourceFlagBits::Bc7Unorm: return wgpu::TextureFormat::BC7RGBAUnorm;
+		case ResourceFlagBits::Bc7UnormSrgb: return wgpu::TextureFormat::BC7RGBAUnormSrgb;
+		default: return wgpu::TextureFormat::Undefined;
+		}
+	});
 
+	wgpu::TextureFormat ExtractFormat(ResourceFlags const& flags) {
+		auto member = FormatFlags::Select(flags, "Only one format can be set");
+		return member ? kFormatTable[*member] : wgpu::TextureFormat::Undefined;
 	}
 
+	constexpr auto kSampleCountTable = SampleCountFlags::MakeTable([](ResourceFlagBits bit) -> std::uint32_t {
+		switch (bit) {
+		case ResourceFlagBits::Sample1: return 1u;
+		case ResourceFlagBits::Sample2: return 2u;
+		case ResourceFlagBits::Sample4: return 4u;
+		case ResourceFlagBits::Sample8: return 8u;
+		case ResourceFlagBits::Sample16: return 16u;
+		case ResourceFlagBits::Sample32: return 32u;
+		case ResourceFlagBits::Sample64: return 64u;
+		default: return 1u;
+		}
+	});
+
 	std::uint32_t ExtractSampleCount(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::Sample1, ResourceFlagBits::Sample64);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one sample count can be set");
-		}
-		if (flags.Test(ResourceFlagBits::Sample1)) return 1u;
-		else if (flags.Test(ResourceFlagBits::Sample2)) return 2u;
-		else if (flags.Test(ResourceFlagBits::Sample4)) return 4u;
-		else if (flags.Test(ResourceFlagBits::Sample8)) return 8u;
-		else if (flags.Test(ResourceFlagBits::Sample16)) return 16u;
-		else if (flags.Test(ResourceFlagBits::Sample32)) return 32u;
-		else if (flags.Test(ResourceFlagBits::Sample64)) return 64u;
-		else return 1u;
+		auto member = SampleCountFlags::Select(flags, "Only one sample count can be set");
+		return member ? kSampleCountTable[*member] : 1u;
 	}
 
+	constexpr auto kTextureViewDimensionTable = TextureViewTypeFlags::MakeTable([](ResourceFlagBits bit) -> wgpu::TextureViewDimension {
+		switch (bit) {
+		case ResourceFlagBits::TextureView1D: return wgpu::TextureViewDimension::e1D;
+		case ResourceFlagBits::TextureView2D: return wgpu::TextureViewDimension::e2D;
+		case ResourceFlagBits::TextureView2DArray: return wgpu::TextureViewDimension::e2DArray;
+		case ResourceFlagBits::TextureViewCube: return wgpu::TextureViewDimension::Cube;
+		case ResourceFlagBits::TextureViewCubeArray: return wgpu::TextureViewDimension::CubeArray;
+		case ResourceFlagBits::TextureView3D: return wgpu::TextureViewDimension::e3D;
+		default: return wgpu::TextureViewDimension::e2D;
+		}
+	});
+
 	wgpu::TextureViewDimension ExtractTextureViewDimension(ResourceFlags const& flags) {
-		bool is_conflicting = flags.TestSingleInRange(ResourceFlagBits::TextureView1D, ResourceFlagBits::TextureView3D);
-		if (is_conflicting) {
-			throw std::invalid_argument("Only one tex view type can be set");
-		}
-		if (flags.Test(ResourceFlagBits::TextureView1D))
-			return wgpu::TextureViewDimension::e1D;
-		else if (flags.Test(ResourceFlagBits::TextureView2D))
-			return wgpu::TextureViewDimension::e2D;
-		else if (flags.Test(ResourceFlagBits::TextureView2DArray))
-			return wgpu::TextureViewDimension::e2DArray;
-		else if (flags.Test(ResourceFlagBits::TextureViewCube))
-			return wgpu::TextureViewDimension::Cube;
-		else if (flags.Test(ResourceFlagBits::TextureViewCubeArray))
-			return wgpu::TextureViewDimension::CubeArray;
-		else if (flags.Test(ResourceFlagBits::TextureView3D))
-			return wgpu::TextureViewDimension::e3D;
-		else
-			return wgpu::TextureViewDimension::e2D;
+		auto member = TextureViewTypeFlags::Select(flags, "Only one tex view type can be set");
+		return member ? kTextureViewDimensionTable[*member] : wgpu::TextureViewDimension::e2D;
 	}
 
 	wgpu::TextureAspect ExtractTextureViewAspect(ResourceFlags const& flags) {
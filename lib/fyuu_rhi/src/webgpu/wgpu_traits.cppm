@@ -47,6 +47,7 @@ import :sampler_types;
 import :scheduler_types;
 import :pipeline_types;
 import :native_pipeline_binding;
+import plastic.small_vector;
 
 namespace fyuu_rhi::webgpu {
 	using namespace fyuu_rhi::pipeline;
@@ -81,8 +82,8 @@ namespace fyuu_rhi::webgpu {
 		using Sampler = wgpu::Sampler;
 
 		struct Pipeline {
-			std::vector<wgpu::BindGroupLayout> bind_group_layouts;
-			std::vector<PipelineBindingMetadata> bindings;
+			plastic::ds::SmallVector<wgpu::BindGroupLayout, 4> bind_group_layouts;
+			PipelineBindingLayout bindings;
 			wgpu::RenderPipeline state;
 		};
 
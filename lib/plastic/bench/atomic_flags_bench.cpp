@@ -0,0 +1,77 @@
+// AtomicFlags suite: concurrent set, range query and reset on a 256-bit set.
+//
+// Every thread owns a few enumerators of one shared flag set, the way
+// workers mark state in a shared descriptor. The baseline guards a
+// std::bitset with a mutex.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.atomic_flags;
+
+namespace {
+
+	enum class Bits : std::uint32_t {
+		First = 0,
+		Last = 255,
+		Count = 256
+	};
+
+	constexpr std::uint64_t kOpsPerThread = 1u << 21;
+
+	Bits BitOf(std::size_t thread, std::uint64_t i) noexcept {
+		return static_cast<Bits>((thread * 4 + i % 4) % static_cast<std::size_t>(Bits::Count));
+	}
+
+	class LockedBitset {
+	private:
+		mutable std::mutex m_mutex;
+		std::bitset<256> m_bits;
+
+	public:
+		void Set(Bits bit, bool value) {
+			std::lock_guard lock(m_mutex);
+			m_bits.set(static_cast<std::size_t>(bit), value);
+		}
+
+		bool Any() const {
+			std::lock_guard lock(m_mutex);
+			return m_bits.any();
+		}
+	};
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			{
+				plastic::concurrency::AtomicFlags<Bits> flags;
+				ctx.Run("AtomicFlags", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					Bits bit = BitOf(t, i);
+					flags.Set(bit);
+					(void)flags.TestAnyInRange(Bits::First, Bits::Last);
+					flags.Reset(bit);
+				});
+			}
+			{
+				LockedBitset flags;
+				ctx.Run("std::mutex + std::bitset", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					Bits bit = BitOf(t, i);
+					flags.Set(bit, true);
+					(void)flags.Any();
+					flags.Set(bit, false);
+				});
+			}
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("atomic_flags", &Run);
+
+}
@@ -0,0 +1,10 @@
+// plastic_bench: throughput and latency of the plastic primitives.
+//
+// Every *_bench.cpp in this target registers one suite with the harness.
+// Run with --json <path> to keep results for comparison between commits.
+
+import plastic.bench;
+
+int main(int argc, char** argv) {
+	return plastic::bench::Main(argc, argv);
+}
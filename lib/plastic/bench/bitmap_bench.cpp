@@ -0,0 +1,79 @@
+// Bitmap suite: contended and per-thread bit updates.
+//
+// The shared runs flip one bit per thread in a single word, the worst case
+// for a concurrent bitmap. The per-thread runs give every thread its own
+// Bitmap, with and without cache-line alignment, to show what false sharing
+// between neighbouring bitmaps costs.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.bitmap;
+
+namespace {
+
+	using plastic::concurrency::Bitmap;
+
+	constexpr std::uint64_t kOpsPerThread = 1u << 22;
+
+	class LockedBitset {
+	private:
+		std::mutex m_mutex;
+		std::bitset<64> m_bits;
+
+	public:
+		bool Flip(std::size_t pos) {
+			std::lock_guard lock(m_mutex);
+			bool was_set = m_bits.test(pos);
+			m_bits.flip(pos);
+			return was_set;
+		}
+	};
+
+	template <bool MaxAlign>
+	void RunPerThread(plastic::bench::Context& ctx, char const* name, std::size_t threads, std::uint64_t ops) {
+		auto bitmaps = std::make_unique<Bitmap<std::uint64_t, MaxAlign>[]>(threads);
+		ctx.Run(name, threads, ops, [&](std::size_t t, std::uint64_t i) {
+			(void)bitmaps[t].Flip(i % 64);
+		});
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			{
+				Bitmap<std::uint64_t> bits;
+				ctx.Run("Bitmap shared", threads, ops, [&](std::size_t t, std::uint64_t) {
+					(void)bits.Flip(t % 64);
+				});
+			}
+			{
+				std::atomic<std::uint64_t> bits = 0;
+				ctx.Run("std::atomic fetch_xor shared", threads, ops, [&](std::size_t t, std::uint64_t) {
+					(void)bits.fetch_xor(std::uint64_t{ 1 } << (t % 64), std::memory_order::acq_rel);
+				});
+			}
+			{
+				LockedBitset bits;
+				ctx.Run("std::mutex + std::bitset shared", threads, ops, [&](std::size_t t, std::uint64_t) {
+					(void)bits.Flip(t % 64);
+				});
+			}
+			RunPerThread<false>(ctx, "Bitmap per thread", threads, ops);
+			RunPerThread<true>(ctx, "Bitmap per thread, aligned", threads, ops);
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("bitmap", &Run);
+
+}
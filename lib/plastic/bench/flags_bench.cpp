@@ -0,0 +1,136 @@
+// Flags suite: translating a descriptor flag set to a native enum.
+//
+// This is a model of the backend Extract*() translations, not a run of them:
+// those live in the fyuu_rhi backends, which plastic does not link. The
+// synthetic enum has the layout of fyuu_rhi::ResourceFlagBits (108 bits, the
+// 60 formats at 48..107) and a stand-in native table. The chained run is
+// what the backends used to do: AtomicFlags with a range check and one
+// Test() per candidate. The table run is what ExclusiveFlagRange::Select()
+// does: one mask, popcount and countr_zero, then an array lookup. Threads
+// translate a shared, read-only set of descriptors.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <print>
+#include <random>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.atomic_flags;
+import plastic.flags;
+
+namespace {
+
+	constexpr std::size_t kFormatFirst = 48;
+	constexpr std::size_t kFormatCount = 60;
+	constexpr std::size_t kDescriptorCount = 1u << 16;
+	constexpr std::uint64_t kOpsPerThread = 1u << 22;
+
+	enum class Bits : std::uint32_t {
+		Usage0 = 0,
+		FormatFirst = kFormatFirst,
+		FormatLast = kFormatFirst + kFormatCount - 1,
+		Count = kFormatFirst + kFormatCount
+	};
+
+	using Atomic = plastic::concurrency::AtomicFlags<Bits>;
+	using Plain = plastic::ds::Flags<Bits>;
+
+	// Stands in for a native format enum.
+	constexpr std::array<std::uint32_t, kFormatCount> kNative = []() {
+		std::array<std::uint32_t, kFormatCount> table{};
+		for (std::size_t i = 0; i < kFormatCount; ++i) {
+			table[i] = static_cast<std::uint32_t>(1000 + i * 3);
+		}
+		return table;
+	}();
+
+	constexpr Bits FormatBit(std::size_t i) noexcept {
+		return static_cast<Bits>(kFormatFirst + i);
+	}
+
+	std::uint32_t TranslateChained(Atomic const& flags) {
+		if (flags.TestAnyInRange(Bits::FormatFirst, Bits::FormatLast) &&
+			!flags.TestSingleInRange(Bits::FormatFirst, Bits::FormatLast)) {
+			return 0;
+		}
+		std::uint32_t result = 0;
+		[&]<std::size_t... I>(std::index_sequence<I...>) {
+			(void)((flags.Test(FormatBit(I)) ? (result = kNative[I], true) : false) || ...);
+		}(std::make_index_sequence<kFormatCount>{});
+		return result;
+	}
+
+	std::uint32_t TranslateTable(Plain const& flags) {
+		constexpr Plain kMask = Plain::FromRange(Bits::FormatFirst, Bits::FormatLast);
+		Plain members = flags & kMask;
+		if (members.Count() != 1) {
+			return 0;
+		}
+		return kNative[static_cast<std::size_t>(*members.First()) - kFormatFirst];
+	}
+
+	struct Descriptors {
+		std::vector<Atomic> atomic;
+		std::vector<Plain> plain;
+	};
+
+	Descriptors MakeDescriptors() {
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<std::size_t> format(0, kFormatCount - 1);
+		Descriptors descriptors{ std::vector<Atomic>(kDescriptorCount), std::vector<Plain>(kDescriptorCount) };
+		for (std::size_t i = 0; i < kDescriptorCount; ++i) {
+			Bits bit = FormatBit(format(gen));
+			descriptors.atomic[i].Set(Bits::Usage0);
+			descriptors.atomic[i].Set(bit);
+			descriptors.plain[i] = Plain(Bits::Usage0, bit);
+		}
+		return descriptors;
+	}
+
+	std::size_t DescriptorOf(std::size_t thread, std::uint64_t i) noexcept {
+		return (i * 7 + thread * 131) % kDescriptorCount;
+	}
+
+	// Results are folded into a sink so translations cannot be optimized away.
+	struct alignas(64) Sink {
+		std::uint64_t value = 0;
+	};
+
+	void Run(plastic::bench::Context& ctx) {
+		Descriptors descriptors = MakeDescriptors();
+		for (std::size_t i = 0; i < kDescriptorCount; ++i) {
+			if (TranslateChained(descriptors.atomic[i]) != TranslateTable(descriptors.plain[i])) {
+				std::println("flags: translation mismatch at descriptor {}", i);
+				return;
+			}
+		}
+
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			{
+				auto sinks = std::make_unique<Sink[]>(threads);
+				ctx.Run("AtomicFlags chained", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					sinks[t].value += TranslateChained(descriptors.atomic[DescriptorOf(t, i)]);
+				});
+			}
+			{
+				auto sinks = std::make_unique<Sink[]>(threads);
+				ctx.Run("Flags table", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					sinks[t].value += TranslateTable(descriptors.plain[DescriptorOf(t, i)]);
+				});
+			}
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("flags", &Run);
+
+}
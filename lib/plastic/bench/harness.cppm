@@ -0,0 +1,307 @@
+// ============================================================================
+// harness.cppm - Minimal benchmark harness for the plastic_bench suite
+// ============================================================================
+//
+// Benchmarks register themselves per suite and measure through
+// Context::Run(), which starts all threads together and reports throughput
+// over the whole run and latency percentiles of individually timed,
+// sampled operations. Results print as a table and can be written as JSON,
+// one result per line, so runs from two commits diff cleanly.
+
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <latch>
+#include <limits>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.bench;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::bench {
+
+	export struct Result {
+		std::string suite;
+		std::string name;
+		std::size_t threads;
+		std::uint64_t ops;
+		double ops_per_sec;
+		double p50_ns;
+		double p90_ns;
+		double p99_ns;
+		double p999_ns;
+	};
+
+	export class Context;
+
+	export using BenchmarkFn = void(*)(Context&);
+
+	struct Registration {
+		std::string_view suite;
+		BenchmarkFn fn;
+	};
+
+	std::vector<Registration>& Registrations() {
+		static std::vector<Registration> registrations;
+		return registrations;
+	}
+
+	/// Adds a suite at static initialization: `plastic::bench::Registrar r("queue", &Run);`
+	export struct Registrar {
+		Registrar(std::string_view suite, BenchmarkFn fn) {
+			Registrations().push_back({ suite, fn });
+		}
+	};
+
+	export class Context {
+	public:
+		/// Operation counts are rounded to a multiple of this, so an operation may do kBatch units of work at once.
+		static constexpr std::uint64_t kBatch = 64;
+		/// Every kSampleStride-th operation is timed on its own; prime, so it does not alias with kBatch.
+		static constexpr std::uint64_t kSampleStride = 61;
+		/// Runs of at most this many operations per thread time every operation.
+		static constexpr std::uint64_t kSampleAll = 4096;
+
+	private:
+		std::string_view m_suite;
+		std::string_view m_filter;
+		std::size_t m_max_threads;
+		bool m_quick;
+		double m_clock_overhead_ns;
+		std::vector<Result> m_results;
+
+		/// Cost of the two clock reads around a timed operation, subtracted from every sample.
+		static double ClockOverhead() {
+			double overhead = std::numeric_limits<double>::max();
+			for (int i = 0; i < 1000; ++i) {
+				auto start = std::chrono::steady_clock::now();
+				std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+				overhead = std::min(overhead, elapsed.count());
+			}
+			return overhead;
+		}
+
+		static double Percentile(std::vector<double>& samples, double p) {
+			if (samples.empty()) {
+				return 0.0;
+			}
+			auto nth = samples.begin() + static_cast<std::ptrdiff_t>(p * static_cast<double>(samples.size() - 1));
+			std::nth_element(samples.begin(), nth, samples.end());
+			return *nth;
+		}
+
+	public:
+		Context(std::string_view filter, std::size_t max_threads, bool quick)
+			: m_filter(filter), m_max_threads(max_threads), m_quick(quick), m_clock_overhead_ns(ClockOverhead()) {
+		}
+
+		void BeginSuite(std::string_view suite) noexcept {
+			m_suite = suite;
+		}
+
+		/// 1, 2, 4, ... up to and including the maximum thread count.
+		std::vector<std::size_t> ThreadSweep() const {
+			std::vector<std::size_t> sweep;
+			for (std::size_t threads = 1; threads < m_max_threads; threads *= 2) {
+				sweep.push_back(threads);
+			}
+			sweep.push_back(m_max_threads);
+			return sweep;
+		}
+
+		/// Scales an operation count down in quick mode.
+		std::uint64_t Ops(std::uint64_t full) const noexcept {
+			return m_quick ? std::max<std::uint64_t>(full / 16, kBatch) : full;
+		}
+
+		/**
+		 * @brief Runs `op(thread, i)` for i in [0, ops_per_thread) on each of `threads` threads.
+		 *
+		 * Threads are started and released together; throughput is total
+		 * operations over wall time from release until the last thread ends.
+		 * Latency percentiles come from single operations: every one in short
+		 * runs, otherwise every kSampleStride-th, less the clock overhead.
+		 */
+		template <class Op>
+		void Run(std::string_view name, std::size_t threads, std::uint64_t ops_per_thread, Op&& op) {
+			Run(name, std::vector<std::uint64_t>(threads, ops_per_thread), std::forward<Op>(op));
+		}
+
+		/// As above, but thread t runs `ops_per_thread[t]` operations, e.g. producers and consumers of different counts.
+		template <class Op>
+		void Run(std::string_view name, std::vector<std::uint64_t> ops_per_thread, Op&& op) {
+			if (!m_filter.empty() &&
+				std::format("{}/{}", m_suite, name).find(m_filter) == std::string::npos) {
+				return;
+			}
+			std::size_t threads = ops_per_thread.size();
+			std::uint64_t ops = 0;
+			for (std::uint64_t& count : ops_per_thread) {
+				count = std::max(count / kBatch, std::uint64_t{ 1 }) * kBatch;
+				ops += count;
+			}
+
+			std::vector<std::vector<double>> latencies(threads);
+			std::latch ready(static_cast<std::ptrdiff_t>(threads));
+			std::atomic<bool> go = false;
+			std::chrono::steady_clock::time_point start;
+			{
+				std::vector<std::jthread> workers;
+				workers.reserve(threads);
+				for (std::size_t t = 0; t < threads; ++t) {
+					workers.emplace_back([&, t]() {
+						std::uint64_t count = ops_per_thread[t];
+						std::uint64_t stride = count <= kSampleAll ? 1 : kSampleStride;
+						std::vector<double>& samples = latencies[t];
+						samples.reserve(static_cast<std::size_t>(count / stride + 1));
+						ready.count_down();
+						while (!go.load(std::memory_order::acquire)) {
+							std::this_thread::yield();
+						}
+						std::uint64_t until_sample = 0;
+						for (std::uint64_t i = 0; i < count; ++i) {
+							if (until_sample != 0) {
+								--until_sample;
+								op(t, i);
+								continue;
+							}
+							until_sample = stride - 1;
+							auto op_start = std::chrono::steady_clock::now();
+							op(t, i);
+							std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - op_start;
+							samples.push_back(std::max(elapsed.count() - m_clock_overhead_ns, 0.0));
+						}
+					});
+				}
+				ready.wait();
+				start = std::chrono::steady_clock::now();
+				go.store(true, std::memory_order::release);
+			}
+			std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+			std::vector<double> samples;
+			for (auto& thread_samples : latencies) {
+				samples.insert(samples.end(), thread_samples.begin(), thread_samples.end());
+			}
+			Result result{
+				std::string(m_suite),
+				std::string(name),
+				threads,
+				ops,
+				static_cast<double>(ops) / wall.count(),
+				Percentile(samples, 0.50),
+				Percentile(samples, 0.90),
+				Percentile(samples, 0.99),
+				Percentile(samples, 0.999)
+			};
+			std::println("{:<14} {:<34} {:>7} {:>14.0f} {:>9.1f} {:>9.1f} {:>9.1f} {:>9.1f}",
+				result.suite, result.name, result.threads, result.ops_per_sec,
+				result.p50_ns, result.p90_ns, result.p99_ns, result.p999_ns);
+			m_results.push_back(std::move(result));
+		}
+
+		std::vector<Result> const& Results() const noexcept {
+			return m_results;
+		}
+	};
+
+	std::string Escape(std::string_view text) {
+		std::string escaped;
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				escaped.push_back('\\');
+			}
+			escaped.push_back(c);
+		}
+		return escaped;
+	}
+
+	void WriteJson(std::string const& path, std::vector<Result> const& results) {
+		std::ofstream out(path);
+		out << std::format("{{\n\t\"hardware_concurrency\": {},\n\t\"results\": [\n", std::thread::hardware_concurrency());
+		for (std::size_t i = 0; i < results.size(); ++i) {
+			Result const& r = results[i];
+			out << std::format(
+				"\t\t{{\"suite\": \"{}\", \"name\": \"{}\", \"threads\": {}, \"ops\": {}, \"ops_per_sec\": {:.0f}, "
+				"\"p50_ns\": {:.2f}, \"p90_ns\": {:.2f}, \"p99_ns\": {:.2f}, \"p999_ns\": {:.2f}}}{}\n",
+				Escape(r.suite), Escape(r.name), r.threads, r.ops, r.ops_per_sec,
+				r.p50_ns, r.p90_ns, r.p99_ns, r.p999_ns,
+				i + 1 < results.size() ? "," : "");
+		}
+		out << "\t]\n}\n";
+	}
+
+	/**
+	 * @brief Entry point of plastic_bench.
+	 *
+	 * Options:
+	 *   --filter <text>	 only run benchmarks whose "suite/name" contains text
+	 *   --max-threads <n>  upper end of the thread sweep (default: hardware concurrency)
+	 *   --json <path>	  also write the results as JSON
+	 *   --quick			run 1/16 of the operations
+	 */
+	export int Main(int argc, char** argv) {
+		std::string_view filter;
+		std::string json_path;
+		std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+		bool quick = false;
+
+		for (int i = 1; i < argc; ++i) {
+			std::string_view arg = argv[i];
+			bool has_value = i + 1 < argc;
+			if (arg == "--filter" && has_value) {
+				filter = argv[++i];
+			}
+			else if (arg == "--json" && has_value) {
+				json_path = argv[++i];
+			}
+			else if (arg == "--max-threads" && has_value) {
+				std::string_view value = argv[++i];
+				std::from_chars(value.data(), value.data() + value.size(), max_threads);
+				max_threads = std::max<std::size_t>(max_threads, 1);
+			}
+			else if (arg == "--quick") {
+				quick = true;
+			}
+			else {
+				std::println("usage: {} [--filter text] [--max-threads n] [--json path] [--quick]", argv[0]);
+				return 1;
+			}
+		}
+
+		auto& registrations = Registrations();
+		std::stable_sort(registrations.begin(), registrations.end(),
+			[](Registration const& lhs, Registration const& rhs) {
+				return lhs.suite < rhs.suite;
+			});
+
+		Context context(filter, max_threads, quick);
+		std::println("{:<14} {:<34} {:>7} {:>14} {:>9} {:>9} {:>9} {:>9}",
+			"suite", "benchmark", "threads", "ops/s", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns");
+		for (Registration const& registration : registrations) {
+			context.BeginSuite(registration.suite);
+			registration.fn(context);
+		}
+
+		if (!json_path.empty()) {
+			WriteJson(json_path, context.Results());
+		}
+		return 0;
+	}
+
+}
@@ -0,0 +1,125 @@
+// Hash table suite: lookups and churn on 1024 random 64-bit keys.
+//
+// Lookups are three hits to one miss and run concurrently on a shared,
+// read-only table, so the sweep shows how each layout scales on reads.
+// Churn erases and reinserts one key per operation on a single thread.
+
+#include <version>
+#if defined(PLASTIC_BENCH_WITH_TBB)
+#include <tbb/concurrent_hash_map.h>
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.static_hash_table;
+
+namespace {
+
+	using plastic::ds::PerfectHashMap;
+	using plastic::ds::StaticHashTable;
+	using plastic::ds::StaticSwissTable;
+
+	constexpr std::size_t kKeyCount = 1024;
+	constexpr std::size_t kQueryCount = 4096;
+	constexpr std::uint64_t kOpsPerThread = 1u << 22;
+
+	struct Keys {
+		std::array<std::pair<std::uint64_t, std::uint64_t>, kKeyCount> entries;
+		std::vector<std::uint64_t> queries;	// three hits to one miss
+	};
+
+	Keys MakeKeys() {
+		std::mt19937_64 gen(42);
+		Keys keys;
+		for (std::size_t i = 0; i < kKeyCount; ++i) {
+			keys.entries[i] = { gen(), i };
+		}
+		for (std::size_t i = 0; i < kQueryCount; ++i) {
+			keys.queries.push_back(i % 4 == 3 ? gen() : keys.entries[gen() % kKeyCount].first);
+		}
+		return keys;
+	}
+
+	std::uint64_t QueryOf(Keys const& keys, std::size_t thread, std::uint64_t i) noexcept {
+		return keys.queries[(i * 7 + thread * 131) % kQueryCount];
+	}
+
+	// Results are folded into a sink so lookups cannot be optimized away.
+	struct alignas(64) Sink {
+		std::uint64_t value = 0;
+	};
+
+	template <class Table>
+	void RunLookups(plastic::bench::Context& ctx, char const* name, Table const& table, Keys const& keys, std::size_t threads, std::uint64_t ops) {
+		auto sinks = std::make_unique<Sink[]>(threads);
+		ctx.Run(name, threads, ops, [&](std::size_t t, std::uint64_t i) {
+			auto it = table.find(QueryOf(keys, t, i));
+			sinks[t].value += it != table.end() ? it->second : 1;
+		});
+	}
+
+	template <class Table>
+	void RunChurn(plastic::bench::Context& ctx, char const* name, Table& table, Keys const& keys, std::uint64_t ops) {
+		ctx.Run(name, 1, ops, [&](std::size_t, std::uint64_t i) {
+			auto const& [key, value] = keys.entries[(i * 7) % kKeyCount];
+			table.erase(key);
+			table.insert({ key, value });
+		});
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		Keys keys = MakeKeys();
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+
+		// Linear probing at half load.
+		auto linear = std::make_unique<StaticHashTable<std::uint64_t, std::uint64_t, kKeyCount * 2>>();
+		auto swiss = std::make_unique<StaticSwissTable<std::uint64_t, std::uint64_t, kKeyCount>>();
+		auto perfect = std::make_unique<PerfectHashMap<std::uint64_t, std::uint64_t, kKeyCount>>(keys.entries);
+		std::unordered_map<std::uint64_t, std::uint64_t> unordered;
+		unordered.reserve(kKeyCount);
+		for (auto const& entry : keys.entries) {
+			linear->insert(entry);
+			swiss->insert(entry);
+			unordered.insert(entry);
+		}
+#if defined(PLASTIC_BENCH_WITH_TBB)
+		tbb::concurrent_hash_map<std::uint64_t, std::uint64_t> concurrent;
+		for (auto const& entry : keys.entries) {
+			concurrent.insert(entry);
+		}
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			RunLookups(ctx, "StaticHashTable find", *linear, keys, threads, ops);
+			RunLookups(ctx, "StaticSwissTable find", *swiss, keys, threads, ops);
+			RunLookups(ctx, "PerfectHashMap find", *perfect, keys, threads, ops);
+			RunLookups(ctx, "std::unordered_map find", unordered, keys, threads, ops);
+#if defined(PLASTIC_BENCH_WITH_TBB)
+			auto sinks = std::make_unique<Sink[]>(threads);
+			ctx.Run("tbb::concurrent_hash_map find", threads, ops, [&](std::size_t t, std::uint64_t i) {
+				decltype(concurrent)::const_accessor acc;
+				sinks[t].value += concurrent.find(acc, QueryOf(keys, t, i)) ? acc->second : 1;
+			});
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+		}
+
+		ops = ctx.Ops(kOpsPerThread / 4);
+		RunChurn(ctx, "StaticHashTable erase+insert", *linear, keys, ops);
+		RunChurn(ctx, "StaticSwissTable erase+insert", *swiss, keys, ops);
+		RunChurn(ctx, "std::unordered_map erase+insert", unordered, keys, ops);
+	}
+
+	plastic::bench::Registrar s_registrar("hash_table", &Run);
+
+}
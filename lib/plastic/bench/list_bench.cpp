@@ -0,0 +1,54 @@
+// List suite: StaticList against std::list at a steady size of 512.
+//
+// Churn pushes to the back and pops from the front, iteration sums the
+// whole list. StaticList keeps its nodes in one array; std::list allocates
+// one node per element.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.static_list;
+
+namespace {
+
+	constexpr std::size_t kSize = 512;
+	constexpr std::uint64_t kChurnOps = 1u << 22;
+	constexpr std::uint64_t kIterateOps = 1u << 16;
+
+	template <class List>
+	void RunList(plastic::bench::Context& ctx, char const* churn_name, char const* iterate_name, List& list) {
+		for (std::size_t i = 0; i < kSize; ++i) {
+			list.push_back(i);
+		}
+		ctx.Run(churn_name, 1, ctx.Ops(kChurnOps), [&](std::size_t, std::uint64_t i) {
+			list.pop_front();
+			list.push_back(i);
+		});
+		std::uint64_t sum = 0;
+		ctx.Run(iterate_name, 1, ctx.Ops(kIterateOps), [&](std::size_t, std::uint64_t) {
+			for (std::uint64_t value : list) {
+				sum += value;
+			}
+		});
+		list.clear();
+		list.push_back(sum);
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		auto fixed = std::make_unique<plastic::ds::StaticList<std::uint64_t, kSize + 1>>();
+		RunList(ctx, "StaticList push_back+pop_front", "StaticList iterate", *fixed);
+		std::list<std::uint64_t> nodes;
+		RunList(ctx, "std::list push_back+pop_front", "std::list iterate", nodes);
+	}
+
+	plastic::bench::Registrar s_registrar("list", &Run);
+
+}
@@ -0,0 +1,65 @@
+// Object pool suite: PoolResource against synchronized_pool_resource and new/delete.
+//
+// Every thread keeps a window of 64 live 48-byte blocks and replaces one per
+// operation, the allocation pattern of handle objects created and destroyed
+// while streaming.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.object_pool;
+
+namespace {
+
+	constexpr std::size_t kBlockSize = 48;
+	constexpr std::size_t kWindow = 64;
+	constexpr std::uint64_t kOpsPerThread = 1u << 21;
+
+	struct alignas(64) Window {
+		std::array<void*, kWindow> blocks{};
+	};
+
+	void RunResource(plastic::bench::Context& ctx, char const* name, std::pmr::memory_resource& resource, std::size_t threads, std::uint64_t ops) {
+		auto windows = std::make_unique<Window[]>(threads);
+		ctx.Run(name, threads, ops, [&](std::size_t t, std::uint64_t i) {
+			void*& slot = windows[t].blocks[i % kWindow];
+			if (slot) {
+				resource.deallocate(slot, kBlockSize);
+			}
+			slot = resource.allocate(kBlockSize);
+		});
+		for (std::size_t t = 0; t < threads; ++t) {
+			for (void* block : windows[t].blocks) {
+				if (block) {
+					resource.deallocate(block, kBlockSize);
+				}
+			}
+		}
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			{
+				plastic::concurrency::PoolResource resource;
+				RunResource(ctx, "PoolResource", resource, threads, ops);
+			}
+			{
+				std::pmr::synchronized_pool_resource resource;
+				RunResource(ctx, "std::pmr::synchronized_pool", resource, threads, ops);
+			}
+			RunResource(ctx, "std::pmr::new_delete_resource", *std::pmr::new_delete_resource(), threads, ops);
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("object_pool", &Run);
+
+}
@@ -0,0 +1,200 @@
+// Queue suite: CircularBuffer against tbb::concurrent_queue and a locked std::deque.
+//
+// Every thread enqueues one command and then dequeues one, so any thread
+// count is balanced and the queue never runs full or dry. The batched run
+// moves kBatch commands per push_range/pop_into, which shows the cost of
+// per-element atomics and consumer wake-ups; each of its operations is one
+// batch, so it runs 1/kBatch as many.
+//
+// The split runs give each thread one role instead: P producer threads push
+// and C consumer threads pop, at 1:(n-1), n/2:n/2 and (n-1):1. Producers and
+// consumers run different operation counts so that both sides move the same
+// commands, and the queue runs full or dry as the slower side dictates.
+
+#include <version>
+#if defined(PLASTIC_BENCH_WITH_TBB)
+#include <tbb/concurrent_queue.h>
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.circular_buffer;
+
+namespace {
+
+	struct Command {
+		std::uint32_t opcode;
+		std::uint32_t payload;
+	};
+
+	constexpr std::uint64_t kOpsPerThread = 1u << 20;
+	constexpr std::size_t kQueueCapacity = 1u << 14;
+	constexpr std::size_t kBatch = plastic::bench::Context::kBatch;
+
+	using Queue = plastic::concurrency::CircularBuffer<Command>;
+
+	Command MakeCommand(std::size_t thread, std::uint64_t i) noexcept {
+		return { static_cast<std::uint32_t>(thread), static_cast<std::uint32_t>(i) };
+	}
+
+	class LockedDeque {
+	private:
+		std::mutex m_mutex;
+		std::deque<Command> m_queue;
+
+	public:
+		void Push(Command cmd) {
+			std::lock_guard lock(m_mutex);
+			m_queue.push_back(cmd);
+		}
+
+		bool TryPop(Command& cmd) {
+			std::lock_guard lock(m_mutex);
+			if (m_queue.empty()) {
+				return false;
+			}
+			cmd = m_queue.front();
+			m_queue.pop_front();
+			return true;
+		}
+	};
+
+	/// Producer counts for a split run over `threads`: one, half and all but one.
+	std::vector<std::size_t> ProducerCounts(std::size_t threads) {
+		std::vector<std::size_t> counts;
+		for (std::size_t producers : { std::size_t{ 1 }, threads / 2, threads - 1 }) {
+			if (producers != 0 && std::ranges::find(counts, producers) == counts.end()) {
+				counts.push_back(producers);
+			}
+		}
+		return counts;
+	}
+
+	/**
+	 * @brief Runs `push(thread, i)` on dedicated producer threads and `pop()` on the rest.
+	 *
+	 * About ops * threads / 2 commands go through the queue per run, split
+	 * evenly over the producers and over the consumers.
+	 */
+	template <class Push, class Pop>
+	void RunSplit(plastic::bench::Context& ctx, std::string_view name, std::size_t threads, std::uint64_t ops, Push push, Pop pop) {
+		for (std::size_t producers : ProducerCounts(threads)) {
+			std::size_t consumers = threads - producers;
+			// A multiple of kBatch per thread on both sides, so the harness does not round the two apart.
+			std::uint64_t unit = std::lcm(producers, consumers) * kBatch;
+			std::uint64_t commands = std::max(ops * threads / 2 / unit, std::uint64_t{ 1 }) * unit;
+			std::vector<std::uint64_t> counts(threads, commands / consumers);
+			std::fill_n(counts.begin(), producers, commands / producers);
+			ctx.Run(std::format("{} {}P/{}C", name, producers, consumers), std::move(counts), [&](std::size_t t, std::uint64_t i) {
+				if (t < producers) {
+					push(t, i);
+				}
+				else {
+					pop();
+				}
+			});
+		}
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			{
+				Queue queue(kQueueCapacity);
+				ctx.Run("CircularBuffer", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					while (!queue.push_back(MakeCommand(t, i))) {}
+					while (!queue.pop_front()) {}
+				});
+			}
+			{
+				Queue queue(kQueueCapacity);
+				// One operation is a whole batch, so latencies are those of a batch round trip.
+				ctx.Run("CircularBuffer batched", threads, ops / kBatch, [&](std::size_t t, std::uint64_t i) {
+					std::array<Command, kBatch> batch;
+					batch.fill(MakeCommand(t, i));
+					std::span<Command const> pending(batch);
+					while (!pending.empty()) {
+						pending = pending.subspan(queue.push_range(pending));
+					}
+					for (std::size_t received = 0; received < kBatch;) {
+						received += queue.pop_into(std::span(batch).subspan(received));
+					}
+				});
+			}
+#if defined(PLASTIC_BENCH_WITH_TBB)
+			{
+				tbb::concurrent_queue<Command> queue;
+				ctx.Run("tbb::concurrent_queue", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					queue.push(MakeCommand(t, i));
+					Command cmd;
+					while (!queue.try_pop(cmd)) {}
+				});
+			}
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+			{
+				LockedDeque queue;
+				ctx.Run("std::mutex + std::deque", threads, ops, [&](std::size_t t, std::uint64_t i) {
+					queue.Push(MakeCommand(t, i));
+					Command cmd;
+					while (!queue.TryPop(cmd)) {}
+				});
+			}
+			if (threads < 2) {
+				continue;
+			}
+			{
+				Queue queue(kQueueCapacity);
+				RunSplit(ctx, "CircularBuffer", threads, ops,
+					[&](std::size_t t, std::uint64_t i) {
+						while (!queue.push_back(MakeCommand(t, i))) {}
+					},
+					[&]() {
+						while (!queue.pop_front()) {}
+					});
+			}
+#if defined(PLASTIC_BENCH_WITH_TBB)
+			{
+				tbb::concurrent_queue<Command> queue;
+				RunSplit(ctx, "tbb::concurrent_queue", threads, ops,
+					[&](std::size_t t, std::uint64_t i) {
+						queue.push(MakeCommand(t, i));
+					},
+					[&]() {
+						Command cmd;
+						while (!queue.try_pop(cmd)) {}
+					});
+			}
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+			{
+				LockedDeque queue;
+				RunSplit(ctx, "std::mutex + std::deque", threads, ops,
+					[&](std::size_t t, std::uint64_t i) {
+						queue.Push(MakeCommand(t, i));
+					},
+					[&]() {
+						Command cmd;
+						while (!queue.TryPop(cmd)) {}
+					});
+			}
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("queue", &Run);
+
+}
@@ -0,0 +1,118 @@
+// Read-mostly suite: a 256-entry registry read by every thread while
+// thread 0 also replaces one entry every 4096 operations.
+//
+// This is the access pattern of the engine's caches, such as the Slang
+// session cache. Each read copies the value out, as callers cannot keep
+// references into the locked or copy-on-write tables.
+
+#include <version>
+#if defined(PLASTIC_BENCH_WITH_TBB)
+#include <tbb/concurrent_hash_map.h>
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.read_mostly_map;
+
+namespace {
+
+	using plastic::concurrency::ReadMostlyMap;
+
+	constexpr std::uint64_t kKeyCount = 256;
+	constexpr std::uint64_t kWriteInterval = 4096;
+	constexpr std::uint64_t kOpsPerThread = 1u << 21;
+
+	struct alignas(64) Sink {
+		std::uint64_t value = 0;
+	};
+
+	std::uint64_t KeyOf(std::size_t thread, std::uint64_t i) noexcept {
+		return (i * 7 + thread * 131) % kKeyCount;
+	}
+
+	bool IsWrite(std::size_t thread, std::uint64_t i) noexcept {
+		return thread == 0 && i % kWriteInterval == 0;
+	}
+
+	struct SharedMutexMap {
+		std::unordered_map<std::uint64_t, std::uint64_t> map;
+		mutable std::shared_mutex mutex;
+	};
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+
+		ReadMostlyMap<std::uint64_t, std::uint64_t> read_mostly;
+		read_mostly.update([](auto& map) {
+			for (std::uint64_t key = 0; key < kKeyCount; ++key) {
+				map.emplace(key, key);
+			}
+		});
+
+		SharedMutexMap locked;
+		for (std::uint64_t key = 0; key < kKeyCount; ++key) {
+			locked.map.emplace(key, key);
+		}
+
+#if defined(PLASTIC_BENCH_WITH_TBB)
+		tbb::concurrent_hash_map<std::uint64_t, std::uint64_t> concurrent;
+		for (std::uint64_t key = 0; key < kKeyCount; ++key) {
+			concurrent.insert({ key, key });
+		}
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+
+		for (std::size_t threads : ctx.ThreadSweep()) {
+			auto sinks = std::make_unique<Sink[]>(threads);
+
+			ctx.Run("ReadMostlyMap", threads, ops, [&](std::size_t t, std::uint64_t i) {
+				std::uint64_t key = KeyOf(t, i);
+				if (IsWrite(t, i)) {
+					read_mostly.insert_or_assign(key, i);
+				}
+				else {
+					sinks[t].value += read_mostly.find(key).value_or(1);
+				}
+			});
+
+			ctx.Run("shared_mutex+unordered_map", threads, ops, [&](std::size_t t, std::uint64_t i) {
+				std::uint64_t key = KeyOf(t, i);
+				if (IsWrite(t, i)) {
+					std::unique_lock lock(locked.mutex);
+					locked.map[key] = i;
+				}
+				else {
+					std::shared_lock lock(locked.mutex);
+					auto it = locked.map.find(key);
+					sinks[t].value += it != locked.map.end() ? it->second : 1;
+				}
+			});
+
+#if defined(PLASTIC_BENCH_WITH_TBB)
+			ctx.Run("tbb::concurrent_hash_map", threads, ops, [&](std::size_t t, std::uint64_t i) {
+				std::uint64_t key = KeyOf(t, i);
+				if (IsWrite(t, i)) {
+					decltype(concurrent)::accessor acc;
+					concurrent.insert(acc, key);
+					acc->second = i;
+				}
+				else {
+					decltype(concurrent)::const_accessor acc;
+					sinks[t].value += concurrent.find(acc, key) ? acc->second : 1;
+				}
+			});
+#endif // defined(PLASTIC_BENCH_WITH_TBB)
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("read_mostly", &Run);
+
+}
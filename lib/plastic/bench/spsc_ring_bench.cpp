@@ -0,0 +1,106 @@
+// SPSC ring suite: a one-producer, one-consumer command stream.
+//
+// The same commands go through CircularBuffer (MPMC), SpscRing and
+// SpscByteRing. Thread 0 produces and thread 1 consumes, so every run uses
+// exactly two threads and there is no sweep; each command counts as two
+// operations, its push and its pop. Both sides spin instead of yielding, so
+// the numbers are the queue's own cost when producer and consumer run on
+// separate cores.
+
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <print>
+#include <span>
+#endif // !defined(__cpp_lib_modules)
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.bench;
+import plastic.circular_buffer;
+import plastic.spsc_ring;
+
+namespace {
+
+	struct Command {
+		std::uint32_t opcode;
+		std::uint32_t payload;
+	};
+
+	constexpr std::uint64_t kOpsPerThread = 1u << 22;
+	constexpr std::size_t kQueueCapacity = 1u << 14;
+
+	/// Runs `produce(cmd)` on thread 0 and `consume()` on thread 1, then checks that every payload arrived.
+	template <class Produce, class Consume>
+	void RunStream(plastic::bench::Context& ctx, char const* name, std::uint64_t ops, Produce produce, Consume consume) {
+		std::uint64_t sum = 0;
+		std::uint64_t received = 0;
+		ctx.Run(name, 2, ops, [&](std::size_t t, std::uint64_t i) {
+			if (t == 0) {
+				produce(Command{ 1, static_cast<std::uint32_t>(i) });
+			}
+			else {
+				sum += consume();
+				++received;
+			}
+		});
+		if (sum != received * (received - 1) / 2) {
+			std::println("spsc_ring: payload mismatch in {}", name);
+		}
+	}
+
+	void Run(plastic::bench::Context& ctx) {
+		std::uint64_t ops = ctx.Ops(kOpsPerThread);
+		{
+			plastic::concurrency::CircularBuffer<Command> queue(kQueueCapacity);
+			RunStream(ctx, "CircularBuffer", ops,
+				[&](Command cmd) {
+					while (!queue.push_back(cmd)) {}
+				},
+				[&]() {
+					while (true) {
+						if (auto cmd = queue.pop_front()) {
+							return cmd->payload;
+						}
+					}
+				});
+		}
+		{
+			plastic::concurrency::SpscRing<Command> ring(kQueueCapacity);
+			RunStream(ctx, "SpscRing", ops,
+				[&](Command cmd) {
+					while (!ring.emplace_back(cmd)) {}
+				},
+				[&]() {
+					Command* cmd;
+					while (!(cmd = ring.front())) {}
+					std::uint32_t payload = cmd->payload;
+					ring.pop();
+					return payload;
+				});
+		}
+		{
+			plastic::concurrency::SpscByteRing ring(kQueueCapacity * 16);
+			RunStream(ctx, "SpscByteRing", ops,
+				[&](Command cmd) {
+					std::span<std::byte> span;
+					while (!(span = ring.write_span(sizeof(Command))).data()) {}
+					std::memcpy(span.data(), &cmd, sizeof(Command));
+					ring.commit(sizeof(Command));
+				},
+				[&]() {
+					std::span<std::byte> span;
+					while (!(span = ring.read_span()).data()) {}
+					Command cmd;
+					std::memcpy(&cmd, span.data(), sizeof(Command));
+					ring.release();
+					return cmd.payload;
+				});
+		}
+	}
+
+	plastic::bench::Registrar s_registrar("spsc_ring", &Run);
+
+}
@@ -0,0 +1,302 @@
+// ============================================================================
+// arena.cppm - Module interface for monotonic arenas and frame arenas
+// ============================================================================
+//
+// This module provides bump allocators for short-lived temporaries: the
+// scratch vectors of a pipeline or descriptor creation, or the per-frame
+// data of a renderer. An Arena hands out memory from a chain of blocks and
+// never frees individual allocations. It rewinds to a marker instead, and
+// keeps its blocks for the next use, so steady-state use does not touch the
+// heap at all.
+//
+// ArenaScope rewinds an arena (by default the calling thread's) when it
+// goes out of scope and exposes it as a std::pmr::memory_resource, so any
+// std::pmr container can draw from it. FrameArena keeps one arena per frame
+// in flight and recycles the arena of frame N - k once that frame retired.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.arena;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Monotonic allocator over a chain of reusable blocks.
+	 *
+	 * Not thread-safe: an arena belongs to one thread at a time. Requests
+	 * larger than the block size get a block of their own, which Rewind()
+	 * returns upstream instead of keeping.
+	 */
+	export class Arena {
+	public:
+		static constexpr std::size_t kDefaultBlockSize = 64 * 1024;
+
+		/// Position to rewind to; obtained from Mark().
+		struct Marker {
+			void* block;
+			std::byte* cursor;
+		};
+
+	private:
+		struct Block {
+			Block* next;
+			std::size_t capacity;	// bytes after the header
+		};
+
+		static constexpr std::size_t kHeaderSize =
+			(sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+		std::pmr::memory_resource* m_upstream;
+		std::size_t m_block_size;
+		Block* m_head = nullptr;
+		Block* m_current = nullptr;
+		std::byte* m_cursor = nullptr;
+		std::byte* m_end = nullptr;
+
+		static std::byte* DataOf(Block* block) noexcept {
+			return reinterpret_cast<std::byte*>(block) + kHeaderSize;
+		}
+
+		void FreeBlock(Block* block) noexcept {
+			m_upstream->deallocate(block, kHeaderSize + block->capacity, alignof(std::max_align_t));
+		}
+
+		void Enter(Block* block) noexcept {
+			m_current = block;
+			m_cursor = DataOf(block);
+			m_end = m_cursor + block->capacity;
+		}
+
+		/// Moves to the next cached block that fits, or links in a new one after the current block.
+		void* AllocateSlow(std::size_t bytes, std::size_t alignment) {
+			std::size_t needed = bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+			Block*& next = m_current ? m_current->next : m_head;
+			if (next && next->capacity >= needed) {
+				Enter(next);
+			}
+			else {
+				std::size_t capacity = std::max(needed, m_block_size);
+				auto* block = static_cast<Block*>(m_upstream->allocate(kHeaderSize + capacity, alignof(std::max_align_t)));
+				block->next = next;
+				block->capacity = capacity;
+				next = block;
+				Enter(block);
+			}
+			void* result = TryAllocate(bytes, alignment);
+			assert(result);
+			return result;
+		}
+
+		void* TryAllocate(std::size_t bytes, std::size_t alignment) noexcept {
+			if (!m_cursor) {
+				return nullptr;
+			}
+			auto address = reinterpret_cast<std::uintptr_t>(m_cursor);
+			auto padding = static_cast<std::size_t>(((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1)) - address);
+			if (static_cast<std::size_t>(m_end - m_cursor) < padding + bytes) {
+				return nullptr;
+			}
+			std::byte* begin = m_cursor + padding;
+			m_cursor = begin + bytes;
+			return begin;
+		}
+
+	public:
+		explicit Arena(std::size_t block_size = kDefaultBlockSize, std::pmr::memory_resource* upstream = nullptr)
+			: m_upstream(upstream ? upstream : std::pmr::get_default_resource()),
+			m_block_size(block_size) {
+		}
+
+		~Arena() {
+			Release();
+		}
+
+		Arena(Arena const&) = delete;
+		Arena& operator=(Arena const&) = delete;
+
+		[[nodiscard]] void* Allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+			assert(std::has_single_bit(alignment));
+			if (void* result = TryAllocate(bytes, alignment)) {
+				return result;
+			}
+			return AllocateSlow(bytes, alignment);
+		}
+
+		template <class T> [[nodiscard]] T* Allocate(std::size_t count = 1) {
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		[[nodiscard]] Marker Mark() const noexcept {
+			return { m_current, m_cursor };
+		}
+
+		/**
+		 * @brief Frees everything allocated since `marker` was taken.
+		 *
+		 * Markers must be rewound in LIFO order. Ordinary blocks past the
+		 * marker stay cached; oversized ones go back upstream.
+		 */
+		void Rewind(Marker marker) noexcept {
+			auto* block = static_cast<Block*>(marker.block);
+			Block** link = block ? &block->next : &m_head;
+			while (*link) {
+				if ((*link)->capacity > m_block_size) {
+					Block* oversized = *link;
+					*link = oversized->next;
+					FreeBlock(oversized);
+				}
+				else {
+					link = &(*link)->next;
+				}
+			}
+			m_current = block;
+			m_cursor = marker.cursor;
+			m_end = block ? DataOf(block) + block->capacity : nullptr;
+		}
+
+		/// Rewinds to the start, keeping the blocks.
+		void Reset() noexcept {
+			Rewind({ nullptr, nullptr });
+		}
+
+		/// Rewinds to the start and returns every block upstream.
+		void Release() noexcept {
+			while (m_head) {
+				Block* next = m_head->next;
+				FreeBlock(m_head);
+				m_head = next;
+			}
+			m_current = nullptr;
+			m_cursor = nullptr;
+			m_end = nullptr;
+		}
+	};
+
+	/// std::pmr adapter; deallocation is a no-op until the arena rewinds.
+	export class ArenaResource final : public std::pmr::memory_resource {
+	private:
+		Arena* m_arena;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			return m_arena->Allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void*, std::size_t, std::size_t) override {
+		}
+
+		bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+			return this == &other;
+		}
+
+	public:
+		explicit ArenaResource(Arena& arena) noexcept
+			: m_arena(&arena) {
+		}
+	};
+
+	/// The calling thread's scratch arena.
+	export Arena& ThreadArena() {
+		thread_local Arena arena;
+		return arena;
+	}
+
+	/**
+	 * @brief Rewinds an arena on destruction; everything allocated through it is scratch.
+	 *
+	 * Containers using resource() must not outlive the scope. Scopes on the
+	 * same arena nest and must end in reverse order.
+	 */
+	export class ArenaScope {
+	private:
+		Arena* m_arena;
+		Arena::Marker m_marker;
+		ArenaResource m_resource;
+
+	public:
+		explicit ArenaScope(Arena& arena = ThreadArena()) noexcept
+			: m_arena(&arena),
+			m_marker(arena.Mark()),
+			m_resource(arena) {
+		}
+
+		~ArenaScope() {
+			m_arena->Rewind(m_marker);
+		}
+
+		ArenaScope(ArenaScope const&) = delete;
+		ArenaScope& operator=(ArenaScope const&) = delete;
+
+		[[nodiscard]] std::pmr::memory_resource* resource() noexcept {
+			return &m_resource;
+		}
+
+		[[nodiscard]] Arena& arena() noexcept {
+			return *m_arena;
+		}
+	};
+
+	/**
+	 * @brief One arena per frame in flight.
+	 *
+	 * BeginFrame(n) resets the arena last used by frame n - frames_in_flight,
+	 * so the caller must have waited for that frame to retire (its fence
+	 * signalled) first. Allocations then live until frame n itself retires.
+	 */
+	export class FrameArena {
+	private:
+		std::vector<std::unique_ptr<Arena>> m_arenas;
+		std::vector<std::unique_ptr<ArenaResource>> m_resources;
+		std::size_t m_current = 0;
+
+	public:
+		explicit FrameArena(
+			std::size_t frames_in_flight,
+			std::size_t block_size = Arena::kDefaultBlockSize,
+			std::pmr::memory_resource* upstream = nullptr
+		) {
+			if (frames_in_flight == 0) {
+				throw std::invalid_argument("FrameArena needs at least one frame in flight");
+			}
+			m_arenas.reserve(frames_in_flight);
+			m_resources.reserve(frames_in_flight);
+			for (std::size_t i = 0; i < frames_in_flight; ++i) {
+				m_arenas.push_back(std::make_unique<Arena>(block_size, upstream));
+				m_resources.push_back(std::make_unique<ArenaResource>(*m_arenas.back()));
+			}
+		}
+
+		void BeginFrame(std::uint64_t frame) noexcept {
+			m_current = static_cast<std::size_t>(frame % m_arenas.size());
+			m_arenas[m_current]->Reset();
+		}
+
+		[[nodiscard]] Arena& Current() noexcept {
+			return *m_arenas[m_current];
+		}
+
+		[[nodiscard]] std::pmr::memory_resource* resource() noexcept {
+			return m_resources[m_current].get();
+		}
+
+		[[nodiscard]] std::size_t FramesInFlight() const noexcept {
+			return m_arenas.size();
+		}
+	};
+
+}
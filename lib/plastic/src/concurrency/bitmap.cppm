@@ -2,6 +2,7 @@ module;
 #include <version>
 #if !defined(__cpp_lib_modules)
 #include <atomic>
+#include <bit>
 #include <concepts>
 #include <cstddef>
 #include <new>
@@ -159,13 +160,17 @@ namespace plastic::concurrency {
 		}
 
 		[[nodiscard]] std::size_t Count() const noexcept {
-			T value = m_bits.load(std::memory_order::acquire);
-			std::size_t count = 0;
-			while (value) {
-				count += (value & 1);
-				value >>= 1;
-			}
-			return count;
+			return static_cast<std::size_t>(std::popcount(m_bits.load(std::memory_order::acquire)));
+		}
+
+		/// Position of the lowest set bit, or MaxBits() if none is set.
+		[[nodiscard]] std::size_t FindFirstSet() const noexcept {
+			return static_cast<std::size_t>(std::countr_zero(m_bits.load(std::memory_order::acquire)));
+		}
+
+		/// Position of the lowest clear bit, or MaxBits() if all bits are set.
+		[[nodiscard]] std::size_t FindFirstClear() const noexcept {
+			return static_cast<std::size_t>(std::countr_one(m_bits.load(std::memory_order::acquire)));
 		}
 
 		[[nodiscard]] bool Any() const noexcept {
@@ -3,55 +3,70 @@
 // ============================================================================
 //
 // This module provides a thread‑safe bounded circular (ring) buffer that
-// supports multiple producers and a single consumer (or multiple consumers if
-// they synchronize externally). It uses atomic operations for lock‑free
-// operation and a bitmap to indicate when a slot is fully constructed,
-// preventing the consumer from reading incompletely written elements.
+// supports multiple producers and multiple consumers. Every slot carries its
+// own sequence number (Dmitry Vyukov's bounded MPMC queue), so producers and
+// consumers only contend on one position counter each and never on a shared
+// occupancy word. Elements live in raw aligned storage inside the slot.
 
 module;
-
-#if !defined(__cpp_lib_modules)
 #include <version>
+#if !defined(__cpp_lib_modules)
 #include <optional>
 #include <atomic>
 #include <array>
 #include <span>
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <memory>
 #include <utility>
 #include <cstddef>
+#include <cstdint>
 #include <new>
+#include <ranges>
+#include <type_traits>
 #endif // !defined(__cpp_lib_modules)
 export module plastic.circular_buffer;
 #if defined(__cpp_lib_modules)
 import std;
 #endif // defined(__cpp_lib_modules)
-import plastic.bitmap;
+import plastic.wait_strategy;
 namespace plastic::concurrency {
 
 	// ------------------------------------------------------------------------
-	// CircularBuffer – lock‑safe bounded circular buffer for multiple producers
+	// CircularBuffer – lock‑free bounded MPMC circular buffer
 	// ------------------------------------------------------------------------
 
 	/**
-	 * @brief A thread‑safe circular buffer with a fixed capacity.
+	 * @brief A thread‑safe circular buffer with a bounded capacity.
+	 *
+	 * Each slot holds an atomic sequence number next to raw storage for one T.
+	 * A slot whose sequence equals the write position is free for the producer
+	 * that claims that position; a slot whose sequence equals position + 1 is
+	 * ready for the consumer that claims it. After consuming, the sequence is
+	 * advanced by one lap so the slot becomes free for the next round.
 	 *
-	 * This buffer is implemented as an array of optional<T> slots, plus two
-	 * atomic indices (read and write) and a bitmap. The bitmap marks slots
-	 * where the element has been fully constructed, allowing the consumer to
-	 * wait until construction is complete before reading.
+	 * Slots are grouped into cache‑line sized blocks and consecutive positions
+	 * are spread over different blocks, so neighbouring producers and consumers
+	 * do not write to the same cache line.
 	 *
 	 * The buffer supports:
 	 *   - Multiple concurrent producers (via emplace_back/push_back).
-	 *   - A single consumer (pop_front) – if multiple consumers are needed,
-	 *	 they must synchronize externally.
-	 *   - Wait‑free push (except when full) and a blocking pop option.
+	 *   - Multiple concurrent consumers (via pop_front).
+	 *   - Lock‑free push and pop, with an optional blocking pop.
+	 *   - Batched push_range/pop_into that claim a run of positions with a
+	 *     single atomic update and wake consumers once per batch.
+	 *   - A pluggable wait strategy for blocking and timed pops.
 	 *
 	 * @tparam T		The type of elements stored in the buffer.
-	 * @tparam Capacity The maximum number of elements the buffer can hold.
-	 *				  Must be > 0 and less than the maximum bits of the
-	 *				  underlying bitmap (typically 64 for size_t).
+	 * @tparam Capacity The maximum number of elements, or std::dynamic_extent
+	 *				  to choose it at construction. The capacity is rounded
+	 *				  up to a power of two of at least one cache line of slots.
+	 * @tparam Wait	 How blocked consumers wait and how producers wake them,
+	 *				  see plastic.wait_strategy. The default parks consumers and
+	 *				  only issues a wake when one is actually asleep.
 	 */
-	export template <class T, std::size_t Capacity>
+	export template <class T, std::size_t Capacity = std::dynamic_extent, WaitStrategy Wait = SpinThenParkWait>
 	class CircularBuffer {
 	public:
 		// Standard container type aliases.
@@ -62,49 +77,226 @@ namespace plastic::concurrency {
 		using pointer = T*;
 		using const_pointer = T const*;
 
-		// The bitmap uses the same size_type, with cache‑line alignment to avoid false sharing.
-		using Bitmap = Bitmap<size_type, true>;
+		static constexpr bool IsDynamic = Capacity == std::dynamic_extent;
 
 		static_assert(Capacity > size_type(0), "Capacity must be greater than 0");
-		static_assert(Capacity < Bitmap::MaxBits(), "Capacity out of range for the bitmap");
+		static_assert(std::is_nothrow_destructible_v<T>, "T must be nothrow destructible");
 
 	private:
-		// We allocate one extra slot to distinguish full from empty.
-		static constexpr size_type SlotCount = Capacity + 1;
-		std::array<std::optional<T>, SlotCount> m_slots;
+		static constexpr size_type kCacheLine = std::hardware_destructive_interference_size;
+
+		struct Slot {
+			std::atomic<size_type> sequence{ 0 };
+			alignas(T) std::byte storage[sizeof(T)];
+
+			T* Get() noexcept {
+				return std::launder(reinterpret_cast<T*>(storage));
+			}
+		};
+
+		// Number of slots sharing one cache‑line sized group.
+		static constexpr size_type kSlotsPerGroup = sizeof(Slot) >= kCacheLine ? 1 : std::bit_floor(kCacheLine / sizeof(Slot));
+
+		struct alignas(kCacheLine) SlotGroup {
+			std::array<Slot, kSlotsPerGroup> slots;
+		};
+
+		static constexpr size_type RoundCapacity(size_type capacity) noexcept {
+			return std::max(std::bit_ceil(capacity), kSlotsPerGroup);
+		}
+
+		static constexpr size_type kStaticSlotCount = IsDynamic ? 0 : RoundCapacity(Capacity);
+
+		using Storage = std::conditional_t<
+			IsDynamic,
+			std::unique_ptr<SlotGroup[]>,
+			std::array<SlotGroup, kStaticSlotCount / kSlotsPerGroup>
+		>;
+
+		Storage m_groups;
+		size_type m_mask;			// slot count - 1
+		size_type m_group_shift;	// log2(group count)
+
+		// Read and write positions are placed on separate cache lines to avoid false sharing.
+		alignas(kCacheLine) std::atomic<size_type> m_read_pos{ 0 };
+		alignas(kCacheLine) std::atomic<size_type> m_write_pos{ 0 };
+
+		// Consumer wait policy, on its own cache line as producers touch it on every publish.
+		alignas(kCacheLine) Wait m_wait;
+
+		/// Maps a position to its slot: consecutive positions land in different groups.
+		Slot& SlotAt(size_type pos) noexcept {
+			size_type idx = pos & m_mask;
+			size_type group_mask = (m_mask >> std::countr_zero(kSlotsPerGroup));
+			return m_groups[idx & group_mask].slots[idx >> m_group_shift];
+		}
+
+		void InitSlots() noexcept {
+			for (size_type i = 0; i <= m_mask; ++i) {
+				SlotAt(i).sequence.store(i, std::memory_order::relaxed);
+			}
+		}
+
+		static constexpr std::ptrdiff_t Distance(size_type seq, size_type pos) noexcept {
+			return static_cast<std::ptrdiff_t>(seq - pos);
+		}
+
+		/// Claims the slot for the next write position, or returns nullptr if full.
+		Slot* ClaimWrite(size_type& pos) noexcept {
+			pos = m_write_pos.load(std::memory_order::relaxed);
+			while (true) {
+				Slot& slot = SlotAt(pos);
+				std::ptrdiff_t dif = Distance(slot.sequence.load(std::memory_order::acquire), pos);
+				if (dif == 0) {
+					if (m_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+						return &slot;
+					}
+				}
+				else if (dif < 0) {
+					return nullptr;	// buffer full
+				}
+				else {
+					pos = m_write_pos.load(std::memory_order::relaxed);
+				}
+			}
+		}
+
+		/// Claims the slot for the next read position, or returns nullptr if empty.
+		Slot* ClaimRead(size_type& pos) noexcept {
+			pos = m_read_pos.load(std::memory_order::relaxed);
+			while (true) {
+				Slot& slot = SlotAt(pos);
+				std::ptrdiff_t dif = Distance(slot.sequence.load(std::memory_order::acquire), pos + 1);
+				if (dif == 0) {
+					if (m_read_pos.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+						return &slot;
+					}
+				}
+				else if (dif < 0) {
+					return nullptr;	// buffer empty (or the producer has not published yet)
+				}
+				else {
+					pos = m_read_pos.load(std::memory_order::relaxed);
+				}
+			}
+		}
+
+		/**
+		 * @brief Claims up to `count` consecutive write positions with one CAS.
+		 *
+		 * The claim is bounded by the consumers' read position, so every claimed
+		 * slot has already been taken by a consumer of the previous lap; the
+		 * producer may still have to wait for that consumer to finish moving out.
+		 *
+		 * @return The number of positions claimed, starting at `pos`.
+		 */
+		size_type ClaimWriteRange(size_type& pos, size_type count) noexcept {
+			pos = m_write_pos.load(std::memory_order::relaxed);
+			while (true) {
+				size_type read = m_read_pos.load(std::memory_order::acquire);
+				size_type used = pos > read ? pos - read : 0;
+				size_type n = std::min(count, capacity() - std::min(used, capacity()));
+				if (n == 0) {
+					return 0;	// buffer full
+				}
+				if (m_write_pos.compare_exchange_weak(pos, pos + n, std::memory_order::relaxed)) {
+					return n;
+				}
+			}
+		}
+
+		/**
+		 * @brief Claims up to `count` consecutive published read positions with one CAS.
+		 * @return The number of positions claimed, starting at `pos`.
+		 */
+		size_type ClaimReadRange(size_type& pos, size_type count) noexcept {
+			count = std::min(count, capacity());
+			pos = m_read_pos.load(std::memory_order::relaxed);
+			while (true) {
+				size_type n = 0;
+				while (n < count && Distance(SlotAt(pos + n).sequence.load(std::memory_order::acquire), pos + n + 1) == 0) {
+					++n;
+				}
+				if (n == 0) {
+					return 0;	// buffer empty (or the producer has not published yet)
+				}
+				if (m_read_pos.compare_exchange_weak(pos, pos + n, std::memory_order::relaxed)) {
+					return n;
+				}
+			}
+		}
 
-		// Read and write indices are placed on separate cache lines to avoid false sharing.
-		alignas(std::hardware_constructive_interference_size) std::atomic<size_type> m_read_pos;
-		alignas(std::hardware_constructive_interference_size) std::atomic<size_type> m_write_pos;
+		/// Spins until the consumer of the previous lap has released the slot.
+		static void WaitWritable(Slot& slot, size_type pos) noexcept {
+			Backoff backoff;
+			while (slot.sequence.load(std::memory_order::acquire) != pos) {
+				backoff.Pause();
+			}
+		}
 
-		// Bitmap indicating which slots contain fully constructed objects.
-		Bitmap m_bitmap;
+		/// Makes a constructed element visible to consumers, without waking them.
+		static void Publish(Slot& slot, size_type pos) noexcept {
+			slot.sequence.store(pos + 1, std::memory_order::release);
+		}
+
+		/// Destroys a consumed element and frees its slot for the producer one lap ahead.
+		void Release(Slot& slot, size_type pos) noexcept {
+			std::destroy_at(slot.Get());
+			slot.sequence.store(pos + m_mask + 1, std::memory_order::release);
+		}
+
+		/// Wakes consumers blocked in pop_front, if the wait strategy has any.
+		void NotifyConsumers() noexcept {
+			m_wait.Notify();
+		}
+
+		/// Moves the element out of a claimed slot and frees the slot.
+		std::optional<value_type> Take(Slot& slot, size_type pos) {
+			std::optional<value_type> popped(std::move(*slot.Get()));
+			Release(slot, pos);
+			return popped;
+		}
 
 	public:
 		// --------------------------------------------------------------------
 		// Construction / destruction
 		// --------------------------------------------------------------------
 
-		/// Default constructor – creates an empty buffer.
-		CircularBuffer() noexcept = default;
+		/// Default constructor – creates an empty buffer with a compile‑time capacity.
+		CircularBuffer() noexcept requires (!IsDynamic)
+			: m_groups(),
+			m_mask(kStaticSlotCount - 1),
+			m_group_shift(std::countr_zero(kStaticSlotCount / kSlotsPerGroup)) {
+			InitSlots();
+		}
+
+		/// Creates an empty buffer holding at least `capacity` elements.
+		explicit CircularBuffer(size_type capacity) requires IsDynamic
+			: m_groups(std::make_unique<SlotGroup[]>(RoundCapacity(std::max<size_type>(capacity, 1)) / kSlotsPerGroup)),
+			m_mask(RoundCapacity(std::max<size_type>(capacity, 1)) - 1),
+			m_group_shift(std::countr_zero((m_mask + 1) / kSlotsPerGroup)) {
+			InitSlots();
+		}
 
 		/**
 		 * @brief Constructs the buffer and fills it with elements from a span.
-		 * @param view A span of elements to copy into the buffer. At most Capacity
+		 * @param view A span of elements to copy into the buffer. At most capacity()
 		 *			 elements are taken.
 		 */
-		CircularBuffer(std::span<T const> view) {
-			size_type length = std::min(view.size(), Capacity);
+		CircularBuffer(std::span<T const> view) requires (!IsDynamic)
+			: CircularBuffer() {
+			size_type length = std::min(view.size(), capacity());
 			for (size_type i = 0; i < length; ++i) {
 				emplace_back(view[i]);
 			}
 		}
 
+		CircularBuffer(CircularBuffer const&) = delete;
+		CircularBuffer& operator=(CircularBuffer const&) = delete;
+
 		/// Destructor – destroys all remaining elements.
 		~CircularBuffer() noexcept {
-			while (!empty()) {
-				(void)pop_front();
-			}
+			while (pop_front()) {}
 		}
 
 		// --------------------------------------------------------------------
@@ -115,16 +307,17 @@ namespace plastic::concurrency {
 		bool empty() const noexcept {
 			return m_read_pos.load(std::memory_order::relaxed) == m_write_pos.load(std::memory_order::relaxed);
 		}
-		
-		/// Returns the number of elements currently in the buffer.
+
+		/// Returns the number of elements currently in the buffer (a snapshot under concurrency).
 		size_type size() const noexcept {
-			// (write - read) modulo SlotCount.
-			return (m_write_pos.load(std::memory_order::relaxed) - m_read_pos.load(std::memory_order::relaxed) + SlotCount) % SlotCount;
+			size_type read = m_read_pos.load(std::memory_order::relaxed);
+			size_type write = m_write_pos.load(std::memory_order::relaxed);
+			return write > read ? std::min(write - read, capacity()) : 0;
 		}
 
 		/// Returns the maximum number of elements the buffer can hold.
 		size_type capacity() const noexcept {
-			return Capacity;
+			return m_mask + 1;
 		}
 
 		// --------------------------------------------------------------------
@@ -135,8 +328,8 @@ namespace plastic::concurrency {
 		 * @brief Constructs an element in‑place at the back of the buffer.
 		 *
 		 * This operation is lock‑free. If the buffer is full, it returns false
-		 * immediately. Otherwise, it atomically reserves a slot, constructs the
-		 * element, and marks the slot as ready.
+		 * immediately. Otherwise, it claims a position, constructs the element
+		 * in the slot and publishes it by advancing the slot's sequence.
 		 *
 		 * @tparam Args Constructor argument types.
 		 * @param args Arguments forwarded to T's constructor.
@@ -144,30 +337,25 @@ namespace plastic::concurrency {
 		 */
 		template <class... Args>
 		bool emplace_back(Args&&... args) {
-			size_type expected_pos = m_write_pos.load(std::memory_order::acquire);
-			size_type desired_pos;
-
-			do {
-				desired_pos = (expected_pos + 1) % SlotCount;
-				// Full if the next write position would equal the read position.
-				if (desired_pos == m_read_pos.load(std::memory_order::acquire)) {
-					return false;   // buffer full
+			if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+				size_type pos;
+				Slot* slot = ClaimWrite(pos);
+				if (!slot) {
+					return false;
 				}
-			} while (!m_write_pos.compare_exchange_weak(
-				expected_pos,
-				desired_pos,
-				std::memory_order::release,
-				std::memory_order::relaxed));
-
-			// Notify any waiting consumer that the write position has moved.
-			m_write_pos.notify_all();
-
-			// Construct the element in the reserved slot.
-			m_slots[expected_pos].emplace(std::forward<Args>(args)...);
-			// Mark the slot as ready for the consumer.
-			(void)m_bitmap.TestAndSet(expected_pos);
-
-			return true;
+				std::construct_at(slot->Get(), std::forward<Args>(args)...);
+				Publish(*slot, pos);
+				NotifyConsumers();
+				return true;
+			}
+			else {
+				// A claimed position cannot be given back, so a throwing
+				// constructor runs before the claim and the result is moved in.
+				static_assert(std::is_nothrow_move_constructible_v<T>,
+					"T must be nothrow constructible from Args or nothrow move constructible");
+				T value(std::forward<Args>(args)...);
+				return emplace_back(std::move(value));
+			}
 		}
 
 		/// Copies a value into the buffer (equivalent to emplace_back(val)).
@@ -180,6 +368,39 @@ namespace plastic::concurrency {
 			return emplace_back(std::move(val));
 		}
 
+		/**
+		 * @brief Constructs a run of elements at the back of the buffer.
+		 *
+		 * Reserves as many slots as are free (up to the range size) with a single
+		 * CAS on the write position, constructs one element per slot from the
+		 * range's elements and wakes waiting consumers once. Pass
+		 * `values | std::views::as_rvalue` to move instead of copy.
+		 *
+		 * @return The number of leading elements of the range that were pushed.
+		 */
+		template <std::ranges::sized_range R>
+			requires std::ranges::input_range<R> &&
+				std::is_nothrow_constructible_v<T, std::ranges::range_reference_t<R>>
+		size_type push_range(R&& range) noexcept {
+			size_type count = static_cast<size_type>(std::ranges::size(range));
+			if (count == 0) {
+				return 0;
+			}
+			size_type pos;
+			size_type n = ClaimWriteRange(pos, count);
+			auto it = std::ranges::begin(range);
+			for (size_type i = 0; i < n; ++i, ++it) {
+				Slot& slot = SlotAt(pos + i);
+				WaitWritable(slot, pos + i);
+				std::construct_at(slot.Get(), *it);
+				Publish(slot, pos + i);
+			}
+			if (n != 0) {
+				NotifyConsumers();
+			}
+			return n;
+		}
+
 		// --------------------------------------------------------------------
 		// Consumer operations (pop)
 		// --------------------------------------------------------------------
@@ -188,60 +409,69 @@ namespace plastic::concurrency {
 		 * @brief Removes and returns the front element, or returns std::nullopt if empty.
 		 *
 		 * If `wait_for_element` is true and the buffer is empty, the call blocks
-		 * until an element becomes available. The waiting is efficient (uses
-		 * atomic::wait) and does not spin.
+		 * until an element becomes available, waiting as the Wait strategy
+		 * prescribes.
 		 *
 		 * @param wait_for_element If true, blocks until an element is present.
 		 * @return std::optional<T> – the popped element, or std::nullopt if
 		 *		 the buffer is empty and waiting was not requested.
 		 */
 		std::optional<value_type> pop_front(bool wait_for_element = false) {
-			size_type expected_pos = m_read_pos.load(std::memory_order::acquire);
-			size_type desired_pos;
-			bool cas_done = false;
-
-			do {
-				// Check if the buffer is empty.
-				if (expected_pos == m_write_pos.load(std::memory_order::acquire)) {
-					if (wait_for_element) {
-						// Block until the write position changes.
-						m_write_pos.wait(expected_pos, std::memory_order::relaxed);
-						// Reload expected_pos after waking.
-						expected_pos = m_read_pos.load(std::memory_order::acquire);
-						continue;
-					}
+			size_type pos;
+			Slot* slot = ClaimRead(pos);
+			if (!slot) {
+				if (!wait_for_element) {
 					return std::nullopt;
 				}
+				m_wait.Wait([this, &slot, &pos]() noexcept { return (slot = ClaimRead(pos)) != nullptr; });
+			}
+			return Take(*slot, pos);
+		}
 
-				// If the slot is not yet marked as ready (producer still constructing),
-				// we must wait. The bitmap test is not atomic with the read position,
-				// but this is safe because the producer sets the bitmap only after
-				// construction and before any subsequent write.
-				if (!m_bitmap.Test(expected_pos)) {
-					// The element is still being constructed; yield or continue.
-					// A simple spin is used here because the window is very short.
-					continue;
-				}
-
-				desired_pos = (expected_pos + 1) % SlotCount;
-
-				cas_done = m_read_pos.compare_exchange_weak(
-					expected_pos,
-					desired_pos,
-					std::memory_order::release,
-					std::memory_order::relaxed
-				);
-				// If CAS fails, expected_pos is updated with the current value,
-				// and the loop repeats.
-			} while (!cas_done);
+		/**
+		 * @brief Removes and returns the front element, waiting at most until `deadline`.
+		 * @return The popped element, or std::nullopt if none arrived in time.
+		 */
+		template <class Clock, class Duration>
+		std::optional<value_type> pop_front_until(std::chrono::time_point<Clock, Duration> const& deadline) {
+			size_type pos;
+			Slot* slot = ClaimRead(pos);
+			if (!slot && !m_wait.WaitUntil([this, &slot, &pos]() noexcept { return (slot = ClaimRead(pos)) != nullptr; }, deadline)) {
+				return std::nullopt;
+			}
+			return Take(*slot, pos);
+		}
 
-			// Successfully reserved the slot for reading. Move the element out.
-			std::optional<value_type> popped = std::move(m_slots[expected_pos]);
-			// Clear the slot and the bitmap (optional reset).
-			m_bitmap.Clear(expected_pos);
+		/**
+		 * @brief Removes and returns the front element, waiting at most `timeout`.
+		 * @return The popped element, or std::nullopt if none arrived in time.
+		 */
+		template <class Rep, class Period>
+		std::optional<value_type> pop_front_for(std::chrono::duration<Rep, Period> const& timeout) {
+			return pop_front_until(std::chrono::steady_clock::now() + timeout);
+		}
 
-			return popped;
+		/**
+		 * @brief Moves up to out.size() front elements into `out`.
+		 *
+		 * All elements that are already published are claimed with a single CAS
+		 * on the read position. Never blocks.
+		 *
+		 * @return The number of elements written to the front of `out`.
+		 */
+		size_type pop_into(std::span<value_type> out) noexcept requires std::is_nothrow_move_assignable_v<T> {
+			if (out.empty()) {
+				return 0;
+			}
+			size_type pos;
+			size_type n = ClaimReadRange(pos, out.size());
+			for (size_type i = 0; i < n; ++i) {
+				Slot& slot = SlotAt(pos + i);
+				out[i] = std::move(*slot.Get());
+				Release(slot, pos + i);
+			}
+			return n;
 		}
 	};
 
-} // namespace plastic::concurrency
\ No newline at end of file
+} // namespace plastic::concurrency
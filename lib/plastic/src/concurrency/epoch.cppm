@@ -0,0 +1,315 @@
+// ============================================================================
+// epoch.cppm - Module interface for epoch-based memory reclamation
+// ============================================================================
+//
+// This module lets readers traverse shared structures without locks while
+// writers unlink and retire nodes concurrently. A reader enters a critical
+// section with an EpochGuard, which publishes the global epoch in the
+// thread's slot. A retired node is freed only after the global epoch has
+// advanced twice past its retirement. The epoch advances only when every
+// active reader has observed the current one, so no reader can still hold
+// the node.
+//
+// Entering and leaving a guard costs two plain stores and a fence. There is
+// no read-modify-write on shared data. Where the OS can serialize all of
+// the process's threads on demand (membarrier on Linux,
+// FlushProcessWriteBuffers on Windows), that fence is only a compiler
+// barrier: the writer that advances the epoch pays for a process-wide fence
+// instead. Writers are expected to be rare, so retired nodes are kept in a
+// locked list and reclaimed in batches.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif // !defined(NOMINMAX)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif // !defined(WIN32_LEAN_AND_MEAN)
+#include <Windows.h>
+#elif defined(__linux__) && __has_include(<linux/membarrier.h>)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // defined(_WIN32)
+export module plastic.epoch;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.thread_slot;
+
+namespace {
+
+	constexpr std::size_t kMaxEpochThreads = plastic::concurrency::kMaxThreadSlots;
+
+	/// Whether HeavyFence() can serialize every thread of the process.
+	bool AsymmetricFencesAvailable() noexcept {
+#if defined(__SANITIZE_THREAD__)
+		// ThreadSanitizer cannot see the OS barrier and would report the reader side as racy.
+		return false;
+#elif defined(_WIN32)
+		return true;
+#elif defined(__linux__) && defined(SYS_membarrier) && __has_include(<linux/membarrier.h>)
+		static bool const registered =
+			syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+		return registered;
+#else
+		return false;
+#endif // defined(__SANITIZE_THREAD__)
+	}
+
+	/// Reader side: orders the slot store before the reads that follow it.
+	void LightFence(bool asymmetric) noexcept {
+		if (asymmetric) {
+			std::atomic_signal_fence(std::memory_order::seq_cst);
+		}
+		else {
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+		}
+	}
+
+	/// Writer side: acts as a full fence on every running thread when asymmetric.
+	void HeavyFence(bool asymmetric) noexcept {
+		if (asymmetric) {
+#if defined(_WIN32)
+			FlushProcessWriteBuffers();
+			return;
+#elif defined(__linux__) && defined(SYS_membarrier) && __has_include(<linux/membarrier.h>)
+			syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+			return;
+#endif // defined(_WIN32)
+		}
+		std::atomic_thread_fence(std::memory_order::seq_cst);
+	}
+
+}
+
+namespace plastic::concurrency {
+
+	export class EpochGuard;
+
+	/**
+	 * @brief Reclamation domain: a global epoch, one reader slot per thread and the retired list.
+	 *
+	 * Nodes retired into a domain must only be reachable by readers that
+	 * hold an EpochGuard on the same domain. Up to kMaxThreads threads get a
+	 * private slot; further threads share a counter, which costs them an
+	 * atomic increment per guard and holds back reclamation while any of
+	 * them is reading.
+	 */
+	export class EpochDomain {
+	public:
+		static constexpr std::size_t kMaxThreads = kMaxEpochThreads;
+
+	private:
+		friend class EpochGuard;
+
+		static constexpr std::size_t kCacheLine = std::hardware_destructive_interference_size;
+
+		struct alignas(kCacheLine) Slot {
+			std::atomic<std::uint64_t> epoch{ 0 };	// 0 while the thread is outside every guard
+			std::uint32_t nesting = 0;				// only touched by the owning thread
+		};
+
+		struct Retired {
+			void* pointer;
+			void (*deleter)(void*);
+			std::uint64_t epoch;
+		};
+
+		alignas(kCacheLine) std::atomic<std::uint64_t> m_epoch{ 1 };
+		alignas(kCacheLine) std::atomic<std::size_t> m_overflow_readers{ 0 };
+		std::array<Slot, kMaxThreads> m_slots;
+
+		bool m_asymmetric;
+		std::size_t m_batch;
+
+		std::mutex m_mutex;
+		std::vector<Retired> m_retired;
+		std::size_t m_retired_since_collect = 0;
+
+		/// Advances the epoch if every active reader has observed it. m_mutex must be held.
+		bool TryAdvance() noexcept {
+			std::uint64_t epoch = m_epoch.load(std::memory_order::relaxed);
+			HeavyFence(m_asymmetric);
+			for (Slot const& slot : m_slots) {
+				std::uint64_t observed = slot.epoch.load(std::memory_order::acquire);
+				if (observed != 0 && observed != epoch) {
+					return false;
+				}
+			}
+			if (m_overflow_readers.load(std::memory_order::acquire) != 0) {
+				return false;
+			}
+			m_epoch.store(epoch + 1, std::memory_order::release);
+			return true;
+		}
+
+		/// Moves out the nodes no reader can reach any more. m_mutex must be held.
+		std::vector<Retired> TakeReclaimable() {
+			std::uint64_t epoch = m_epoch.load(std::memory_order::relaxed);
+			std::vector<Retired> reclaimable;
+			std::erase_if(m_retired, [&](Retired const& retired) {
+				if (retired.epoch + 2 > epoch) {
+					return false;
+				}
+				reclaimable.push_back(retired);
+				return true;
+			});
+			return reclaimable;
+		}
+
+		/// Runs outside the lock, as a deleter may retire further nodes.
+		static void Free(std::vector<Retired> const& reclaimable) noexcept {
+			for (Retired const& retired : reclaimable) {
+				retired.deleter(retired.pointer);
+			}
+		}
+
+	public:
+		/// @param batch Number of retirements after which Retire() tries to reclaim.
+		explicit EpochDomain(std::size_t batch = 32)
+			: m_asymmetric(AsymmetricFencesAvailable()),
+			m_batch(batch) {
+		}
+
+		/// Frees everything still retired. No guard on this domain may be active.
+		~EpochDomain() {
+			assert(m_overflow_readers.load(std::memory_order::relaxed) == 0);
+			Free(m_retired);
+		}
+
+		EpochDomain(EpochDomain const&) = delete;
+		EpochDomain& operator=(EpochDomain const&) = delete;
+
+		/**
+		 * @brief Schedules `deleter(pointer)` for when no reader can hold `pointer`.
+		 *
+		 * The node must already be unreachable for new readers.
+		 */
+		void Retire(void* pointer, void (*deleter)(void*)) {
+			std::vector<Retired> reclaimable;
+			{
+				std::lock_guard lock(m_mutex);
+				m_retired.push_back({ pointer, deleter, m_epoch.load(std::memory_order::seq_cst) });
+				if (++m_retired_since_collect < m_batch) {
+					return;
+				}
+				m_retired_since_collect = 0;
+				TryAdvance();
+				reclaimable = TakeReclaimable();
+			}
+			Free(reclaimable);
+		}
+
+		template <class T> void Retire(T* pointer) {
+			Retire(const_cast<void*>(static_cast<void const*>(pointer)),
+				[](void* erased) {
+					delete static_cast<T*>(erased);
+				});
+		}
+
+		/// Advances the epoch if readers allow it and frees what became unreachable.
+		void Collect() {
+			std::vector<Retired> reclaimable;
+			{
+				std::lock_guard lock(m_mutex);
+				m_retired_since_collect = 0;
+				TryAdvance();
+				reclaimable = TakeReclaimable();
+			}
+			Free(reclaimable);
+		}
+
+		/**
+		 * @brief Waits for every guard active at the call to end, then frees everything retired before it.
+		 *
+		 * Must not be called while the calling thread holds a guard on this domain.
+		 */
+		void Synchronize() {
+			std::vector<Retired> reclaimable;
+			{
+				std::unique_lock lock(m_mutex);
+				std::uint64_t target = m_epoch.load(std::memory_order::relaxed) + 2;
+				while (m_epoch.load(std::memory_order::relaxed) < target) {
+					if (!TryAdvance()) {
+						lock.unlock();
+						std::this_thread::yield();
+						lock.lock();
+					}
+				}
+				m_retired_since_collect = 0;
+				reclaimable = TakeReclaimable();
+			}
+			Free(reclaimable);
+		}
+
+		std::uint64_t Epoch() const noexcept {
+			return m_epoch.load(std::memory_order::relaxed);
+		}
+	};
+
+	/// Process-wide domain for structures that do not need their own.
+	export EpochDomain& DefaultEpochDomain() {
+		// Never destroyed: detached threads may still read after static destruction.
+		static auto* domain = new EpochDomain();
+		return *domain;
+	}
+
+	/**
+	 * @brief Read-side critical section: nodes retired meanwhile stay alive until it ends.
+	 *
+	 * Guards nest; only the outermost one on a thread touches the slot.
+	 */
+	export class EpochGuard {
+	private:
+		EpochDomain* m_domain;
+		EpochDomain::Slot* m_slot;
+
+	public:
+		explicit EpochGuard(EpochDomain& domain = DefaultEpochDomain()) noexcept
+			: m_domain(&domain),
+			m_slot(nullptr) {
+			std::size_t index = CurrentThreadSlot();
+			if (index < EpochDomain::kMaxThreads) {
+				m_slot = &domain.m_slots[index];
+				if (m_slot->nesting++ == 0) {
+					// A stale epoch is harmless: it only holds back the next advance.
+					m_slot->epoch.store(domain.m_epoch.load(std::memory_order::relaxed), std::memory_order::relaxed);
+					LightFence(domain.m_asymmetric);
+				}
+			}
+			else {
+				domain.m_overflow_readers.fetch_add(1, std::memory_order::seq_cst);
+			}
+		}
+
+		~EpochGuard() {
+			if (m_slot) {
+				if (--m_slot->nesting == 0) {
+					m_slot->epoch.store(0, std::memory_order::release);
+				}
+			}
+			else {
+				m_domain->m_overflow_readers.fetch_sub(1, std::memory_order::release);
+			}
+		}
+
+		EpochGuard(EpochGuard const&) = delete;
+		EpochGuard& operator=(EpochGuard const&) = delete;
+	};
+
+}
@@ -0,0 +1,298 @@
+// ============================================================================
+// index_allocator.cppm - Module interface for a lock-free index allocator
+// ============================================================================
+//
+// This module provides a concurrent allocator for dense integer indices
+// (descriptor slots, queue indices, handle table entries). Allocation state
+// is a hierarchical bitset: the leaf level holds one bit per index, and every
+// higher level holds one bit per word of the level below that is set when
+// that word is full. Finding the lowest free index touches one word per
+// level, i.e. four words for a million indices.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.index_allocator;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Lock-free allocator of indices in [0, capacity).
+	 *
+	 * Leaf bits are the source of truth and are only changed with CAS or
+	 * fetch_and, so an index is never handed out twice. Summary bits are hints:
+	 * a thread that fills a word sets its summary bit and then re-checks the
+	 * word, and a thread that frees a bit in a full word clears it again.
+	 * A stale hint can only cost a retry; if the hierarchy reports the
+	 * allocator full, a linear scan over the leaves confirms it before
+	 * allocation fails.
+	 *
+	 * Bits past the capacity in the last word of each level are preset to
+	 * one, so "full" always means all bits set.
+	 */
+	export class IndexAllocator {
+	public:
+		using size_type = std::size_t;
+		using Word = std::uint64_t;
+
+		static constexpr size_type kBitsPerWord = std::numeric_limits<Word>::digits;
+
+	private:
+		static constexpr Word kFull = ~Word{ 0 };
+		static constexpr size_type kMaxRestarts = 16;
+
+		struct Level {
+			size_type offset;	// first word of this level in m_words
+			size_type count;	// number of words in this level
+		};
+
+		size_type m_capacity = 0;
+		std::vector<Level> m_levels;	// m_levels[0] is the leaf level, the last one has a single word
+		std::unique_ptr<std::atomic<Word>[]> m_words;
+
+		std::atomic<Word>& WordAt(size_type level, size_type idx) const noexcept {
+			return m_words[m_levels[level].offset + idx];
+		}
+
+		static constexpr Word Bit(size_type pos) noexcept {
+			return Word{ 1 } << (pos % kBitsPerWord);
+		}
+
+		static constexpr size_type WordCount(size_type bits) noexcept {
+			return (bits + kBitsPerWord - 1) / kBitsPerWord;
+		}
+
+		/// Word `idx` of `level` was observed full: publish that in the parent summary.
+		void MarkFull(size_type level, size_type idx) noexcept {
+			while (level + 1 < m_levels.size()) {
+				std::atomic<Word>& parent = WordAt(level + 1, idx / kBitsPerWord);
+				Word bit = Bit(idx);
+				Word old = parent.fetch_or(bit, std::memory_order::seq_cst);
+				if (WordAt(level, idx).load(std::memory_order::seq_cst) != kFull) {
+					// A free raced with us; withdraw the hint.
+					Word prev = parent.fetch_and(~bit, std::memory_order::seq_cst);
+					if (prev == kFull) {
+						MarkNotFull(level + 1, idx / kBitsPerWord);
+					}
+					return;
+				}
+				if ((old | bit) != kFull) {
+					return;
+				}
+				idx /= kBitsPerWord;
+				++level;
+			}
+		}
+
+		/// Word `idx` of `level` went from full to not full: clear the summary bits above it.
+		void MarkNotFull(size_type level, size_type idx) noexcept {
+			while (level + 1 < m_levels.size()) {
+				Word old = WordAt(level + 1, idx / kBitsPerWord).fetch_and(~Bit(idx), std::memory_order::seq_cst);
+				if (old != kFull) {
+					return;
+				}
+				idx /= kBitsPerWord;
+				++level;
+			}
+		}
+
+		/// Follows the summary hints down to a leaf word that looks non-full.
+		std::optional<size_type> FindLeaf() noexcept {
+			size_type idx = 0;
+			for (size_type level = m_levels.size() - 1; level > 0; --level) {
+				Word word = WordAt(level, idx).load(std::memory_order::acquire);
+				if (word == kFull) {
+					if (level + 1 < m_levels.size()) {
+						MarkFull(level, idx);
+					}
+					return std::nullopt;
+				}
+				idx = idx * kBitsPerWord + std::countr_zero(~word);
+			}
+			return idx;
+		}
+
+		/// Claims up to `max` free bits of one leaf word, lowest first. Returns the claimed mask.
+		Word ClaimInLeaf(size_type leaf, size_type max) noexcept {
+			std::atomic<Word>& word = WordAt(0, leaf);
+			Word old = word.load(std::memory_order::relaxed);
+			while (old != kFull) {
+				Word free = ~old;
+				Word claim = 0;
+				for (size_type i = 0; i < max && free != 0; ++i) {
+					Word lowest = free & (~free + 1);
+					claim |= lowest;
+					free ^= lowest;
+				}
+				if (word.compare_exchange_weak(old, old | claim, std::memory_order::acq_rel, std::memory_order::relaxed)) {
+					if ((old | claim) == kFull) {
+						MarkFull(0, leaf);
+					}
+					return claim;
+				}
+			}
+			MarkFull(0, leaf);
+			return 0;
+		}
+
+		static size_type Emit(size_type leaf, Word claim, std::span<size_type> out) noexcept {
+			size_type n = 0;
+			while (claim != 0) {
+				out[n++] = leaf * kBitsPerWord + std::countr_zero(claim);
+				claim &= claim - 1;
+			}
+			return n;
+		}
+
+	public:
+		IndexAllocator() noexcept = default;
+
+		/// Creates an allocator for indices in [0, capacity), all initially free.
+		explicit IndexAllocator(size_type capacity)
+			: m_capacity(capacity) {
+			if (capacity == 0) {
+				throw std::invalid_argument("IndexAllocator: capacity must be greater than 0");
+			}
+			size_type total_words = 0;
+			size_type bits = capacity;
+			do {
+				size_type words = WordCount(bits);
+				m_levels.push_back(Level{ total_words, words });
+				total_words += words;
+				bits = words;
+			} while (m_levels.back().count > 1);
+
+			m_words = std::make_unique<std::atomic<Word>[]>(total_words);
+			bits = capacity;
+			for (size_type level = 0; level < m_levels.size(); ++level) {
+				size_type tail = bits % kBitsPerWord;
+				if (tail != 0) {
+					WordAt(level, m_levels[level].count - 1).store(kFull << tail, std::memory_order::relaxed);
+				}
+				bits = m_levels[level].count;
+			}
+		}
+
+		IndexAllocator(IndexAllocator const&) = delete;
+		IndexAllocator& operator=(IndexAllocator const&) = delete;
+		IndexAllocator(IndexAllocator&&) noexcept = default;
+		IndexAllocator& operator=(IndexAllocator&&) noexcept = default;
+
+		size_type capacity() const noexcept {
+			return m_capacity;
+		}
+
+		/// Allocates the lowest free index, or returns std::nullopt if none is free.
+		std::optional<size_type> Allocate() noexcept {
+			size_type idx;
+			return AllocateBulk(std::span<size_type>(&idx, 1)) == 1 ? std::optional<size_type>(idx) : std::nullopt;
+		}
+
+		/**
+		 * @brief Allocates up to out.size() indices, lowest free first.
+		 *
+		 * Runs of free bits in the same leaf word are claimed with one CAS.
+		 * @return The number of indices written to the front of `out`.
+		 */
+		size_type AllocateBulk(std::span<size_type> out) noexcept {
+			size_type filled = 0;
+			size_type restarts = 0;
+			while (filled < out.size() && restarts < kMaxRestarts) {
+				std::optional<size_type> leaf = FindLeaf();
+				if (!leaf) {
+					break;
+				}
+				Word claim = ClaimInLeaf(*leaf, out.size() - filled);
+				if (claim == 0) {
+					++restarts;
+					continue;
+				}
+				filled += Emit(*leaf, claim, out.subspan(filled));
+			}
+			// The summary may be stale; confirm with a scan before reporting failure.
+			for (size_type leaf = 0; filled < out.size() && leaf < m_levels[0].count; ++leaf) {
+				if (WordAt(0, leaf).load(std::memory_order::relaxed) == kFull) {
+					continue;
+				}
+				Word claim = ClaimInLeaf(leaf, out.size() - filled);
+				filled += Emit(leaf, claim, out.subspan(filled));
+			}
+			return filled;
+		}
+
+		/// Claims a specific index. Returns false if it is already allocated.
+		bool TryAllocate(size_type index) noexcept {
+			assert(index < m_capacity && "IndexAllocator::TryAllocate(): index out of range");
+			size_type leaf = index / kBitsPerWord;
+			Word bit = Bit(index);
+			Word old = WordAt(0, leaf).fetch_or(bit, std::memory_order::acq_rel);
+			if ((old & bit) != 0) {
+				return false;
+			}
+			if ((old | bit) == kFull) {
+				MarkFull(0, leaf);
+			}
+			return true;
+		}
+
+		/// Returns an index to the allocator.
+		void Free(size_type index) noexcept {
+			assert(index < m_capacity && "IndexAllocator::Free(): index out of range");
+			size_type leaf = index / kBitsPerWord;
+			Word old = WordAt(0, leaf).fetch_and(~Bit(index), std::memory_order::seq_cst);
+			assert((old & Bit(index)) != 0 && "IndexAllocator::Free(): index is not allocated");
+			if (old == kFull) {
+				MarkNotFull(0, leaf);
+			}
+		}
+
+		/// Returns many indices; indices sharing a leaf word are released with one atomic.
+		void FreeBulk(std::span<size_type const> indices) noexcept {
+			size_type i = 0;
+			while (i < indices.size()) {
+				size_type leaf = indices[i] / kBitsPerWord;
+				Word mask = 0;
+				for (; i < indices.size() && indices[i] / kBitsPerWord == leaf; ++i) {
+					assert(indices[i] < m_capacity && "IndexAllocator::FreeBulk(): index out of range");
+					mask |= Bit(indices[i]);
+				}
+				Word old = WordAt(0, leaf).fetch_and(~mask, std::memory_order::seq_cst);
+				assert((old & mask) == mask && "IndexAllocator::FreeBulk(): index is not allocated");
+				if (old == kFull) {
+					MarkNotFull(0, leaf);
+				}
+			}
+		}
+
+		bool IsAllocated(size_type index) const noexcept {
+			assert(index < m_capacity && "IndexAllocator::IsAllocated(): index out of range");
+			return (WordAt(0, index / kBitsPerWord).load(std::memory_order::acquire) & Bit(index)) != 0;
+		}
+
+		/// Number of allocated indices (a snapshot under concurrency).
+		size_type Count() const noexcept {
+			size_type total = 0;
+			for (size_type leaf = 0; leaf < m_levels[0].count; ++leaf) {
+				total += std::popcount(WordAt(0, leaf).load(std::memory_order::relaxed));
+			}
+			// Discount the padding bits preset in the last leaf word.
+			return total - (m_levels[0].count * kBitsPerWord - m_capacity);
+		}
+	};
+
+} // namespace plastic::concurrency
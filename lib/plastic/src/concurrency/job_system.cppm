@@ -0,0 +1,644 @@
+// ============================================================================
+// job_system.cppm - Module interface for a work-stealing job scheduler
+// ============================================================================
+//
+// This module provides JobSystem, a fixed pool of worker threads. Each
+// worker owns one Chase-Lev deque per priority: it pushes and pops jobs at
+// the bottom of its own deques without contention, and idle workers steal
+// from the top of other workers' deques. Jobs submitted from outside the
+// pool go through a shared injection queue.
+//
+// Completion is tracked with JobCounter, which can be waited on by threads
+// (JobSystem::Wait runs other jobs meanwhile) or co_awaited by coroutines.
+// JobSystem also satisfies the Executor concept of plastic.task, so tasks
+// can be bound to it with Task::Via().
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.job_system;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.wait_strategy;
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Single-owner, multi-thief deque (Chase and Lev, 2005).
+	 *
+	 * The owner pushes and pops at the bottom; any thread may steal from the
+	 * top. The ring grows when full; retired rings are kept until the deque
+	 * is destroyed because a thief may still be reading from one.
+	 *
+	 * @tparam T Trivially copyable element type, typically a pointer.
+	 */
+	template <class T> class WorkStealingDeque {
+	public:
+		static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque elements must be trivially copyable");
+
+	private:
+		struct Ring {
+			std::int64_t capacity;
+			std::unique_ptr<std::atomic<T>[]> slots;
+
+			explicit Ring(std::int64_t cap)
+				: capacity(cap),
+				slots(std::make_unique<std::atomic<T>[]>(static_cast<std::size_t>(cap))) {
+
+			}
+
+			T Load(std::int64_t i) const noexcept {
+				return slots[static_cast<std::size_t>(i & (capacity - 1))].load(std::memory_order::relaxed);
+			}
+
+			void Store(std::int64_t i, T value) noexcept {
+				slots[static_cast<std::size_t>(i & (capacity - 1))].store(value, std::memory_order::relaxed);
+			}
+		};
+
+		alignas(64) std::atomic<std::int64_t> m_top{ 0 };
+		alignas(64) std::atomic<std::int64_t> m_bottom{ 0 };
+		std::atomic<Ring*> m_ring;
+		std::vector<std::unique_ptr<Ring>> m_rings;	// owner only; the last one is current
+
+		Ring* Grow(Ring* ring, std::int64_t top, std::int64_t bottom) {
+			auto bigger = std::make_unique<Ring>(ring->capacity * 2);
+			for (std::int64_t i = top; i < bottom; ++i) {
+				bigger->Store(i, ring->Load(i));
+			}
+			Ring* raw = bigger.get();
+			m_rings.push_back(std::move(bigger));
+			m_ring.store(raw, std::memory_order::release);
+			return raw;
+		}
+
+	public:
+		explicit WorkStealingDeque(std::size_t capacity = 256) {
+			assert(std::has_single_bit(capacity) && "WorkStealingDeque: capacity must be a power of two");
+			m_rings.push_back(std::make_unique<Ring>(static_cast<std::int64_t>(capacity)));
+			m_ring.store(m_rings.back().get(), std::memory_order::relaxed);
+		}
+
+		WorkStealingDeque(WorkStealingDeque const&) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque const&) = delete;
+
+		/// Owner only.
+		void Push(T value) {
+			std::int64_t bottom = m_bottom.load(std::memory_order::relaxed);
+			std::int64_t top = m_top.load(std::memory_order::acquire);
+			Ring* ring = m_ring.load(std::memory_order::relaxed);
+			if (bottom - top >= ring->capacity) {
+				ring = Grow(ring, top, bottom);
+			}
+			ring->Store(bottom, value);
+			m_bottom.store(bottom + 1, std::memory_order::release);
+		}
+
+		/// Owner only. Takes the most recently pushed element.
+		std::optional<T> Pop() noexcept {
+			std::int64_t bottom = m_bottom.load(std::memory_order::relaxed) - 1;
+			Ring* ring = m_ring.load(std::memory_order::relaxed);
+			m_bottom.store(bottom, std::memory_order::seq_cst);
+			std::int64_t top = m_top.load(std::memory_order::seq_cst);
+			if (top > bottom) {
+				m_bottom.store(bottom + 1, std::memory_order::relaxed);
+				return std::nullopt;
+			}
+			T value = ring->Load(bottom);
+			if (top == bottom) {
+				// Last element: race the thieves for it.
+				bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order::seq_cst, std::memory_order::relaxed);
+				m_bottom.store(bottom + 1, std::memory_order::relaxed);
+				if (!won) {
+					return std::nullopt;
+				}
+			}
+			return value;
+		}
+
+		/// Any thread. Takes the oldest element; may fail spuriously under contention.
+		std::optional<T> Steal() noexcept {
+			std::int64_t top = m_top.load(std::memory_order::seq_cst);
+			std::int64_t bottom = m_bottom.load(std::memory_order::seq_cst);
+			if (top >= bottom) {
+				return std::nullopt;
+			}
+			Ring* ring = m_ring.load(std::memory_order::acquire);
+			T value = ring->Load(top);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order::seq_cst, std::memory_order::relaxed)) {
+				return std::nullopt;
+			}
+			return value;
+		}
+
+		bool Empty() const noexcept {
+			return m_top.load(std::memory_order::relaxed) >= m_bottom.load(std::memory_order::relaxed);
+		}
+	};
+
+	export enum class JobPriority : std::uint8_t {
+		High,
+		Normal,
+		Low,
+		Count
+	};
+
+	/**
+	 * @brief Number of outstanding jobs, awaitable by threads and coroutines.
+	 *
+	 * Jobs submitted with a counter increment it and decrement it when they
+	 * finish. The first exception thrown by such a job is kept and rethrown
+	 * by JobSystem::Wait() or the co_await expression. A counter can be
+	 * reused once it has dropped to zero.
+	 */
+	export class JobCounter {
+	private:
+		friend class JobSystem;
+
+		std::atomic<std::size_t> m_pending{ 0 };
+		std::mutex m_mutex;
+		std::vector<std::coroutine_handle<>> m_waiters;
+		std::exception_ptr m_exception;
+
+		void Add(std::size_t count) noexcept {
+			m_pending.fetch_add(count, std::memory_order::relaxed);
+		}
+
+		void Fail(std::exception_ptr ex) noexcept {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception) {
+				m_exception = std::move(ex);
+			}
+		}
+
+		/**
+		 * @brief Marks one job finished; the last one resumes every suspended coroutine inline.
+		 *
+		 * The final decrement happens under the mutex. Every path that observes
+		 * zero takes the mutex before returning to the owner (Rethrow(), the
+		 * awaiter), so the counter cannot be destroyed while this still uses it.
+		 * Returns true for the final decrement; the counter must not be touched
+		 * after that.
+		 */
+		bool Done() {
+			std::size_t pending = m_pending.load(std::memory_order::relaxed);
+			while (pending > 1) {
+				if (m_pending.compare_exchange_weak(pending, pending - 1, std::memory_order::acq_rel, std::memory_order::relaxed)) {
+					return false;
+				}
+			}
+			std::vector<std::coroutine_handle<>> waiters;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_pending.fetch_sub(1, std::memory_order::acq_rel) != 1) {
+					return false;
+				}
+				waiters.swap(m_waiters);
+			}
+			for (std::coroutine_handle<> waiter : waiters) {
+				waiter.resume();
+			}
+			return true;
+		}
+
+		void Rethrow() {
+			std::exception_ptr ex;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				ex = std::exchange(m_exception, nullptr);
+			}
+			if (ex) {
+				std::rethrow_exception(ex);
+			}
+		}
+
+	public:
+		JobCounter() noexcept = default;
+
+		JobCounter(JobCounter const&) = delete;
+		JobCounter& operator=(JobCounter const&) = delete;
+
+		~JobCounter() noexcept {
+			assert(IsDone() && "JobCounter destroyed with jobs outstanding");
+		}
+
+		bool IsDone() const noexcept {
+			return m_pending.load(std::memory_order::acquire) == 0;
+		}
+
+		std::size_t Pending() const noexcept {
+			return m_pending.load(std::memory_order::relaxed);
+		}
+
+		/// Suspends the coroutine until the counter reaches zero. It resumes on the thread that finished the last job.
+		auto operator co_await() noexcept {
+			struct Awaiter {
+				JobCounter& counter;
+
+				bool await_ready() const noexcept {
+					return counter.IsDone();
+				}
+
+				bool await_suspend(std::coroutine_handle<> waiter) {
+					std::lock_guard<std::mutex> lock(counter.m_mutex);
+					if (counter.IsDone()) {
+						return false;
+					}
+					counter.m_waiters.push_back(waiter);
+					return true;
+				}
+
+				void await_resume() {
+					counter.Rethrow();
+				}
+			};
+			return Awaiter{ *this };
+		}
+	};
+
+	/**
+	 * @brief Work-stealing thread pool.
+	 *
+	 * Jobs are move-only callables taking no arguments. A job submitted from a
+	 * worker goes to that worker's deque, so recursive work stays cache-local
+	 * and is only stolen when another worker runs dry; other threads submit
+	 * through the injection queue. Workers always prefer higher-priority work
+	 * and sleep when there is none.
+	 *
+	 * The destructor runs every queued job before joining the workers.
+	 */
+	export class JobSystem {
+	private:
+		static constexpr std::size_t kPriorityCount = static_cast<std::size_t>(JobPriority::Count);
+		static constexpr std::size_t kSpinRounds = 64;
+
+		struct Job {
+			void (*run)(Job*);
+			JobCounter* counter;
+		};
+
+		template <class F> struct CallableJob : Job {
+			F fn;
+
+			static void Run(Job* base) {
+				std::unique_ptr<CallableJob> self(static_cast<CallableJob*>(base));
+				self->fn();
+			}
+		};
+
+		struct CoroutineJob : Job {
+			std::coroutine_handle<> handle;
+
+			static void Run(Job* base) {
+				std::coroutine_handle<> handle = static_cast<CoroutineJob*>(base)->handle;
+				delete static_cast<CoroutineJob*>(base);
+				handle.resume();
+			}
+		};
+
+		struct Worker {
+			std::array<WorkStealingDeque<Job*>, kPriorityCount> deques;
+			std::thread thread;
+		};
+
+		struct InjectionQueue {
+			std::mutex mutex;
+			std::deque<Job*> jobs;
+			std::atomic<std::size_t> size{ 0 };
+		};
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::array<InjectionQueue, kPriorityCount> m_injection;
+		std::atomic<bool> m_stopping{ false };
+		std::atomic<std::uint32_t> m_epoch{ 0 };
+		std::atomic<std::size_t> m_sleeping{ 0 };
+		std::atomic<std::size_t> m_waiting{ 0 };	// threads parked in Wait(); also counted in m_sleeping
+
+		static inline thread_local JobSystem* t_owner = nullptr;
+		static inline thread_local std::size_t t_index = 0;
+
+		std::optional<std::size_t> LocalIndex() const noexcept {
+			if (t_owner == this) {
+				return t_index;
+			}
+			return std::nullopt;
+		}
+
+		void Enqueue(Job* job, JobPriority priority) {
+			std::size_t p = static_cast<std::size_t>(priority);
+			if (std::optional<std::size_t> local = LocalIndex()) {
+				m_workers[*local]->deques[p].Push(job);
+			}
+			else {
+				InjectionQueue& queue = m_injection[p];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.jobs.push_back(job);
+				queue.size.fetch_add(1, std::memory_order::relaxed);
+			}
+			WakeOne();
+		}
+
+		void WakeOne() noexcept {
+			// Orders the publish above before the m_sleeping load; pairs with the fence in Sleep().
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (m_sleeping.load(std::memory_order::seq_cst) != 0) {
+				m_epoch.fetch_add(1, std::memory_order::seq_cst);
+				m_epoch.notify_one();
+			}
+		}
+
+		Job* PopInjected(std::size_t priority) {
+			InjectionQueue& queue = m_injection[priority];
+			if (queue.size.load(std::memory_order::relaxed) == 0) {
+				return nullptr;
+			}
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty()) {
+				return nullptr;
+			}
+			Job* job = queue.jobs.front();
+			queue.jobs.pop_front();
+			queue.size.fetch_sub(1, std::memory_order::relaxed);
+			return job;
+		}
+
+		/// Own deque first, then the injection queue, then victims, for each priority in turn.
+		Job* FindJob(std::optional<std::size_t> self) {
+			std::size_t count = m_workers.size();
+			std::size_t start = self ? *self + 1 : 0;
+			for (std::size_t p = 0; p < kPriorityCount; ++p) {
+				if (self) {
+					if (std::optional<Job*> job = m_workers[*self]->deques[p].Pop()) {
+						return *job;
+					}
+				}
+				if (Job* job = PopInjected(p)) {
+					return job;
+				}
+				for (std::size_t i = 0; i < count; ++i) {
+					std::size_t victim = (start + i) % count;
+					if (self && victim == *self) {
+						continue;
+					}
+					if (std::optional<Job*> job = m_workers[victim]->deques[p].Steal()) {
+						return *job;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		bool HasWork() const noexcept {
+			for (std::size_t p = 0; p < kPriorityCount; ++p) {
+				if (m_injection[p].size.load(std::memory_order::seq_cst) != 0) {
+					return true;
+				}
+				for (auto const& worker : m_workers) {
+					if (!worker->deques[p].Empty()) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		/// Wakes every thread parked in Wait() so it can re-check its counter; pairs with the fence in Park().
+		void WakeWaiters() noexcept {
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (m_waiting.load(std::memory_order::seq_cst) != 0) {
+				m_epoch.fetch_add(1, std::memory_order::seq_cst);
+				m_epoch.notify_all();
+			}
+		}
+
+		void Execute(Job* job) {
+			JobCounter* counter = job->counter;
+			try {
+				job->run(job);
+			}
+			catch (...) {
+				if (!counter) {
+					std::terminate();
+				}
+				counter->Fail(std::current_exception());
+			}
+			if (counter && counter->Done()) {
+				WakeWaiters();
+			}
+		}
+
+		void Sleep() {
+			std::uint32_t epoch = m_epoch.load(std::memory_order::seq_cst);
+			m_sleeping.fetch_add(1, std::memory_order::seq_cst);
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (!HasWork() && !m_stopping.load(std::memory_order::seq_cst)) {
+				m_epoch.wait(epoch, std::memory_order::seq_cst);
+			}
+			m_sleeping.fetch_sub(1, std::memory_order::seq_cst);
+		}
+
+		/**
+		 * @brief Sleeps in Wait() until new work arrives or some counter reaches zero.
+		 *
+		 * Parks on the shared epoch rather than on the counter, and counts as
+		 * sleeping, so WakeOne() still hands new jobs to a worker that is
+		 * blocked in a nested Wait() instead of losing it from the pool.
+		 */
+		void Park(JobCounter const& counter) {
+			std::uint32_t epoch = m_epoch.load(std::memory_order::seq_cst);
+			m_sleeping.fetch_add(1, std::memory_order::seq_cst);
+			m_waiting.fetch_add(1, std::memory_order::seq_cst);
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (!counter.IsDone() && !HasWork()) {
+				m_epoch.wait(epoch, std::memory_order::seq_cst);
+			}
+			m_waiting.fetch_sub(1, std::memory_order::seq_cst);
+			m_sleeping.fetch_sub(1, std::memory_order::seq_cst);
+		}
+
+		void WorkerMain(std::size_t index) {
+			t_owner = this;
+			t_index = index;
+			Backoff backoff;
+			std::size_t idle_rounds = 0;
+			for (;;) {
+				if (Job* job = FindJob(index)) {
+					Execute(job);
+					backoff.Reset();
+					idle_rounds = 0;
+					continue;
+				}
+				if (m_stopping.load(std::memory_order::acquire) && !HasWork()) {
+					return;
+				}
+				if (++idle_rounds < kSpinRounds) {
+					backoff.Pause();
+				}
+				else {
+					Sleep();
+					backoff.Reset();
+					idle_rounds = 0;
+				}
+			}
+		}
+
+		template <class F>
+		void Split(std::size_t first, std::size_t last, std::size_t grain, F& body, JobPriority priority, JobCounter& counter) {
+			// Lazy binary splitting: hand off the upper half of what is left
+			// only while this worker has nothing queued, i.e. once thieves have
+			// taken everything handed off so far. The rest runs one grain at a
+			// time so that is re-checked between grains.
+			std::optional<std::size_t> self = LocalIndex();
+			while (first < last) {
+				while (last - first > grain &&
+					(!self || m_workers[*self]->deques[static_cast<std::size_t>(priority)].Empty())) {
+					std::size_t mid = first + (last - first) / 2;
+					Submit([this, mid, last, grain, &body, priority, &counter]() {
+						Split(mid, last, grain, body, priority, counter);
+					}, priority, &counter);
+					last = mid;
+				}
+				std::size_t end = std::min(last, first + grain);
+				if constexpr (std::invocable<F&, std::size_t, std::size_t>) {
+					std::invoke(body, first, end);
+				}
+				else {
+					for (std::size_t i = first; i < end; ++i) {
+						std::invoke(body, i);
+					}
+				}
+				first = end;
+			}
+		}
+
+	public:
+		/// Starts `worker_count` threads; by default one per hardware thread but the caller's.
+		explicit JobSystem(std::size_t worker_count = std::max(1u, std::thread::hardware_concurrency()) - 1) {
+			worker_count = std::max<std::size_t>(worker_count, 1);
+			m_workers.reserve(worker_count);
+			for (std::size_t i = 0; i < worker_count; ++i) {
+				m_workers.push_back(std::make_unique<Worker>());
+			}
+			for (std::size_t i = 0; i < worker_count; ++i) {
+				m_workers[i]->thread = std::thread(&JobSystem::WorkerMain, this, i);
+			}
+		}
+
+		JobSystem(JobSystem const&) = delete;
+		JobSystem& operator=(JobSystem const&) = delete;
+
+		~JobSystem() noexcept {
+			m_stopping.store(true, std::memory_order::seq_cst);
+			m_epoch.fetch_add(1, std::memory_order::seq_cst);
+			m_epoch.notify_all();
+			for (auto& worker : m_workers) {
+				worker->thread.join();
+			}
+		}
+
+		std::size_t WorkerCount() const noexcept {
+			return m_workers.size();
+		}
+
+		/// Index of the calling worker thread, or std::nullopt for threads outside this pool.
+		std::optional<std::size_t> CurrentWorker() const noexcept {
+			return LocalIndex();
+		}
+
+		/**
+		 * @brief Queues `fn` for execution.
+		 * @param counter Optional; incremented now and decremented when `fn` returns.
+		 *        Without a counter, an exception escaping `fn` terminates the program.
+		 */
+		template <class F>
+			requires std::invocable<std::decay_t<F>&>
+		void Submit(F&& fn, JobPriority priority = JobPriority::Normal, JobCounter* counter = nullptr) {
+			using Callable = CallableJob<std::decay_t<F>>;
+			Callable* job = new Callable{ { &Callable::Run, counter }, std::forward<F>(fn) };
+			if (counter) {
+				counter->Add(1);
+			}
+			Enqueue(job, priority);
+		}
+
+		/// Executor interface: resumes `handle` on a worker.
+		void Post(std::coroutine_handle<> handle, JobPriority priority = JobPriority::Normal) {
+			Enqueue(new CoroutineJob{ { &CoroutineJob::Run, nullptr }, handle }, priority);
+		}
+
+		/**
+		 * @brief Blocks until `counter` reaches zero, running other jobs meanwhile.
+		 *
+		 * Safe to call from inside a job: a worker blocked here keeps taking
+		 * new jobs, so nested waits cannot starve the pool. Rethrows the first
+		 * exception thrown by a job that was submitted with `counter`.
+		 */
+		void Wait(JobCounter& counter) {
+			std::optional<std::size_t> self = LocalIndex();
+			Backoff backoff;
+			while (!counter.IsDone()) {
+				if (Job* job = FindJob(self)) {
+					Execute(job);
+					backoff.Reset();
+				}
+				else if (backoff.IsSpinning()) {
+					backoff.Pause();
+				}
+				else {
+					Park(counter);
+				}
+			}
+			counter.Rethrow();
+		}
+
+		/**
+		 * @brief Calls `body` for every index in [first, last) and waits for all of them.
+		 *
+		 * `body` takes either an index or a [begin, end) pair. The range is split
+		 * lazily, only while the executing worker has no queued work, down to
+		 * `grain` indices; a grain of 0 picks one from the range size and
+		 * worker count.
+		 */
+		template <class F>
+			requires std::invocable<F&, std::size_t> || std::invocable<F&, std::size_t, std::size_t>
+		void ParallelFor(std::size_t first, std::size_t last, F&& body, std::size_t grain = 0, JobPriority priority = JobPriority::Normal) {
+			if (first >= last) {
+				return;
+			}
+			if (grain == 0) {
+				grain = std::max<std::size_t>(1, (last - first) / (m_workers.size() * 8));
+			}
+			JobCounter counter;
+			try {
+				Split(first, last, grain, body, priority, counter);
+			}
+			catch (...) {
+				// Jobs already handed off still reference `counter`; wait for them before rethrowing.
+				counter.Fail(std::current_exception());
+			}
+			Wait(counter);
+		}
+	};
+
+} // namespace plastic::concurrency
@@ -0,0 +1,567 @@
+// ============================================================================
+// object_pool.cppm - Module interface for lock-free fixed-size block pools
+// ============================================================================
+//
+// This module provides pools of equally sized blocks for objects that are
+// created and destroyed from many threads (resource handles, control blocks
+// of shared_ptrs). Blocks are carved from large slabs and addressed by
+// 32-bit indices, like the index free list of StaticList. Free blocks are
+// chained through a link array at the head of each slab, so a free block
+// holds no bookkeeping and any block size works.
+//
+// Each thread keeps two magazines (short chains of free blocks) per pool and
+// only touches shared state when both are exhausted or full: then a whole
+// magazine moves to or from the depot, a lock-free stack whose head is a
+// tagged index. Slab growth is the only path that takes a lock.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif // !defined(NOMINMAX)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif // !defined(WIN32_LEAN_AND_MEAN)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif // defined(_WIN32)
+export module plastic.object_pool;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.thread_slot;
+
+namespace {
+
+	constexpr std::size_t kMaxCachedThreads = plastic::concurrency::kMaxThreadSlots;
+
+	constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	/// Large-page memory straight from the OS, or nullptr if it is unavailable.
+	std::byte* AllocateLargePages(std::size_t bytes) noexcept {
+#if defined(_WIN32)
+		SIZE_T large_page = GetLargePageMinimum();
+		// Slabs must be aligned to their size, which large pages only guarantee up to one page.
+		if (large_page == 0 || bytes != large_page) {
+			return nullptr;
+		}
+		// Fails without SeLockMemoryPrivilege; the caller falls back.
+		return static_cast<std::byte*>(VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+#else
+		(void)bytes;
+		return nullptr;
+#endif // defined(_WIN32)
+	}
+
+	void FreeLargePages(std::byte* pages) noexcept {
+#if defined(_WIN32)
+		VirtualFree(pages, 0, MEM_RELEASE);
+#else
+		(void)pages;
+#endif // defined(_WIN32)
+	}
+
+	/// Asks the kernel to back an ordinary allocation with transparent huge pages.
+	void AdviseHugePages(std::byte* pages, std::size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		madvise(pages, bytes, MADV_HUGEPAGE);
+#else
+		(void)pages;
+		(void)bytes;
+#endif // defined(__linux__) && defined(MADV_HUGEPAGE)
+	}
+
+}
+
+namespace plastic::concurrency {
+
+	export struct PoolOptions {
+		/// Back slabs with 2 MiB huge pages where the platform allows it.
+		bool huge_pages = false;
+		/// Where slabs come from; std::pmr::get_default_resource() if null.
+		std::pmr::memory_resource* upstream = nullptr;
+	};
+
+	/**
+	 * @brief Thread-safe pool of blocks of one size and alignment.
+	 *
+	 * Allocate() and Deallocate() run against the calling thread's magazines
+	 * without atomics in the common case. A thread that runs dry pops a whole
+	 * magazine from the depot, and a thread whose magazines are both full
+	 * pushes one, so shared state is touched once per kMagazineBlocks
+	 * operations. The depot head packs a 32-bit tag with the index of the
+	 * first block of the top magazine, which rules out ABA on pop. The links
+	 * read speculatively during a pop live in the slab's link array, never in
+	 * block memory that a new owner may be writing.
+	 *
+	 * Slabs are only released when the pool is destroyed. Blocks cached by a
+	 * thread that exits stay with its cache slot and are reused by the next
+	 * thread that takes the slot. Threads beyond the number of cache slots
+	 * use the depot directly.
+	 */
+	export class BlockPool {
+	public:
+		using size_type = std::size_t;
+
+		static constexpr size_type kMaxBlockAlignment = 64;
+		static constexpr size_type kMagazineBlocks = 32;
+		static constexpr size_type kSlabBytes = size_type{ 64 } << 10;
+		static constexpr size_type kHugeSlabBytes = size_type{ 2 } << 20;
+		static constexpr size_type kMaxSlabs = 1024;
+
+	private:
+		using Index = std::uint32_t;
+
+		static constexpr Index kNil = ~Index{ 0 };
+
+		struct Link {
+			Index next = kNil;				// next block of the same magazine
+			Index count = 0;				// blocks in the magazine, valid on its first block
+			std::atomic<Index> below{ kNil };	// first block of the next magazine in the depot
+		};
+
+		struct SlabHeader {
+			Index id;
+			bool large_pages;
+		};
+
+		static constexpr size_type kLinksOffset = AlignUp(sizeof(SlabHeader), alignof(Link));
+
+		struct alignas(kMaxBlockAlignment) Cache {
+			Index loaded = kNil;
+			Index loaded_count = 0;
+			Index previous = kNil;
+			Index previous_count = 0;
+		};
+
+		struct Magazine {
+			Index head;
+			Index count;
+		};
+
+		size_type m_block_size;
+		size_type m_slab_bytes;
+		size_type m_blocks_per_slab;
+		size_type m_block_offset;
+		PoolOptions m_options;
+
+		alignas(kMaxBlockAlignment) std::atomic<std::uint64_t> m_depot{ kNil };
+		std::array<std::atomic<std::byte*>, kMaxSlabs> m_slabs{};
+		std::atomic<size_type> m_slab_count = 0;
+		std::mutex m_grow_mutex;
+		std::unique_ptr<Cache[]> m_caches;
+
+		static constexpr Index HeadOf(std::uint64_t depot) noexcept {
+			return static_cast<Index>(depot);
+		}
+
+		static constexpr std::uint64_t NextDepot(std::uint64_t depot, Index head) noexcept {
+			return (((depot >> 32) + 1) << 32) | head;
+		}
+
+		std::byte* SlabOf(Index idx) const noexcept {
+			return m_slabs[idx / m_blocks_per_slab].load(std::memory_order::acquire);
+		}
+
+		Link& LinkOf(Index idx) const noexcept {
+			Link* links = reinterpret_cast<Link*>(SlabOf(idx) + kLinksOffset);
+			return links[idx % m_blocks_per_slab];
+		}
+
+		void* BlockOf(Index idx) const noexcept {
+			return SlabOf(idx) + m_block_offset + (idx % m_blocks_per_slab) * m_block_size;
+		}
+
+		Index IndexOf(void* block) const noexcept {
+			auto address = reinterpret_cast<std::uintptr_t>(block);
+			auto* slab = reinterpret_cast<std::byte*>(address & ~static_cast<std::uintptr_t>(m_slab_bytes - 1));
+			auto const* header = reinterpret_cast<SlabHeader const*>(slab);
+			size_type offset = (static_cast<std::byte*>(block) - slab - m_block_offset) / m_block_size;
+			return static_cast<Index>(header->id * m_blocks_per_slab + offset);
+		}
+
+		void PushMagazine(Magazine magazine) noexcept {
+			Link& head = LinkOf(magazine.head);
+			head.count = magazine.count;
+			std::uint64_t depot = m_depot.load(std::memory_order::relaxed);
+			do {
+				head.below.store(HeadOf(depot), std::memory_order::relaxed);
+			} while (!m_depot.compare_exchange_weak(depot, NextDepot(depot, magazine.head),
+				std::memory_order::release, std::memory_order::relaxed));
+		}
+
+		std::optional<Magazine> TryPopMagazine() noexcept {
+			std::uint64_t depot = m_depot.load(std::memory_order::acquire);
+			while (HeadOf(depot) != kNil) {
+				Index head = HeadOf(depot);
+				// May read a magazine that another thread is popping; the tag makes the CAS fail then.
+				Index below = LinkOf(head).below.load(std::memory_order::relaxed);
+				if (m_depot.compare_exchange_weak(depot, NextDepot(depot, below),
+					std::memory_order::acquire, std::memory_order::acquire)) {
+					return Magazine{ head, LinkOf(head).count };
+				}
+			}
+			return std::nullopt;
+		}
+
+		Magazine PopMagazine() {
+			while (true) {
+				if (auto magazine = TryPopMagazine()) {
+					return *magazine;
+				}
+				Grow();
+			}
+		}
+
+		std::byte* AllocateSlab(bool& large_pages) {
+			large_pages = false;
+			if (m_options.huge_pages) {
+				if (std::byte* pages = AllocateLargePages(m_slab_bytes)) {
+					large_pages = true;
+					return pages;
+				}
+			}
+			// Slabs are aligned to their size so a block finds its slab header by masking.
+			auto* slab = static_cast<std::byte*>(m_options.upstream->allocate(m_slab_bytes, m_slab_bytes));
+			if (m_options.huge_pages) {
+				AdviseHugePages(slab, m_slab_bytes);
+			}
+			return slab;
+		}
+
+		void Grow() {
+			std::lock_guard lock(m_grow_mutex);
+			if (HeadOf(m_depot.load(std::memory_order::acquire)) != kNil) {
+				// Another thread grew the pool or returned a magazine meanwhile.
+				return;
+			}
+			size_type id = m_slab_count.load(std::memory_order::relaxed);
+			if (id == kMaxSlabs) {
+				throw std::bad_alloc();
+			}
+
+			bool large_pages;
+			std::byte* slab = AllocateSlab(large_pages);
+			::new (slab) SlabHeader{ static_cast<Index>(id), large_pages };
+			Link* links = reinterpret_cast<Link*>(slab + kLinksOffset);
+			for (size_type i = 0; i < m_blocks_per_slab; ++i) {
+				::new (links + i) Link();
+			}
+			m_slabs[id].store(slab, std::memory_order::release);
+			m_slab_count.store(id + 1, std::memory_order::relaxed);
+
+			Index first = static_cast<Index>(id * m_blocks_per_slab);
+			for (size_type begin = 0; begin < m_blocks_per_slab; begin += kMagazineBlocks) {
+				size_type end = std::min(begin + kMagazineBlocks, m_blocks_per_slab);
+				for (size_type i = begin; i + 1 < end; ++i) {
+					links[i].next = static_cast<Index>(first + i + 1);
+				}
+				PushMagazine({ static_cast<Index>(first + begin), static_cast<Index>(end - begin) });
+			}
+		}
+
+	public:
+		/**
+		 * @param block_size Size of every block; rounded up to a multiple of block_alignment.
+		 * @param block_alignment Power of two no larger than kMaxBlockAlignment.
+		 */
+		BlockPool(size_type block_size, size_type block_alignment, PoolOptions options = {})
+			: m_block_size(AlignUp(std::max<size_type>(block_size, 1), block_alignment)),
+			m_options(options),
+			m_caches(new Cache[kMaxCachedThreads]) {
+			if (!std::has_single_bit(block_alignment) || block_alignment > kMaxBlockAlignment) {
+				throw std::invalid_argument("BlockPool(): block alignment must be a power of two up to 64");
+			}
+			if (!m_options.upstream) {
+				m_options.upstream = std::pmr::get_default_resource();
+			}
+
+			// Room for the header, alignment padding and at least one full magazine.
+			size_type per_block = m_block_size + sizeof(Link);
+			size_type overhead = kLinksOffset + kMaxBlockAlignment;
+			m_slab_bytes = std::max(
+				m_options.huge_pages ? kHugeSlabBytes : kSlabBytes,
+				std::bit_ceil(overhead + kMagazineBlocks * per_block)
+			);
+			m_blocks_per_slab = (m_slab_bytes - overhead) / per_block;
+			m_block_offset = AlignUp(kLinksOffset + m_blocks_per_slab * sizeof(Link), kMaxBlockAlignment);
+			assert(m_block_offset + m_blocks_per_slab * m_block_size <= m_slab_bytes);
+			assert(kMaxSlabs * m_blocks_per_slab < kNil);
+		}
+
+		BlockPool(BlockPool const&) = delete;
+		BlockPool& operator=(BlockPool const&) = delete;
+
+		~BlockPool() {
+			size_type count = m_slab_count.load(std::memory_order::acquire);
+			for (size_type id = 0; id < count; ++id) {
+				std::byte* slab = m_slabs[id].load(std::memory_order::relaxed);
+				if (reinterpret_cast<SlabHeader const*>(slab)->large_pages) {
+					FreeLargePages(slab);
+				}
+				else {
+					m_options.upstream->deallocate(slab, m_slab_bytes, m_slab_bytes);
+				}
+			}
+		}
+
+		[[nodiscard]] void* Allocate() {
+			size_type slot = CurrentThreadSlot();
+			if (slot == kMaxCachedThreads) {
+				Magazine magazine = PopMagazine();
+				if (magazine.count > 1) {
+					PushMagazine({ LinkOf(magazine.head).next, magazine.count - 1 });
+				}
+				return BlockOf(magazine.head);
+			}
+
+			Cache& cache = m_caches[slot];
+			if (cache.loaded_count == 0) {
+				if (cache.previous_count != 0) {
+					std::swap(cache.loaded, cache.previous);
+					std::swap(cache.loaded_count, cache.previous_count);
+				}
+				else {
+					Magazine magazine = PopMagazine();
+					cache.loaded = magazine.head;
+					cache.loaded_count = magazine.count;
+				}
+			}
+			Index idx = cache.loaded;
+			cache.loaded = LinkOf(idx).next;
+			--cache.loaded_count;
+			return BlockOf(idx);
+		}
+
+		void Deallocate(void* block) noexcept {
+			if (!block) {
+				return;
+			}
+			Index idx = IndexOf(block);
+			size_type slot = CurrentThreadSlot();
+			if (slot == kMaxCachedThreads) {
+				PushMagazine({ idx, 1 });
+				return;
+			}
+
+			Cache& cache = m_caches[slot];
+			if (cache.loaded_count == kMagazineBlocks) {
+				if (cache.previous_count != 0) {
+					PushMagazine({ cache.previous, cache.previous_count });
+				}
+				cache.previous = cache.loaded;
+				cache.previous_count = cache.loaded_count;
+				cache.loaded = kNil;
+				cache.loaded_count = 0;
+			}
+			LinkOf(idx).next = cache.loaded;
+			cache.loaded = idx;
+			++cache.loaded_count;
+		}
+
+		size_type BlockSize() const noexcept {
+			return m_block_size;
+		}
+
+		/// Bytes reserved from upstream or the OS so far.
+		size_type ReservedBytes() const noexcept {
+			return m_slab_count.load(std::memory_order::relaxed) * m_slab_bytes;
+		}
+	};
+
+	/**
+	 * @brief Typed front end of a BlockPool.
+	 *
+	 * @code
+	 * ObjectPool<Texture> pool;
+	 * Texture* tex = pool.New(width, height);
+	 * pool.Delete(tex);
+	 * @endcode
+	 */
+	export template <class T> class ObjectPool {
+	public:
+		static_assert(alignof(T) <= BlockPool::kMaxBlockAlignment, "ObjectPool supports alignments up to 64 bytes");
+
+	private:
+		BlockPool m_blocks;
+
+	public:
+		explicit ObjectPool(PoolOptions options = {})
+			: m_blocks(sizeof(T), alignof(T), options) {
+		}
+
+		template <class... Args>
+		[[nodiscard]] T* New(Args&&... args) {
+			void* block = m_blocks.Allocate();
+			try {
+				return ::new (block) T(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				m_blocks.Deallocate(block);
+				throw;
+			}
+		}
+
+		void Delete(T* obj) noexcept {
+			if (obj) {
+				obj->~T();
+				m_blocks.Deallocate(obj);
+			}
+		}
+
+		/// Uninitialized storage for one T.
+		[[nodiscard]] void* Allocate() {
+			return m_blocks.Allocate();
+		}
+
+		void Deallocate(void* block) noexcept {
+			m_blocks.Deallocate(block);
+		}
+	};
+
+	/**
+	 * @brief std::pmr adapter over a set of BlockPools, one per size class.
+	 *
+	 * A drop-in replacement for std::pmr::synchronized_pool_resource on hot
+	 * paths: requests up to kMaxPooledBytes are served by the smallest class
+	 * that fits their size and alignment; anything larger goes to upstream.
+	 * Calls into upstream, for slabs and for oversized requests alike, are
+	 * serialized, so a non-thread-safe upstream such as a
+	 * monotonic_buffer_resource is fine.
+	 */
+	export class PoolResource final : public std::pmr::memory_resource {
+	public:
+		using size_type = std::size_t;
+
+		static constexpr std::array<size_type, 12> kClassSizes = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024 };
+		static constexpr size_type kMaxPooledBytes = kClassSizes.back();
+
+	private:
+		static constexpr size_type kNoClass = kClassSizes.size();
+
+		/// Serializes every call into the real upstream resource.
+		class LockedUpstream final : public std::pmr::memory_resource {
+		private:
+			std::pmr::memory_resource* m_upstream;
+			std::mutex m_mutex;
+
+		public:
+			explicit LockedUpstream(std::pmr::memory_resource* upstream) noexcept
+				: m_upstream(upstream) {
+			}
+
+			std::pmr::memory_resource* Upstream() const noexcept {
+				return m_upstream;
+			}
+
+		private:
+			void* do_allocate(size_type bytes, size_type alignment) override {
+				std::lock_guard lock(m_mutex);
+				return m_upstream->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* p, size_type bytes, size_type alignment) override {
+				std::lock_guard lock(m_mutex);
+				m_upstream->deallocate(p, bytes, alignment);
+			}
+
+			bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+				return this == &other;
+			}
+		};
+
+		static constexpr size_type ClassAlignment(size_type size) noexcept {
+			return std::min(size_type{ 1 } << std::countr_zero(size), BlockPool::kMaxBlockAlignment);
+		}
+
+		static constexpr size_type ClassOf(size_type bytes, size_type alignment) noexcept {
+			for (size_type c = 0; c < kClassSizes.size(); ++c) {
+				if (kClassSizes[c] >= bytes && ClassAlignment(kClassSizes[c]) >= alignment) {
+					return c;
+				}
+			}
+			return kNoClass;
+		}
+
+		LockedUpstream m_upstream;
+		std::array<std::optional<BlockPool>, kClassSizes.size()> m_pools;
+
+		static size_type SelectClass(size_type bytes, size_type alignment) noexcept {
+			if (bytes > kMaxPooledBytes || alignment > BlockPool::kMaxBlockAlignment) {
+				return kNoClass;
+			}
+			// Class for every 16-byte step of the request size, at the minimum alignment.
+			static constexpr auto kClassOfSize = []() {
+				std::array<std::uint8_t, kMaxPooledBytes / 16 + 1> table{};
+				for (size_type i = 0; i < table.size(); ++i) {
+					table[i] = static_cast<std::uint8_t>(ClassOf(i * 16, 1));
+				}
+				return table;
+			}();
+			size_type c = kClassOfSize[(bytes + 15) / 16];
+			while (c != kNoClass && ClassAlignment(kClassSizes[c]) < alignment) {
+				++c;
+			}
+			return c;
+		}
+
+	public:
+		explicit PoolResource(PoolOptions options = {})
+			: m_upstream(options.upstream ? options.upstream : std::pmr::get_default_resource()) {
+			options.upstream = &m_upstream;
+			for (size_type c = 0; c < kClassSizes.size(); ++c) {
+				m_pools[c].emplace(kClassSizes[c], ClassAlignment(kClassSizes[c]), options);
+			}
+		}
+
+		PoolResource(PoolResource const&) = delete;
+		PoolResource& operator=(PoolResource const&) = delete;
+
+		std::pmr::memory_resource* upstream_resource() const noexcept {
+			return m_upstream.Upstream();
+		}
+
+	private:
+		void* do_allocate(size_type bytes, size_type alignment) override {
+			size_type c = SelectClass(bytes, alignment);
+			if (c == kNoClass) {
+				return m_upstream.allocate(bytes, alignment);
+			}
+			return m_pools[c]->Allocate();
+		}
+
+		void do_deallocate(void* p, size_type bytes, size_type alignment) override {
+			size_type c = SelectClass(bytes, alignment);
+			if (c == kNoClass) {
+				m_upstream.deallocate(p, bytes, alignment);
+				return;
+			}
+			m_pools[c]->Deallocate(p);
+		}
+
+		bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+}
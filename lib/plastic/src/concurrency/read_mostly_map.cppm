@@ -0,0 +1,162 @@
+// ============================================================================
+// read_mostly_map.cppm - Module interface for a copy-on-write concurrent map
+// ============================================================================
+//
+// This module provides a map for registries that are read far more often
+// than they change, such as caches of compiled state keyed by a hash.
+// Readers load the current snapshot under an EpochGuard and search it as an
+// ordinary immutable std::unordered_map. They take no lock and perform no
+// atomic read-modify-write. Writers are serialized by a mutex. Each write
+// copies the snapshot, modifies the copy, publishes it and retires the old
+// one into the epoch domain. A write therefore costs O(n), which pays off
+// only while writes are rare.
+
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.read_mostly_map;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.epoch;
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Concurrent map with lock-free reads and copy-on-write updates.
+	 *
+	 * Lookups return copies, because a reference into a snapshot is only
+	 * valid while the guard that protects it is alive. Use read() to work
+	 * on a snapshot in place.
+	 */
+	export template <class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+	class ReadMostlyMap {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using map_type = std::unordered_map<Key, Value, Hash, KeyEqual>;
+
+	private:
+		EpochDomain* m_domain;
+		std::atomic<map_type const*> m_map;
+		std::mutex m_write_mutex;
+
+		/// Publishes `next` and retires the snapshot it replaces. m_write_mutex must be held.
+		void Publish(std::unique_ptr<map_type> next) {
+			map_type const* previous = m_map.exchange(next.release(), std::memory_order::acq_rel);
+			m_domain->Retire(previous);
+		}
+
+	public:
+		explicit ReadMostlyMap(EpochDomain& domain = DefaultEpochDomain())
+			: m_domain(&domain),
+			m_map(new map_type()) {
+		}
+
+		/// No reader may be active.
+		~ReadMostlyMap() {
+			delete m_map.load(std::memory_order::relaxed);
+		}
+
+		ReadMostlyMap(ReadMostlyMap const&) = delete;
+		ReadMostlyMap& operator=(ReadMostlyMap const&) = delete;
+
+		/**
+		 * @brief Calls `fn(map_type const&)` on the current snapshot and returns its result.
+		 *
+		 * The snapshot is only guaranteed to live until `fn` returns; the
+		 * result must not refer into it.
+		 */
+		template <class Fn> decltype(auto) read(Fn&& fn) const {
+			EpochGuard guard(*m_domain);
+			return std::invoke(std::forward<Fn>(fn), *m_map.load(std::memory_order::acquire));
+		}
+
+		[[nodiscard]] std::optional<Value> find(Key const& key) const {
+			return read([&](map_type const& map) -> std::optional<Value> {
+				if (auto it = map.find(key); it != map.end()) {
+					return it->second;
+				}
+				return std::nullopt;
+			});
+		}
+
+		[[nodiscard]] bool contains(Key const& key) const {
+			return read([&](map_type const& map) {
+				return map.contains(key);
+			});
+		}
+
+		[[nodiscard]] size_type size() const {
+			return read([](map_type const& map) {
+				return map.size();
+			});
+		}
+
+		[[nodiscard]] bool empty() const {
+			return size() == 0;
+		}
+
+		/**
+		 * @brief Inserts `Value(args...)` unless `key` is present.
+		 * @return The value now stored under `key` and whether it was inserted.
+		 */
+		template <class... Args> std::pair<Value, bool> try_emplace(Key const& key, Args&&... args) {
+			std::lock_guard lock(m_write_mutex);
+			map_type const& current = *m_map.load(std::memory_order::relaxed);
+			if (auto it = current.find(key); it != current.end()) {
+				return { it->second, false };
+			}
+			auto next = std::make_unique<map_type>(current);
+			auto [it, inserted] = next->try_emplace(key, std::forward<Args>(args)...);
+			std::pair<Value, bool> result{ it->second, inserted };
+			Publish(std::move(next));
+			return result;
+		}
+
+		/// @return Whether `key` was newly inserted rather than assigned.
+		template <class V> bool insert_or_assign(Key const& key, V&& value) {
+			std::lock_guard lock(m_write_mutex);
+			auto next = std::make_unique<map_type>(*m_map.load(std::memory_order::relaxed));
+			bool inserted = next->insert_or_assign(key, std::forward<V>(value)).second;
+			Publish(std::move(next));
+			return inserted;
+		}
+
+		size_type erase(Key const& key) {
+			std::lock_guard lock(m_write_mutex);
+			map_type const& current = *m_map.load(std::memory_order::relaxed);
+			if (!current.contains(key)) {
+				return 0;
+			}
+			auto next = std::make_unique<map_type>(current);
+			next->erase(key);
+			Publish(std::move(next));
+			return 1;
+		}
+
+		/// Applies several modifications with a single copy: `fn(map_type&)`.
+		template <class Fn> void update(Fn&& fn) {
+			std::lock_guard lock(m_write_mutex);
+			auto next = std::make_unique<map_type>(*m_map.load(std::memory_order::relaxed));
+			std::invoke(std::forward<Fn>(fn), *next);
+			Publish(std::move(next));
+		}
+
+		void clear() {
+			std::lock_guard lock(m_write_mutex);
+			Publish(std::make_unique<map_type>());
+		}
+	};
+
+}
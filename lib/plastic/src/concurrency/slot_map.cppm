@@ -0,0 +1,286 @@
+// ============================================================================
+// slot_map.cppm - Module interface for generational handles over a slot map
+// ============================================================================
+//
+// This module provides SlotMap, a table of objects addressed by 32-bit
+// handles that pack a slot index with the slot's generation. Destroying an
+// object bumps the generation of its slot, so handles to it become
+// detectably stale even after the slot is reused. Handles are trivially
+// copyable integers and can be stored in large command or draw lists
+// without any reference counting.
+//
+// Slots live in fixed-size pages that never move, and each page keeps its
+// slot states, hot values and cold values in separate arrays, so a pass
+// that only touches hot data does not pull cold data into the cache. Slot
+// indices come from an IndexAllocator, so insertion and erasure are
+// lock-free except when a new page has to be allocated.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.slot_map;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.index_allocator;
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief 32-bit handle: a 20-bit slot index and a 12-bit generation.
+	 *
+	 * `Tag` only distinguishes handle kinds at compile time. Generations of
+	 * live slots are never zero, so a value-initialized handle is null and
+	 * never refers to an object.
+	 */
+	export template <class Tag> class SlotHandle {
+	public:
+		static constexpr std::uint32_t kIndexBits = 20;
+		static constexpr std::uint32_t kGenerationBits = 12;
+		static constexpr std::uint32_t kMaxSlots = std::uint32_t{ 1 } << kIndexBits;
+		static constexpr std::uint32_t kMaxGeneration = (std::uint32_t{ 1 } << kGenerationBits) - 1;
+
+	private:
+		std::uint32_t m_value = 0;
+
+	public:
+		constexpr SlotHandle() noexcept = default;
+
+		constexpr SlotHandle(std::uint32_t index, std::uint32_t generation) noexcept
+			: m_value(generation << kIndexBits | index) {
+			assert(index < kMaxSlots && generation <= kMaxGeneration);
+		}
+
+		static constexpr SlotHandle FromBits(std::uint32_t bits) noexcept {
+			SlotHandle handle;
+			handle.m_value = bits;
+			return handle;
+		}
+
+		constexpr std::uint32_t Bits() const noexcept {
+			return m_value;
+		}
+
+		constexpr std::uint32_t Index() const noexcept {
+			return m_value & (kMaxSlots - 1);
+		}
+
+		constexpr std::uint32_t Generation() const noexcept {
+			return m_value >> kIndexBits;
+		}
+
+		constexpr explicit operator bool() const noexcept {
+			return m_value != 0;
+		}
+
+		friend constexpr bool operator==(SlotHandle, SlotHandle) noexcept = default;
+		friend constexpr auto operator<=>(SlotHandle, SlotHandle) noexcept = default;
+	};
+
+	/**
+	 * @brief Generational table of `Hot` and `Cold` values.
+	 *
+	 * Insert() and Erase() may run concurrently with each other and with
+	 * lookups of other handles. Values never move, so references returned
+	 * by HotOf() and ColdOf() stay valid until their handle is erased.
+	 * Erasing a handle while another thread still uses it is a
+	 * use-after-free: HotOf() and ColdOf() assert the generation in debug
+	 * builds only, while Contains(), TryHot() and Erase() always check it.
+	 *
+	 * A slot's generation wraps after kMaxGeneration reuses, after which a
+	 * handle that is that stale can alias a newer object.
+	 */
+	export template <class Tag, class Hot, class Cold = std::monostate> class SlotMap {
+	public:
+		using Handle = SlotHandle<Tag>;
+		using size_type = std::size_t;
+
+		static constexpr size_type kPageBits = 10;
+		static constexpr size_type kPageSize = size_type{ 1 } << kPageBits;
+
+	private:
+		/// Slot state: the generation shifted left by one, with bit 0 set while the slot is live.
+		using State = std::uint32_t;
+
+		struct Page {
+			std::atomic<State> states[kPageSize] = {};
+			alignas(Hot) std::byte hot[sizeof(Hot) * kPageSize];
+			alignas(Cold) std::byte cold[sizeof(Cold) * kPageSize];
+
+			Hot* HotAt(size_type slot) noexcept {
+				return std::launder(reinterpret_cast<Hot*>(hot) + slot);
+			}
+
+			Cold* ColdAt(size_type slot) noexcept {
+				return std::launder(reinterpret_cast<Cold*>(cold) + slot);
+			}
+		};
+
+		IndexAllocator m_slots;
+		std::unique_ptr<std::atomic<Page*>[]> m_pages;
+		size_type m_page_count;
+		std::mutex m_grow_mutex;
+		std::atomic<size_type> m_size = 0;
+
+		static constexpr State LiveState(std::uint32_t generation) noexcept {
+			return generation << 1 | 1;
+		}
+
+		Page* PageOf(std::uint32_t index) const noexcept {
+			return m_pages[index >> kPageBits].load(std::memory_order::acquire);
+		}
+
+		static size_type SlotOf(std::uint32_t index) noexcept {
+			return index & (kPageSize - 1);
+		}
+
+		Page& EnsurePage(std::uint32_t index) {
+			auto& entry = m_pages[index >> kPageBits];
+			if (Page* page = entry.load(std::memory_order::acquire)) {
+				return *page;
+			}
+			std::lock_guard lock(m_grow_mutex);
+			if (Page* page = entry.load(std::memory_order::relaxed)) {
+				return *page;
+			}
+			auto* page = new Page;
+			entry.store(page, std::memory_order::release);
+			return *page;
+		}
+
+		/// The state of a live handle's slot, or nullptr if the handle is null or out of range.
+		std::atomic<State>* StateOf(Handle handle) const noexcept {
+			if (!handle || handle.Index() >= m_slots.capacity()) {
+				return nullptr;
+			}
+			Page* page = PageOf(handle.Index());
+			return page ? &page->states[SlotOf(handle.Index())] : nullptr;
+		}
+
+	public:
+		/// Creates a map for up to `capacity` live objects (at most Handle::kMaxSlots).
+		explicit SlotMap(size_type capacity = 64 * 1024)
+			: m_slots(capacity),
+			m_page_count((capacity + kPageSize - 1) / kPageSize) {
+			if (capacity > Handle::kMaxSlots) {
+				throw std::invalid_argument("SlotMap: capacity exceeds the handle index range");
+			}
+			m_pages = std::make_unique<std::atomic<Page*>[]>(m_page_count);
+		}
+
+		~SlotMap() {
+			for (size_type i = 0; i < m_page_count; ++i) {
+				Page* page = m_pages[i].load(std::memory_order::relaxed);
+				if (!page) {
+					continue;
+				}
+				for (size_type slot = 0; slot < kPageSize; ++slot) {
+					if (page->states[slot].load(std::memory_order::relaxed) & 1) {
+						std::destroy_at(page->HotAt(slot));
+						std::destroy_at(page->ColdAt(slot));
+					}
+				}
+				delete page;
+			}
+		}
+
+		SlotMap(SlotMap const&) = delete;
+		SlotMap& operator=(SlotMap const&) = delete;
+
+		/**
+		 * @brief Stores a new object and returns its handle.
+		 * @throws std::length_error if all slots are in use.
+		 */
+		Handle Insert(Hot hot, Cold cold = Cold{}) {
+			auto index = m_slots.Allocate();
+			if (!index) {
+				throw std::length_error("SlotMap is full");
+			}
+			auto slot_index = static_cast<std::uint32_t>(*index);
+			Page* page;
+			try {
+				page = &EnsurePage(slot_index);
+				std::construct_at(reinterpret_cast<Hot*>(page->hot) + SlotOf(slot_index), std::move(hot));
+				try {
+					std::construct_at(reinterpret_cast<Cold*>(page->cold) + SlotOf(slot_index), std::move(cold));
+				}
+				catch (...) {
+					std::destroy_at(page->HotAt(SlotOf(slot_index)));
+					throw;
+				}
+			}
+			catch (...) {
+				m_slots.Free(slot_index);
+				throw;
+			}
+			auto& state = page->states[SlotOf(slot_index)];
+			std::uint32_t generation = (state.load(std::memory_order::relaxed) >> 1) % Handle::kMaxGeneration + 1;
+			state.store(LiveState(generation), std::memory_order::release);
+			m_size.fetch_add(1, std::memory_order::relaxed);
+			return Handle(slot_index, generation);
+		}
+
+		/// Destroys the object of a live handle. Returns false if the handle was stale.
+		bool Erase(Handle handle) noexcept {
+			std::atomic<State>* state = StateOf(handle);
+			State expected = LiveState(handle.Generation());
+			// Only one of several racing Erase() calls for the same handle can win.
+			if (!state || !state->compare_exchange_strong(expected, expected & ~State{ 1 }, std::memory_order::acq_rel)) {
+				return false;
+			}
+			Page* page = PageOf(handle.Index());
+			std::destroy_at(page->HotAt(SlotOf(handle.Index())));
+			std::destroy_at(page->ColdAt(SlotOf(handle.Index())));
+			m_slots.Free(handle.Index());
+			m_size.fetch_sub(1, std::memory_order::relaxed);
+			return true;
+		}
+
+		[[nodiscard]] bool Contains(Handle handle) const noexcept {
+			std::atomic<State> const* state = StateOf(handle);
+			return state && state->load(std::memory_order::acquire) == LiveState(handle.Generation());
+		}
+
+		/// The hot value of a live handle; checked in debug builds only.
+		[[nodiscard]] Hot& HotOf(Handle handle) const noexcept {
+			assert(Contains(handle) && "SlotMap::HotOf(): stale or destroyed handle");
+			return *PageOf(handle.Index())->HotAt(SlotOf(handle.Index()));
+		}
+
+		/// The cold value of a live handle; checked in debug builds only.
+		[[nodiscard]] Cold& ColdOf(Handle handle) const noexcept {
+			assert(Contains(handle) && "SlotMap::ColdOf(): stale or destroyed handle");
+			return *PageOf(handle.Index())->ColdAt(SlotOf(handle.Index()));
+		}
+
+		/// The hot value of a handle, or nullptr if the handle is stale.
+		[[nodiscard]] Hot* TryHot(Handle handle) const noexcept {
+			return Contains(handle) ? PageOf(handle.Index())->HotAt(SlotOf(handle.Index())) : nullptr;
+		}
+
+		size_type size() const noexcept {
+			return m_size.load(std::memory_order::relaxed);
+		}
+
+		[[nodiscard]] bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		size_type capacity() const noexcept {
+			return m_slots.capacity();
+		}
+	};
+
+}
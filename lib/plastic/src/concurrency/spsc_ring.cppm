@@ -0,0 +1,366 @@
+// ============================================================================
+// spsc_ring.cppm - Module interface for single-producer single-consumer rings
+// ============================================================================
+//
+// This module provides bounded rings for exactly one producer thread and one
+// consumer thread, such as a command stream from the main thread to a render
+// thread. Neither side ever waits for or retries against the other: each
+// owns one index, publishes it with a release store, and keeps a private
+// copy of the other side's index that it only refreshes when the ring looks
+// full (producer) or empty (consumer). In steady state a message costs one
+// store to the slot and one store to the owned index.
+//
+// SpscRing holds elements of one type. SpscByteRing holds variable-size
+// records that are written and read in place.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.spsc_ring;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Wait-free bounded ring for one producer and one consumer thread.
+	 *
+	 * emplace_back/push_back may only be called from the producer thread and
+	 * pop_front/front/pop only from the consumer thread. All operations are
+	 * wait-free and fail instead of blocking when the ring is full or empty.
+	 *
+	 * @tparam T		The type of elements stored in the ring.
+	 * @tparam Capacity The maximum number of elements, or std::dynamic_extent
+	 *				  to choose it at construction. Rounded up to a power of two.
+	 */
+	export template <class T, std::size_t Capacity = std::dynamic_extent>
+	class SpscRing {
+	public:
+		using size_type = std::size_t;
+		using value_type = T;
+		using reference = T&;
+		using const_reference = T const&;
+		using pointer = T*;
+		using const_pointer = T const*;
+
+		static constexpr bool IsDynamic = Capacity == std::dynamic_extent;
+
+		static_assert(Capacity > size_type(0), "Capacity must be greater than 0");
+		static_assert(std::is_nothrow_destructible_v<T>, "T must be nothrow destructible");
+
+	private:
+		static constexpr size_type kCacheLine = std::hardware_destructive_interference_size;
+
+		struct Slot {
+			alignas(T) std::byte storage[sizeof(T)];
+
+			T* Get() noexcept {
+				return std::launder(reinterpret_cast<T*>(storage));
+			}
+		};
+
+		static constexpr size_type kStaticSlotCount = IsDynamic ? 0 : std::bit_ceil(Capacity);
+
+		using Storage = std::conditional_t<
+			IsDynamic,
+			std::unique_ptr<Slot[]>,
+			std::array<Slot, kStaticSlotCount>
+		>;
+
+		Storage m_slots;
+		size_type m_mask;	// slot count - 1
+
+		// Each index is written by one side only. The owner's index and its
+		// copy of the other side's index sit on separate lines, so refreshing
+		// the copy never invalidates the line the other side is polling.
+		alignas(kCacheLine) std::atomic<size_type> m_write_pos{ 0 };
+		alignas(kCacheLine) size_type m_read_pos_cache = 0;		// producer's copy
+		alignas(kCacheLine) std::atomic<size_type> m_read_pos{ 0 };
+		alignas(kCacheLine) size_type m_write_pos_cache = 0;	// consumer's copy
+
+		Slot& SlotAt(size_type pos) noexcept {
+			return m_slots[pos & m_mask];
+		}
+
+	public:
+		SpscRing() requires (!IsDynamic)
+			: m_mask(kStaticSlotCount - 1) {
+		}
+
+		explicit SpscRing(size_type capacity) requires IsDynamic
+			: m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_type>(capacity, 1)))),
+			m_mask(std::bit_ceil(std::max<size_type>(capacity, 1)) - 1) {
+		}
+
+		SpscRing(SpscRing const&) = delete;
+		SpscRing& operator=(SpscRing const&) = delete;
+
+		~SpscRing() {
+			while (pop()) {}
+		}
+
+		// Observers. Exact only on the producer or consumer thread.
+
+		bool empty() const noexcept {
+			return m_read_pos.load(std::memory_order::acquire) == m_write_pos.load(std::memory_order::acquire);
+		}
+
+		size_type size() const noexcept {
+			size_type read = m_read_pos.load(std::memory_order::acquire);
+			size_type write = m_write_pos.load(std::memory_order::acquire);
+			return write - read;
+		}
+
+		size_type capacity() const noexcept {
+			return m_mask + 1;
+		}
+
+		// Producer operations
+
+		/**
+		 * @brief Constructs an element in place at the back of the ring.
+		 * @return false if the ring is full; nothing is constructed then.
+		 */
+		template <class... Args>
+		bool emplace_back(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+			size_type pos = m_write_pos.load(std::memory_order::relaxed);
+			if (pos - m_read_pos_cache == capacity()) {
+				m_read_pos_cache = m_read_pos.load(std::memory_order::acquire);
+				if (pos - m_read_pos_cache == capacity()) {
+					return false;
+				}
+			}
+			std::construct_at(SlotAt(pos).Get(), std::forward<Args>(args)...);
+			m_write_pos.store(pos + 1, std::memory_order::release);
+			return true;
+		}
+
+		bool push_back(value_type const& val) {
+			return emplace_back(val);
+		}
+
+		bool push_back(value_type&& val) {
+			return emplace_back(std::move(val));
+		}
+
+		// Consumer operations
+
+		/// The oldest element, read in place, or nullptr if the ring is empty.
+		pointer front() noexcept {
+			size_type pos = m_read_pos.load(std::memory_order::relaxed);
+			if (pos == m_write_pos_cache) {
+				m_write_pos_cache = m_write_pos.load(std::memory_order::acquire);
+				if (pos == m_write_pos_cache) {
+					return nullptr;
+				}
+			}
+			return SlotAt(pos).Get();
+		}
+
+		/// Destroys the oldest element. Returns false if the ring is empty.
+		bool pop() noexcept {
+			pointer element = front();
+			if (!element) {
+				return false;
+			}
+			std::destroy_at(element);
+			m_read_pos.store(m_read_pos.load(std::memory_order::relaxed) + 1, std::memory_order::release);
+			return true;
+		}
+
+		std::optional<value_type> pop_front() noexcept(std::is_nothrow_move_constructible_v<T>) {
+			pointer element = front();
+			if (!element) {
+				return std::nullopt;
+			}
+			std::optional<value_type> popped(std::move(*element));
+			std::destroy_at(element);
+			m_read_pos.store(m_read_pos.load(std::memory_order::relaxed) + 1, std::memory_order::release);
+			return popped;
+		}
+	};
+
+	/**
+	 * @brief Wait-free ring of variable-size byte records for one producer and one consumer thread.
+	 *
+	 * Records are written and read in place. The producer reserves space with
+	 * write_span(), fills it, and publishes it with commit(). The consumer
+	 * gets the oldest record with read_span() and frees it with release().
+	 *
+	 * @code
+	 * // producer
+	 * if (auto span = ring.write_span(sizeof(DrawCommand)); span.data()) {
+	 *     std::construct_at(reinterpret_cast<DrawCommand*>(span.data()), ...);
+	 *     ring.commit(sizeof(DrawCommand));
+	 * }
+	 * // consumer
+	 * for (auto record = ring.read_span(); record.data(); record = ring.read_span()) {
+	 *     Execute(record);
+	 *     ring.release();
+	 * }
+	 * @endcode
+	 *
+	 * Every record starts at a multiple of kRecordAlignment behind a small
+	 * header. A record never wraps around the end of the buffer: if it does
+	 * not fit into the rest of the buffer, the producer publishes a skip
+	 * marker with it and the record starts at the beginning. Records are
+	 * capped at max_record_size(), which guarantees that a drained ring can
+	 * always take the largest record.
+	 */
+	export class SpscByteRing {
+	public:
+		using size_type = std::size_t;
+
+		static constexpr size_type kRecordAlignment = alignof(std::max_align_t);
+
+	private:
+		static constexpr size_type kCacheLine = std::hardware_destructive_interference_size;
+
+		struct Header {
+			std::uint32_t bytes;
+		};
+
+		static constexpr std::uint32_t kSkip = ~std::uint32_t{ 0 };
+		static constexpr size_type kHeaderSize = (sizeof(Header) + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+
+		struct alignas(kRecordAlignment) Chunk {
+			std::byte bytes[kRecordAlignment];
+		};
+
+		std::unique_ptr<Chunk[]> m_buffer;
+		size_type m_mask;	// buffer size in bytes - 1
+
+		// Same line split as SpscRing. The pending positions are private to
+		// their side and describe the span most recently handed out.
+		alignas(kCacheLine) std::atomic<size_type> m_write_pos{ 0 };
+		alignas(kCacheLine) size_type m_read_pos_cache = 0;
+		size_type m_pending_write = 0;	// record start after an optional skip
+		alignas(kCacheLine) std::atomic<size_type> m_read_pos{ 0 };
+		alignas(kCacheLine) size_type m_write_pos_cache = 0;
+		size_type m_pending_read = 0;	// end of the record returned by read_span()
+
+		static constexpr size_type RecordSize(size_type bytes) noexcept {
+			return (kHeaderSize + bytes + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+		}
+
+		std::byte* At(size_type pos) noexcept {
+			return reinterpret_cast<std::byte*>(m_buffer.get()) + (pos & m_mask);
+		}
+
+		Header& HeaderAt(size_type pos) noexcept {
+			return *std::launder(reinterpret_cast<Header*>(At(pos)));
+		}
+
+	public:
+		/// @param capacity Buffer size in bytes, rounded up to a power of two.
+		explicit SpscByteRing(size_type capacity)
+			: m_mask(std::bit_ceil(std::max(capacity, 4 * kRecordAlignment)) - 1) {
+			m_buffer = std::make_unique<Chunk[]>((m_mask + 1) / kRecordAlignment);
+		}
+
+		SpscByteRing(SpscByteRing const&) = delete;
+		SpscByteRing& operator=(SpscByteRing const&) = delete;
+
+		size_type capacity() const noexcept {
+			return m_mask + 1;
+		}
+
+		size_type max_record_size() const noexcept {
+			return capacity() / 2 - kHeaderSize;
+		}
+
+		bool empty() const noexcept {
+			return m_read_pos.load(std::memory_order::acquire) == m_write_pos.load(std::memory_order::acquire);
+		}
+
+		// Producer operations
+
+		/**
+		 * @brief Reserves room for a record of up to `bytes` bytes.
+		 * @return Writable, kRecordAlignment-aligned storage, or a span with a
+		 *		   null data pointer if the ring is too full. The reservation lasts until commit()
+		 *		   or the next write_span().
+		 */
+		std::span<std::byte> write_span(size_type bytes) noexcept {
+			assert(bytes <= max_record_size() && "SpscByteRing::write_span(): record too large");
+			size_type pos = m_write_pos.load(std::memory_order::relaxed);
+			size_type record = RecordSize(bytes);
+			size_type tail = capacity() - (pos & m_mask);
+			size_type start = record <= tail ? pos : pos + tail;
+			if (start + record - m_read_pos_cache > capacity()) {
+				m_read_pos_cache = m_read_pos.load(std::memory_order::acquire);
+				if (start + record - m_read_pos_cache > capacity()) {
+					return {};
+				}
+			}
+			m_pending_write = start;
+			return { At(start) + kHeaderSize, bytes };
+		}
+
+		/// Publishes the reserved record with its first `bytes` bytes.
+		void commit(size_type bytes) noexcept {
+			size_type pos = m_write_pos.load(std::memory_order::relaxed);
+			if (m_pending_write != pos) {
+				HeaderAt(pos).bytes = kSkip;
+			}
+			HeaderAt(m_pending_write).bytes = static_cast<std::uint32_t>(bytes);
+			m_write_pos.store(m_pending_write + RecordSize(bytes), std::memory_order::release);
+		}
+
+		/// Copies `record` into the ring. Returns false if it is too full.
+		bool write(std::span<std::byte const> record) noexcept {
+			std::span<std::byte> span = write_span(record.size());
+			if (!span.data()) {
+				return false;
+			}
+			std::copy(record.begin(), record.end(), span.begin());
+			commit(record.size());
+			return true;
+		}
+
+		// Consumer operations
+
+		/**
+		 * @brief The oldest record, read in place.
+		 * @return A span with a null data pointer if the ring is empty.
+		 *		   The record stays valid until release().
+		 */
+		std::span<std::byte> read_span() noexcept {
+			size_type pos = m_read_pos.load(std::memory_order::relaxed);
+			if (pos == m_write_pos_cache) {
+				m_write_pos_cache = m_write_pos.load(std::memory_order::acquire);
+				if (pos == m_write_pos_cache) {
+					return {};
+				}
+			}
+			if (HeaderAt(pos).bytes == kSkip) {
+				// A skip is always published together with the record after it.
+				pos += capacity() - (pos & m_mask);
+			}
+			size_type bytes = HeaderAt(pos).bytes;
+			m_pending_read = pos + RecordSize(bytes);
+			return { At(pos) + kHeaderSize, bytes };
+		}
+
+		/// Frees the record returned by the last read_span().
+		void release() noexcept {
+			m_read_pos.store(m_pending_read, std::memory_order::release);
+		}
+	};
+
+}
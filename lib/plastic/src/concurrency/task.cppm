@@ -0,0 +1,829 @@
+// ============================================================================
+// task.cppm - Module interface for lazy coroutine tasks
+// ============================================================================
+//
+// This module provides Task<T>, a lazily started coroutine that can await
+// other tasks. Awaiting a task starts it and suspends the caller; when the
+// task finishes it resumes the caller through symmetric transfer, so chains
+// of any depth run without growing the stack. Frames come from a
+// thread-local pool and completion is tracked in the promise itself, so an
+// await costs no heap allocation once the pool is warm.
+//
+// WhenAll and WhenAny start several tasks at once, and SyncWait bridges
+// into ordinary code. A task can be bound to an executor with Via() or
+// ResumeOn(); it then always runs there and resumes its caller on the
+// caller's executor.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <semaphore>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.task;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief Thread-local free lists of coroutine frames, bucketed by size.
+	 *
+	 * Frames are rounded up to a multiple of kGranularity. A frame may be
+	 * released on a different thread than the one that allocated it; it then
+	 * joins the releasing thread's lists. Frames larger than the biggest size
+	 * class, and frames released to a full list, go to the global heap.
+	 */
+	class FramePool {
+	private:
+		static constexpr std::size_t kGranularity = 64;
+		static constexpr std::size_t kClassCount = 16;	// frames up to 1 KiB are pooled
+		static constexpr std::size_t kMaxCached = 64;	// per size class
+
+		struct Node {
+			Node* next;
+		};
+
+		struct Bucket {
+			Node* head = nullptr;
+			std::size_t count = 0;
+		};
+
+		std::array<Bucket, kClassCount> m_buckets{};
+
+		static constexpr std::size_t ClassOf(std::size_t size) noexcept {
+			return (size - 1) / kGranularity;
+		}
+
+		static constexpr std::size_t ClassSize(std::size_t cls) noexcept {
+			return (cls + 1) * kGranularity;
+		}
+
+		FramePool() noexcept = default;
+
+	public:
+		FramePool(FramePool const&) = delete;
+		FramePool& operator=(FramePool const&) = delete;
+
+		~FramePool() noexcept {
+			for (std::size_t cls = 0; cls < kClassCount; ++cls) {
+				Node* node = m_buckets[cls].head;
+				while (node) {
+					Node* next = node->next;
+					::operator delete(node, ClassSize(cls));
+					node = next;
+				}
+			}
+		}
+
+		static FramePool& Local() noexcept {
+			thread_local FramePool pool;
+			return pool;
+		}
+
+		void* Allocate(std::size_t size) {
+			std::size_t cls = ClassOf(size);
+			if (cls >= kClassCount) {
+				return ::operator new(size);
+			}
+			Bucket& bucket = m_buckets[cls];
+			if (bucket.head) {
+				Node* node = bucket.head;
+				bucket.head = node->next;
+				--bucket.count;
+				return node;
+			}
+			return ::operator new(ClassSize(cls));
+		}
+
+		void Deallocate(void* ptr, std::size_t size) noexcept {
+			std::size_t cls = ClassOf(size);
+			if (cls >= kClassCount) {
+				::operator delete(ptr, size);
+				return;
+			}
+			Bucket& bucket = m_buckets[cls];
+			if (bucket.count >= kMaxCached) {
+				::operator delete(ptr, ClassSize(cls));
+				return;
+			}
+			bucket.head = ::new (ptr) Node{ bucket.head };
+			++bucket.count;
+		}
+	};
+
+	/// Anything that can run a suspended coroutine, typically on another thread.
+	export template <class E>
+	concept Executor = requires(E & executor, std::coroutine_handle<> handle) {
+		executor.Post(handle);
+	};
+
+	/// Non-owning, type-erased reference to an Executor. An empty reference means "run inline".
+	export class ExecutorRef {
+	private:
+		void* m_self = nullptr;
+		void (*m_post)(void*, std::coroutine_handle<>) = nullptr;
+
+	public:
+		constexpr ExecutorRef() noexcept = default;
+
+		template <Executor E>
+			requires (!std::same_as<std::remove_cv_t<E>, ExecutorRef>)
+		ExecutorRef(E& executor) noexcept
+			: m_self(std::addressof(executor)),
+			m_post([](void* self, std::coroutine_handle<> handle) { static_cast<E*>(self)->Post(handle); }) {
+
+		}
+
+		explicit operator bool() const noexcept {
+			return m_self != nullptr;
+		}
+
+		void Post(std::coroutine_handle<> handle) const {
+			m_post(m_self, handle);
+		}
+
+		friend bool operator==(ExecutorRef const& lhs, ExecutorRef const& rhs) noexcept {
+			return lhs.m_self == rhs.m_self;
+		}
+	};
+
+	/**
+	 * @brief State shared by every promise in this module.
+	 *
+	 * Holds the awaiting coroutine, the executor this coroutine is bound to
+	 * and the executor the awaiting coroutine expects to be resumed on.
+	 */
+	class PromiseBase {
+	private:
+		std::coroutine_handle<> m_continuation;
+		ExecutorRef m_executor;
+		ExecutorRef m_continuation_executor;
+
+	public:
+		struct FinalAwaiter {
+			static constexpr bool await_ready() noexcept {
+				return false;
+			}
+
+			template <std::derived_from<PromiseBase> Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+				return self.promise().Continue();
+			}
+
+			static constexpr void await_resume() noexcept {
+
+			}
+		};
+
+		static void* operator new(std::size_t size) {
+			return FramePool::Local().Allocate(size);
+		}
+
+		static void operator delete(void* ptr, std::size_t size) noexcept {
+			FramePool::Local().Deallocate(ptr, size);
+		}
+
+		static constexpr std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+
+		static constexpr FinalAwaiter final_suspend() noexcept {
+			return {};
+		}
+
+		ExecutorRef GetExecutor() const noexcept {
+			return m_executor;
+		}
+
+		void SetExecutor(ExecutorRef executor) noexcept {
+			m_executor = executor;
+		}
+
+		/**
+		 * @brief Records the awaiting coroutine and returns what to resume next.
+		 *
+		 * An unbound coroutine inherits the caller's executor and is entered
+		 * by symmetric transfer; one bound elsewhere is posted to its executor.
+		 */
+		std::coroutine_handle<> Start(std::coroutine_handle<> self, std::coroutine_handle<> continuation, ExecutorRef caller) {
+			m_continuation = continuation;
+			m_continuation_executor = caller;
+			if (!m_executor) {
+				m_executor = caller;
+			}
+			if (m_executor != caller) {
+				m_executor.Post(self);
+				return std::noop_coroutine();
+			}
+			return self;
+		}
+
+		std::coroutine_handle<> Continue() noexcept {
+			if (!m_continuation) {
+				return std::noop_coroutine();
+			}
+			if (m_continuation_executor && m_continuation_executor != m_executor) {
+				m_continuation_executor.Post(m_continuation);
+				return std::noop_coroutine();
+			}
+			return m_continuation;
+		}
+	};
+
+	template <class Promise>
+	ExecutorRef ExecutorOf(std::coroutine_handle<Promise> handle) noexcept {
+		if constexpr (std::derived_from<Promise, PromiseBase>) {
+			return handle.promise().GetExecutor();
+		}
+		else {
+			return {};
+		}
+	}
+
+	export template <class T = void> class Task;
+
+	template <class T> class TaskPromise final : public PromiseBase {
+	public:
+		static_assert(!std::is_reference_v<T>, "Task<T&> is not supported; return a pointer instead");
+
+	private:
+		std::variant<std::monostate, T, std::exception_ptr> m_result;
+
+	public:
+		Task<T> get_return_object() noexcept;
+
+		template <std::convertible_to<T> U>
+		void return_value(U&& val) {
+			m_result.template emplace<1>(std::forward<U>(val));
+		}
+
+		void unhandled_exception() noexcept {
+			m_result.template emplace<2>(std::current_exception());
+		}
+
+		T& Result() & {
+			if (m_result.index() == 2) {
+				std::rethrow_exception(*std::get_if<2>(&m_result));
+			}
+			assert(m_result.index() == 1 && "Task::Result(): task has not completed");
+			return *std::get_if<1>(&m_result);
+		}
+
+		T Result() && {
+			return std::move(Result());
+		}
+	};
+
+	template <> class TaskPromise<void> final : public PromiseBase {
+	private:
+		std::exception_ptr m_exception;
+
+	public:
+		Task<void> get_return_object() noexcept;
+
+		static constexpr void return_void() noexcept {
+
+		}
+
+		void unhandled_exception() noexcept {
+			m_exception = std::current_exception();
+		}
+
+		void Result() const {
+			if (m_exception) {
+				std::rethrow_exception(m_exception);
+			}
+		}
+	};
+
+	/**
+	 * @brief Lazily started coroutine producing a T.
+	 *
+	 * The body does not run until the task is awaited (or passed to
+	 * WhenAll, WhenAny or SyncWait). Awaiting an rvalue task yields the value;
+	 * awaiting an lvalue yields a reference into the finished task. An
+	 * exception escaping the body is rethrown to the awaiting coroutine.
+	 *
+	 * @tparam T Result type, or void.
+	 */
+	export template <class T> class [[nodiscard]] Task {
+	public:
+		using promise_type = TaskPromise<T>;
+		using value_type = T;
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;
+
+		struct AwaiterBase {
+			std::coroutine_handle<promise_type> handle;
+
+			bool await_ready() const noexcept {
+				assert(handle && "Task: awaiting an empty task");
+				return handle.done();
+			}
+
+			template <class Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> caller) {
+				return handle.promise().Start(handle, caller, ExecutorOf(caller));
+			}
+		};
+
+		explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+			: m_handle(handle) {
+
+		}
+
+		friend promise_type;
+
+	public:
+		Task() noexcept = default;
+
+		Task(Task const&) = delete;
+		Task& operator=(Task const&) = delete;
+
+		Task(Task&& other) noexcept
+			: m_handle(std::exchange(other.m_handle, nullptr)) {
+
+		}
+
+		Task& operator=(Task&& other) noexcept {
+			if (this != &other) {
+				if (m_handle) {
+					m_handle.destroy();
+				}
+				m_handle = std::exchange(other.m_handle, nullptr);
+			}
+			return *this;
+		}
+
+		~Task() noexcept {
+			if (m_handle) {
+				m_handle.destroy();
+			}
+		}
+
+		explicit operator bool() const noexcept {
+			return static_cast<bool>(m_handle);
+		}
+
+		bool IsDone() const noexcept {
+			return m_handle && m_handle.done();
+		}
+
+		/// Binds the task to an executor. Must be called before the task is started.
+		Task& Via(ExecutorRef executor) & noexcept {
+			assert(m_handle && "Task::Via(): empty task");
+			m_handle.promise().SetExecutor(executor);
+			return *this;
+		}
+
+		Task&& Via(ExecutorRef executor) && noexcept {
+			return std::move(Via(executor));
+		}
+
+		/// The result of a finished task. Rethrows the exception the body exited with.
+		decltype(auto) Result() & {
+			assert(IsDone() && "Task::Result(): task has not completed");
+			return m_handle.promise().Result();
+		}
+
+		decltype(auto) Result() && {
+			assert(IsDone() && "Task::Result(): task has not completed");
+			return std::move(m_handle.promise()).Result();
+		}
+
+		auto operator co_await() & noexcept {
+			struct Awaiter : AwaiterBase {
+				decltype(auto) await_resume() {
+					return this->handle.promise().Result();
+				}
+			};
+			return Awaiter{ { m_handle } };
+		}
+
+		auto operator co_await() && noexcept {
+			struct Awaiter : AwaiterBase {
+				decltype(auto) await_resume() {
+					return std::move(this->handle.promise()).Result();
+				}
+			};
+			return Awaiter{ { m_handle } };
+		}
+
+		/// Awaits completion without fetching the result or rethrowing.
+		auto WhenReady() noexcept {
+			struct Awaiter : AwaiterBase {
+				static constexpr void await_resume() noexcept {
+
+				}
+			};
+			return Awaiter{ { m_handle } };
+		}
+	};
+
+	template <class T>
+	Task<T> TaskPromise<T>::get_return_object() noexcept {
+		return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+		return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+	/// Awaitable that moves the current coroutine onto an executor and binds it there.
+	export class ResumeOn {
+	private:
+		ExecutorRef m_executor;
+
+	public:
+		explicit ResumeOn(ExecutorRef executor) noexcept
+			: m_executor(executor) {
+			assert(executor && "ResumeOn: empty executor");
+		}
+
+		static constexpr bool await_ready() noexcept {
+			return false;
+		}
+
+		template <class Promise>
+		void await_suspend(std::coroutine_handle<Promise> caller) {
+			if constexpr (std::derived_from<Promise, PromiseBase>) {
+				caller.promise().SetExecutor(m_executor);
+			}
+			m_executor.Post(caller);
+		}
+
+		static constexpr void await_resume() noexcept {
+
+		}
+	};
+
+	/**
+	 * @brief Fire-and-forget coroutine that watches one task.
+	 *
+	 * Once started it awaits the task, calls the notify callback and destroys
+	 * its own frame, resuming whatever coroutine the callback returned.
+	 */
+	class Notifier {
+	public:
+		using Notify = std::coroutine_handle<> (*)(void*) noexcept;
+
+		struct promise_type : PromiseBase {
+			Notify notify = nullptr;
+			void* context = nullptr;
+
+			struct FinalAwaiter {
+				static constexpr bool await_ready() noexcept {
+					return false;
+				}
+
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+					std::coroutine_handle<> next = self.promise().notify(self.promise().context);
+					self.destroy();
+					return next;
+				}
+
+				static constexpr void await_resume() noexcept {
+
+				}
+			};
+
+			Notifier get_return_object() noexcept {
+				return Notifier(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			static constexpr FinalAwaiter final_suspend() noexcept {
+				return {};
+			}
+
+			static constexpr void return_void() noexcept {
+
+			}
+
+			[[noreturn]] static void unhandled_exception() noexcept {
+				std::terminate();
+			}
+		};
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;
+
+		explicit Notifier(std::coroutine_handle<promise_type> handle) noexcept
+			: m_handle(handle) {
+
+		}
+
+	public:
+		Notifier(Notifier&& other) noexcept
+			: m_handle(std::exchange(other.m_handle, nullptr)) {
+
+		}
+
+		Notifier& operator=(Notifier&&) = delete;
+
+		~Notifier() noexcept {
+			if (m_handle) {
+				m_handle.destroy();
+			}
+		}
+
+		/// Runs the watcher; the frame owns itself from here on.
+		void Start(Notify notify, void* context, ExecutorRef executor) noexcept {
+			promise_type& promise = m_handle.promise();
+			promise.notify = notify;
+			promise.context = context;
+			promise.SetExecutor(executor);
+			std::exchange(m_handle, nullptr).resume();
+		}
+	};
+
+	template <class T>
+	Notifier Watch(Task<T>& task) {
+		co_await task.WhenReady();
+	}
+
+	template <class T>
+	using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+	template <class T>
+	NonVoid<T> TakeResult(Task<T>& task) {
+		if constexpr (std::is_void_v<T>) {
+			task.Result();
+			return {};
+		}
+		else {
+			return std::move(task).Result();
+		}
+	}
+
+	/// Counts finished watchers; the one that brings it to zero resumes the waiter.
+	class WhenAllCounter {
+	private:
+		std::atomic<std::size_t> m_count;
+		std::coroutine_handle<> m_waiter;
+
+	public:
+		/// One reference per watcher plus one held by the waiter until it has started them all.
+		explicit WhenAllCounter(std::size_t count) noexcept
+			: m_count(count + 1) {
+
+		}
+
+		static std::coroutine_handle<> Arrive(void* self) noexcept {
+			WhenAllCounter* counter = static_cast<WhenAllCounter*>(self);
+			if (counter->m_count.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+				return counter->m_waiter;
+			}
+			return std::noop_coroutine();
+		}
+
+		/// Starts the watchers and suspends the waiter until the last one arrives.
+		class Awaiter {
+		private:
+			WhenAllCounter& m_counter;
+			std::span<Notifier> m_notifiers;
+
+		public:
+			Awaiter(WhenAllCounter& counter, std::span<Notifier> notifiers) noexcept
+				: m_counter(counter),
+				m_notifiers(notifiers) {
+
+			}
+
+			bool await_ready() const noexcept {
+				return m_notifiers.empty();
+			}
+
+			template <class Promise>
+			bool await_suspend(std::coroutine_handle<Promise> waiter) noexcept {
+				ExecutorRef executor = ExecutorOf(waiter);
+				m_counter.m_waiter = waiter;
+				for (Notifier& notifier : m_notifiers) {
+					notifier.Start(&WhenAllCounter::Arrive, &m_counter, executor);
+				}
+				// Drop the waiter's reference; if every task already finished, keep running.
+				return m_counter.m_count.fetch_sub(1, std::memory_order::acq_rel) > 1;
+			}
+
+			static constexpr void await_resume() noexcept {
+
+			}
+		};
+
+		Awaiter Wait(std::span<Notifier> notifiers) noexcept {
+			return Awaiter(*this, notifiers);
+		}
+	};
+
+	/**
+	 * @brief Runs every task concurrently and completes when all have finished.
+	 *
+	 * void results become std::monostate. If any task throws, the exception of
+	 * the leftmost failed task is rethrown after all of them have finished.
+	 */
+	export template <class... Ts>
+	Task<std::tuple<NonVoid<Ts>...>> WhenAll(Task<Ts>... tasks) {
+		WhenAllCounter counter(sizeof...(Ts));
+		std::array<Notifier, sizeof...(Ts)> notifiers{ Watch(tasks)... };
+		co_await counter.Wait(notifiers);
+		co_return std::tuple<NonVoid<Ts>...>{ TakeResult(tasks)... };
+	}
+
+	/// Runs a dynamic number of tasks concurrently and collects their results in order.
+	export template <class T>
+	Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> WhenAll(std::vector<Task<T>> tasks) {
+		WhenAllCounter counter(tasks.size());
+		std::vector<Notifier> notifiers;
+		notifiers.reserve(tasks.size());
+		for (Task<T>& task : tasks) {
+			notifiers.push_back(Watch(task));
+		}
+		co_await counter.Wait(notifiers);
+		if constexpr (std::is_void_v<T>) {
+			for (Task<T>& task : tasks) {
+				task.Result();
+			}
+		}
+		else {
+			std::vector<T> results;
+			results.reserve(tasks.size());
+			for (Task<T>& task : tasks) {
+				results.push_back(std::move(task).Result());
+			}
+			co_return results;
+		}
+	}
+
+	export template <class T> struct WhenAnyResult {
+		std::size_t index;
+		T value;
+	};
+
+	/**
+	 * @brief Tasks raced by WhenAny.
+	 *
+	 * The losers keep running after the winner is reported, so the state is
+	 * reference counted: one reference per started watcher and one for the
+	 * waiting coroutine. The last release deletes it.
+	 */
+	template <class T> class WhenAnyState {
+	private:
+		struct Slot {
+			WhenAnyState* state;
+			std::size_t index;
+		};
+
+		std::vector<Task<T>> m_tasks;
+		std::vector<Slot> m_slots;
+		std::atomic<std::size_t> m_refs{ 1 };
+		std::atomic<bool> m_decided{ false };
+		std::atomic<std::size_t> m_gate{ 2 };	// the winner and the starting waiter
+		std::size_t m_winner = 0;
+		std::coroutine_handle<> m_waiter;
+
+		static std::coroutine_handle<> Arrive(void* context) noexcept {
+			Slot* slot = static_cast<Slot*>(context);
+			WhenAnyState* state = slot->state;
+			std::coroutine_handle<> next = std::noop_coroutine();
+			if (!state->m_decided.exchange(true, std::memory_order::acq_rel)) {
+				state->m_winner = slot->index;
+				if (state->m_gate.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+					next = state->m_waiter;
+				}
+			}
+			state->Release();
+			return next;
+		}
+
+	public:
+		explicit WhenAnyState(std::vector<Task<T>> tasks)
+			: m_tasks(std::move(tasks)) {
+			m_slots.reserve(m_tasks.size());
+			for (std::size_t i = 0; i < m_tasks.size(); ++i) {
+				m_slots.push_back(Slot{ this, i });
+			}
+		}
+
+		void Release() noexcept {
+			if (m_refs.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+				delete this;
+			}
+		}
+
+		std::size_t Winner() const noexcept {
+			return m_winner;
+		}
+
+		Task<T>& WinningTask() noexcept {
+			return m_tasks[m_winner];
+		}
+
+		/// Starts a watcher per task and suspends the waiter until one of them wins.
+		class Awaiter {
+		private:
+			WhenAnyState& m_state;
+			std::vector<Notifier> m_notifiers;
+
+		public:
+			explicit Awaiter(WhenAnyState& state) noexcept
+				: m_state(state) {
+
+			}
+
+			static constexpr bool await_ready() noexcept {
+				return false;
+			}
+
+			template <class Promise>
+			bool await_suspend(std::coroutine_handle<Promise> waiter) {
+				// Create every watcher first so a failed allocation leaves nothing running.
+				m_notifiers.reserve(m_state.m_tasks.size());
+				for (Task<T>& task : m_state.m_tasks) {
+					m_notifiers.push_back(Watch(task));
+				}
+				ExecutorRef executor = ExecutorOf(waiter);
+				m_state.m_waiter = waiter;
+				m_state.m_refs.fetch_add(m_notifiers.size(), std::memory_order::relaxed);
+				for (std::size_t i = 0; i < m_notifiers.size(); ++i) {
+					m_notifiers[i].Start(&WhenAnyState::Arrive, &m_state.m_slots[i], executor);
+				}
+				return m_state.m_gate.fetch_sub(1, std::memory_order::acq_rel) > 1;
+			}
+
+			static constexpr void await_resume() noexcept {
+
+			}
+		};
+
+		Awaiter Wait() noexcept {
+			return Awaiter(*this);
+		}
+	};
+
+	template <class T> struct WhenAnyRelease {
+		WhenAnyState<T>* state;
+
+		~WhenAnyRelease() noexcept {
+			state->Release();
+		}
+	};
+
+	/**
+	 * @brief Runs the tasks concurrently and completes with the first to finish.
+	 *
+	 * The remaining tasks are not cancelled; they run to completion in the
+	 * background and their results are discarded.
+	 * @return The index of the winner, plus its value for non-void T.
+	 * @throws std::invalid_argument if `tasks` is empty.
+	 */
+	export template <class T>
+	Task<std::conditional_t<std::is_void_v<T>, std::size_t, WhenAnyResult<T>>> WhenAny(std::vector<Task<T>> tasks) {
+		if (tasks.empty()) {
+			throw std::invalid_argument("WhenAny(): no tasks to wait for");
+		}
+		WhenAnyState<T>* state = new WhenAnyState<T>(std::move(tasks));
+		WhenAnyRelease<T> release{ state };
+		co_await state->Wait();
+		if constexpr (std::is_void_v<T>) {
+			state->WinningTask().Result();
+			co_return state->Winner();
+		}
+		else {
+			co_return WhenAnyResult<T>{ state->Winner(), std::move(state->WinningTask()).Result() };
+		}
+	}
+
+	/// Starts the task and blocks the calling thread until it finishes.
+	export template <class T>
+	T SyncWait(Task<T> task) {
+		std::binary_semaphore done(0);
+		Watch(task).Start(
+			[](void* context) noexcept -> std::coroutine_handle<> {
+				static_cast<std::binary_semaphore*>(context)->release();
+				return std::noop_coroutine();
+			},
+			&done,
+			{}
+		);
+		done.acquire();
+		return std::move(task).Result();
+	}
+
+} // namespace plastic::concurrency
@@ -0,0 +1,85 @@
+// ============================================================================
+// thread_slot.cppm - Module interface for dense per-thread indices
+// ============================================================================
+//
+// This module hands every thread a small dense index for per-thread arrays
+// (the magazine caches of ObjectPool, the reader slots of EpochDomain). The
+// index is taken on first use and returned when the thread exits, so a later
+// thread may reuse it. Threads beyond kMaxThreadSlots, and threads that are
+// already tearing down their thread_locals, get kMaxThreadSlots and have to
+// take the shared path of whatever they index.
+
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <optional>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.thread_slot;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.index_allocator;
+
+namespace plastic::concurrency {
+
+	export constexpr std::size_t kMaxThreadSlots = 128;
+
+}
+
+namespace {
+
+	// Set once the thread's slot is destroyed. A trivially destructible
+	// thread_local stays readable while the other ones are destroyed.
+	thread_local bool t_slot_released = false;
+
+	plastic::concurrency::IndexAllocator& ThreadSlots() {
+		// Never destroyed: detached threads may exit after static destruction.
+		static auto* slots = new plastic::concurrency::IndexAllocator(plastic::concurrency::kMaxThreadSlots);
+		return *slots;
+	}
+
+	class ThreadSlot {
+	private:
+		std::size_t m_index;
+
+	public:
+		ThreadSlot()
+			: m_index(ThreadSlots().Allocate().value_or(plastic::concurrency::kMaxThreadSlots)) {
+		}
+
+		~ThreadSlot() {
+			t_slot_released = true;
+			if (m_index < plastic::concurrency::kMaxThreadSlots) {
+				ThreadSlots().Free(m_index);
+			}
+		}
+
+		ThreadSlot(ThreadSlot const&) = delete;
+		ThreadSlot& operator=(ThreadSlot const&) = delete;
+
+		std::size_t Index() const noexcept {
+			return m_index;
+		}
+	};
+
+}
+
+namespace plastic::concurrency {
+
+	/**
+	 * @brief The calling thread's dense index, or kMaxThreadSlots if it has none.
+	 *
+	 * Once the thread's slot has been destroyed during thread exit, its index
+	 * may already belong to another thread, so thread_locals destroyed after
+	 * it get kMaxThreadSlots as well.
+	 */
+	export std::size_t CurrentThreadSlot() {
+		if (t_slot_released) {
+			return kMaxThreadSlots;
+		}
+		thread_local ThreadSlot slot;
+		return slot.Index();
+	}
+
+}
@@ -0,0 +1,478 @@
+// ============================================================================
+// timer_wheel.cppm - Module interface for a hierarchical timing wheel
+// ============================================================================
+//
+// This module schedules deferred and periodic callbacks: cache eviction,
+// asset write-back, telemetry snapshots. Timers hash into a wheel of four
+// levels with 64 slots each. Level 0 slots are one tick apart, and every
+// level above is 64 times coarser. Scheduling and cancelling are O(1): a
+// timer is linked into one slot's intrusive list, and its handle carries a
+// generation so stale handles are harmless. When the lower levels wrap,
+// the next slot of the level above is cascaded down. Each timer therefore
+// moves at most three times before it fires.
+//
+// A TimerWheel is driven by whoever calls Advance(), for example a frame
+// loop. TimerThread owns a wheel and a thread that sleeps until the next
+// deadline. Due callbacks are handed to an executor, which runs them
+// inline by default. An exception thrown by a callback (or the executor) is
+// passed to an error handler and the remaining callbacks still run, so one
+// bad timer cannot take down the thread that drives the wheel.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.timer_wheel;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.inplace_function;
+
+namespace plastic::concurrency {
+
+	export using TimerCallback = plastic::ds::InplaceFunction<void(), 6 * sizeof(void*)>;
+
+	/// Runs a due callback; for example by submitting it to a job system.
+	export using TimerExecutor = plastic::ds::InplaceFunction<void(TimerCallback)>;
+
+	/// Receives what a callback threw; must not throw itself.
+	export using TimerErrorHandler = plastic::ds::InplaceFunction<void(std::exception_ptr)>;
+
+	/// Handle of a scheduled timer. Default-constructed handles refer to no timer.
+	export struct TimerId {
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+
+		friend bool operator==(TimerId const&, TimerId const&) = default;
+	};
+
+	/**
+	 * @brief Hierarchical timing wheel.
+	 *
+	 * Schedule and Cancel may be called from any thread, including from a
+	 * callback. Advance() must only be called by one thread at a time.
+	 */
+	export class TimerWheel {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t kLevels = 4;
+		static constexpr std::size_t kSlotBits = 6;
+		static constexpr std::size_t kSlots = std::size_t{ 1 } << kSlotBits;
+
+	private:
+		static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::uint64_t kSlotMask = kSlots - 1;
+		/// Ticks the wheel spans; later timers wait in the last slot and are re-hashed when it cascades.
+		static constexpr std::uint64_t kRange = std::uint64_t{ 1 } << (kSlotBits * kLevels);
+
+		struct Timer {
+			TimerCallback callback;
+			std::uint64_t expiry = 0;		// tick
+			std::uint64_t period = 0;		// ticks, 0 for one-shot timers
+			std::uint32_t prev = kNone;
+			std::uint32_t next = kNone;		// next timer in the slot, or in the free list
+			std::uint32_t slot = kNone;		// level * kSlots + index while scheduled
+			std::uint32_t generation = 0;
+		};
+
+		Clock::duration m_tick;
+		Clock::time_point m_origin;
+		TimerExecutor m_executor;
+		TimerErrorHandler m_on_error;
+
+		mutable std::mutex m_mutex;
+		std::uint64_t m_now = 0;			// last processed tick
+		std::vector<Timer> m_timers;
+		std::uint32_t m_free = kNone;
+		std::array<std::uint32_t, kLevels * kSlots> m_heads;
+		std::array<std::uint64_t, kLevels> m_occupied{};	// one bit per non-empty slot
+		std::size_t m_count = 0;
+
+		std::vector<TimerCallback> m_due;	// only touched by the thread in Advance()
+
+		/// First tick that is not earlier than `time`.
+		std::uint64_t TickAtOrAfter(Clock::time_point time) const noexcept {
+			if (time <= m_origin) {
+				return 0;
+			}
+			return static_cast<std::uint64_t>((time - m_origin + m_tick - Clock::duration(1)) / m_tick);
+		}
+
+		/// Last tick that is not later than `time`.
+		std::uint64_t TickAtOrBefore(Clock::time_point time) const noexcept {
+			if (time <= m_origin) {
+				return 0;
+			}
+			return static_cast<std::uint64_t>((time - m_origin) / m_tick);
+		}
+
+		std::uint64_t TicksOf(Clock::duration duration) const noexcept {
+			if (duration <= Clock::duration::zero()) {
+				return 0;
+			}
+			return static_cast<std::uint64_t>((duration + m_tick - Clock::duration(1)) / m_tick);
+		}
+
+		std::uint32_t AllocateTimer() {
+			if (m_free != kNone) {
+				std::uint32_t index = m_free;
+				m_free = m_timers[index].next;
+				return index;
+			}
+			m_timers.emplace_back();
+			return static_cast<std::uint32_t>(m_timers.size() - 1);
+		}
+
+		void FreeTimer(std::uint32_t index) noexcept {
+			Timer& timer = m_timers[index];
+			timer.callback = nullptr;
+			++timer.generation;
+			timer.next = m_free;
+			m_free = index;
+		}
+
+		/// Links a timer into the slot for its expiry, which must not lie before m_now.
+		void Link(std::uint32_t index) noexcept {
+			Timer& timer = m_timers[index];
+			std::uint64_t expiry = std::min(timer.expiry, m_now + kRange - 1);
+			std::uint64_t delta = expiry - m_now;
+			std::size_t level = 0;
+			while (level + 1 < kLevels && delta >= (std::uint64_t{ 1 } << (kSlotBits * (level + 1)))) {
+				++level;
+			}
+			auto slot = static_cast<std::uint32_t>(level * kSlots + ((expiry >> (kSlotBits * level)) & kSlotMask));
+
+			timer.slot = slot;
+			timer.prev = kNone;
+			timer.next = m_heads[slot];
+			if (timer.next != kNone) {
+				m_timers[timer.next].prev = index;
+			}
+			m_heads[slot] = index;
+			m_occupied[level] |= std::uint64_t{ 1 } << (slot & kSlotMask);
+		}
+
+		void Unlink(std::uint32_t index) noexcept {
+			Timer& timer = m_timers[index];
+			if (timer.prev != kNone) {
+				m_timers[timer.prev].next = timer.next;
+			}
+			else {
+				m_heads[timer.slot] = timer.next;
+				if (timer.next == kNone) {
+					m_occupied[timer.slot / kSlots] &= ~(std::uint64_t{ 1 } << (timer.slot & kSlotMask));
+				}
+			}
+			if (timer.next != kNone) {
+				m_timers[timer.next].prev = timer.prev;
+			}
+			timer.slot = kNone;
+		}
+
+		/// Detaches a whole slot and returns its first timer.
+		std::uint32_t TakeSlot(std::size_t level, std::size_t index) noexcept {
+			std::size_t slot = level * kSlots + index;
+			std::uint32_t head = std::exchange(m_heads[slot], kNone);
+			m_occupied[level] &= ~(std::uint64_t{ 1 } << index);
+			return head;
+		}
+
+		/// Re-hashes the slot of `level` that m_now has just entered.
+		void Cascade(std::size_t level) noexcept {
+			std::uint32_t index = TakeSlot(level, (m_now >> (kSlotBits * level)) & kSlotMask);
+			while (index != kNone) {
+				std::uint32_t next = m_timers[index].next;
+				Link(index);
+				index = next;
+			}
+		}
+
+		/// First tick after m_now at which a slot of `level` fires or cascades, if any is occupied.
+		std::optional<std::uint64_t> NextEventOf(std::size_t level) const noexcept {
+			if (m_occupied[level] == 0) {
+				return std::nullopt;
+			}
+			std::size_t shift = kSlotBits * level;
+			std::uint64_t position = m_now >> shift;
+			auto current = static_cast<int>(position & kSlotMask);
+			// Slot current + 1 comes first; the current slot itself is a full turn away.
+			int offset = std::countr_zero(std::rotr(m_occupied[level], (current + 1) & static_cast<int>(kSlotMask))) + 1;
+			return (position + static_cast<std::uint64_t>(offset)) << shift;
+		}
+
+		std::optional<std::uint64_t> NextEvent() const noexcept {
+			std::optional<std::uint64_t> next;
+			for (std::size_t level = 0; level < kLevels; ++level) {
+				auto event = NextEventOf(level);
+				if (event && (!next || *event < *next)) {
+					next = event;
+				}
+			}
+			return next;
+		}
+
+		/// Moves to tick m_now + 1 and collects the callbacks that fall due. m_mutex must be held.
+		void Step() {
+			++m_now;
+			for (std::size_t level = kLevels - 1; level > 0; --level) {
+				if ((m_now & ((std::uint64_t{ 1 } << (kSlotBits * level)) - 1)) == 0) {
+					Cascade(level);
+				}
+			}
+			std::uint32_t index = TakeSlot(0, m_now & kSlotMask);
+			while (index != kNone) {
+				Timer& timer = m_timers[index];
+				std::uint32_t next = timer.next;
+				timer.slot = kNone;
+				if (timer.period != 0) {
+					m_due.push_back(timer.callback);
+					timer.expiry = std::max(timer.expiry + timer.period, m_now + 1);
+					Link(index);
+				}
+				else {
+					m_due.push_back(std::move(timer.callback));
+					FreeTimer(index);
+					--m_count;
+				}
+				index = next;
+			}
+		}
+
+		/// Hands a callback's exception to the error handler, or writes it to stderr without one.
+		void ReportError(std::exception_ptr ex) noexcept {
+			try {
+				if (m_on_error) {
+					m_on_error(std::move(ex));
+					return;
+				}
+				try {
+					std::rethrow_exception(ex);
+				}
+				catch (std::exception const& e) {
+					std::println(stderr, "TimerWheel: a timer callback threw: {}", e.what());
+				}
+				catch (...) {
+					std::println(stderr, "TimerWheel: a timer callback threw an unknown exception");
+				}
+			}
+			catch (...) {
+				// Reporting must not take the driving thread down either.
+			}
+		}
+
+		TimerId Insert(std::uint64_t expiry, std::uint64_t period, TimerCallback&& callback) {
+			std::lock_guard lock(m_mutex);
+			std::uint32_t index = AllocateTimer();
+			Timer& timer = m_timers[index];
+			timer.callback = std::move(callback);
+			timer.expiry = std::max(expiry, m_now + 1);
+			timer.period = period;
+			Link(index);
+			++m_count;
+			return { index, timer.generation };
+		}
+
+	public:
+		/**
+		 * @param tick Resolution; deadlines are rounded up to whole ticks.
+		 * @param executor Runs due callbacks; they run inline in Advance() if empty.
+		 * @param on_error Receives exceptions thrown by callbacks; they go to stderr if empty.
+		 */
+		explicit TimerWheel(
+			Clock::duration tick = std::chrono::milliseconds(10),
+			TimerExecutor executor = nullptr,
+			TimerErrorHandler on_error = nullptr
+		)
+			: m_tick(tick > Clock::duration::zero() ? tick : Clock::duration(1)),
+			m_origin(Clock::now()),
+			m_executor(std::move(executor)),
+			m_on_error(std::move(on_error)) {
+			m_heads.fill(kNone);
+		}
+
+		TimerWheel(TimerWheel const&) = delete;
+		TimerWheel& operator=(TimerWheel const&) = delete;
+
+		/// Runs `callback` once, no earlier than `delay` from now.
+		TimerId ScheduleAfter(Clock::duration delay, TimerCallback callback) {
+			return Insert(TickAtOrAfter(Clock::now() + delay), 0, std::move(callback));
+		}
+
+		/// Runs `callback` every `period`, the first time after `first_delay`.
+		TimerId ScheduleEvery(Clock::duration period, TimerCallback callback, Clock::duration first_delay) {
+			return Insert(TickAtOrAfter(Clock::now() + first_delay), std::max<std::uint64_t>(TicksOf(period), 1), std::move(callback));
+		}
+
+		TimerId ScheduleEvery(Clock::duration period, TimerCallback callback) {
+			return ScheduleEvery(period, std::move(callback), period);
+		}
+
+		/**
+		 * @brief Cancels a timer; a periodic timer may cancel itself from its callback.
+		 * @return false if the timer already fired (one-shot) or was cancelled.
+		 */
+		bool Cancel(TimerId id) noexcept {
+			std::lock_guard lock(m_mutex);
+			if (id.index >= m_timers.size()) {
+				return false;
+			}
+			Timer& timer = m_timers[id.index];
+			if (timer.generation != id.generation || timer.slot == kNone) {
+				return false;
+			}
+			Unlink(id.index);
+			FreeTimer(id.index);
+			--m_count;
+			return true;
+		}
+
+		/// Fires every timer due at or before `now`. Returns how many callbacks ran.
+		std::size_t Advance(Clock::time_point now = Clock::now()) {
+			{
+				std::lock_guard lock(m_mutex);
+				std::uint64_t target = TickAtOrBefore(now);
+				while (m_now < target) {
+					// Skip ticks on which nothing fires or cascades.
+					auto event = NextEvent();
+					if (!event || *event > target) {
+						m_now = target;
+						break;
+					}
+					m_now = *event - 1;
+					Step();
+				}
+			}
+			std::size_t fired = m_due.size();
+			for (TimerCallback& callback : m_due) {
+				try {
+					if (m_executor) {
+						m_executor(std::move(callback));
+					}
+					else {
+						callback();
+					}
+				}
+				catch (...) {
+					ReportError(std::current_exception());
+				}
+			}
+			m_due.clear();
+			return fired;
+		}
+
+		/// When the next timer fires or is re-hashed, if any is scheduled.
+		std::optional<Clock::time_point> NextDeadline() const {
+			std::lock_guard lock(m_mutex);
+			auto event = NextEvent();
+			if (!event) {
+				return std::nullopt;
+			}
+			return m_origin + m_tick * static_cast<Clock::rep>(*event);
+		}
+
+		std::size_t size() const noexcept {
+			std::lock_guard lock(m_mutex);
+			return m_count;
+		}
+	};
+
+	/**
+	 * @brief A TimerWheel driven by its own thread.
+	 *
+	 * The thread sleeps until the next deadline and wakes early when a
+	 * timer is scheduled. Callbacks run on that thread unless an executor
+	 * is given; what they throw goes to the error handler.
+	 */
+	export class TimerThread {
+	private:
+		TimerWheel m_wheel;
+		std::mutex m_mutex;
+		std::condition_variable_any m_wake;
+		std::uint64_t m_schedules = 0;
+		std::jthread m_thread;
+
+		void Notify() {
+			{
+				std::lock_guard lock(m_mutex);
+				++m_schedules;
+			}
+			m_wake.notify_one();
+		}
+
+		void Run(std::stop_token stop) {
+			std::unique_lock lock(m_mutex);
+			while (!stop.stop_requested()) {
+				std::uint64_t seen = m_schedules;
+				lock.unlock();
+				m_wheel.Advance();
+				auto deadline = m_wheel.NextDeadline();
+				lock.lock();
+				auto Woken = [&]() {
+					return m_schedules != seen;
+				};
+				if (deadline) {
+					m_wake.wait_until(lock, stop, *deadline, Woken);
+				}
+				else {
+					m_wake.wait(lock, stop, Woken);
+				}
+			}
+		}
+
+	public:
+		explicit TimerThread(
+			TimerWheel::Clock::duration tick = std::chrono::milliseconds(10),
+			TimerExecutor executor = nullptr,
+			TimerErrorHandler on_error = nullptr
+		)
+			: m_wheel(tick, std::move(executor), std::move(on_error)),
+			m_thread([this](std::stop_token stop) { Run(stop); }) {
+		}
+
+		TimerThread(TimerThread const&) = delete;
+		TimerThread& operator=(TimerThread const&) = delete;
+
+		TimerId ScheduleAfter(TimerWheel::Clock::duration delay, TimerCallback callback) {
+			TimerId id = m_wheel.ScheduleAfter(delay, std::move(callback));
+			Notify();
+			return id;
+		}
+
+		TimerId ScheduleEvery(TimerWheel::Clock::duration period, TimerCallback callback, TimerWheel::Clock::duration first_delay) {
+			TimerId id = m_wheel.ScheduleEvery(period, std::move(callback), first_delay);
+			Notify();
+			return id;
+		}
+
+		TimerId ScheduleEvery(TimerWheel::Clock::duration period, TimerCallback callback) {
+			return ScheduleEvery(period, std::move(callback), period);
+		}
+
+		bool Cancel(TimerId id) noexcept {
+			return m_wheel.Cancel(id);
+		}
+
+		TimerWheel& Wheel() noexcept {
+			return m_wheel;
+		}
+	};
+
+}
@@ -0,0 +1,245 @@
+// ============================================================================
+// wait_strategy.cppm - Module interface for consumer wait policies
+// ============================================================================
+//
+// A wait strategy decides how a consumer waits for a condition published by
+// another thread and what the publisher has to do to wake it. Containers such
+// as CircularBuffer take a strategy as a policy parameter and call Notify()
+// after every publish and Wait()/WaitUntil() when they run dry.
+
+module;
+#include <version>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif // defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#if !defined(__cpp_lib_modules)
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.wait_strategy;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::concurrency {
+
+	/// Hints the CPU that the calling thread is spinning.
+	export inline void CpuRelax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		asm volatile("yield" ::: "memory");
+#endif
+	}
+
+	/// Exponential spin backoff that degrades to yielding the time slice.
+	export class Backoff {
+	private:
+		static constexpr std::uint32_t kSpinLimit = 6;	// up to 2^6 pauses per step
+		std::uint32_t m_step = 0;
+
+	public:
+		void Pause() noexcept {
+			if (m_step <= kSpinLimit) {
+				for (std::uint32_t i = 0; i < (1u << m_step); ++i) {
+					CpuRelax();
+				}
+				++m_step;
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+
+		bool IsSpinning() const noexcept {
+			return m_step <= kSpinLimit;
+		}
+
+		void Reset() noexcept {
+			m_step = 0;
+		}
+	};
+
+	/**
+	 * @brief Requirements on a wait strategy.
+	 *
+	 * Notify() is called by the publisher after it made a condition true.
+	 * Wait(ready) returns once ready() returned true, WaitUntil(ready, deadline)
+	 * additionally gives up at the deadline and then returns false. ready() may
+	 * have side effects (e.g. claim an element) and is only retried after it
+	 * returned false.
+	 */
+	export template <class S>
+	concept WaitStrategy = requires(S & s, bool(*ready)(), std::chrono::steady_clock::time_point deadline) {
+		{ s.Notify() } noexcept;
+		s.Wait(ready);
+		{ s.WaitUntil(ready, deadline) } -> std::same_as<bool>;
+	};
+
+	/// Spins with CPU pause hints and never sleeps; lowest latency, burns a core.
+	export class BusySpinWait {
+	public:
+		void Notify() noexcept {}
+
+		template <std::predicate Ready>
+		void Wait(Ready&& ready) {
+			while (!ready()) {
+				CpuRelax();
+			}
+		}
+
+		template <std::predicate Ready, class Clock, class Duration>
+		bool WaitUntil(Ready&& ready, std::chrono::time_point<Clock, Duration> const& deadline) {
+			while (!ready()) {
+				if (Clock::now() >= deadline) {
+					return false;
+				}
+				CpuRelax();
+			}
+			return true;
+		}
+	};
+
+	/// Spins with exponential backoff, then keeps yielding the time slice.
+	export class SpinThenYieldWait {
+	public:
+		void Notify() noexcept {}
+
+		template <std::predicate Ready>
+		void Wait(Ready&& ready) {
+			Backoff backoff;
+			while (!ready()) {
+				backoff.Pause();
+			}
+		}
+
+		template <std::predicate Ready, class Clock, class Duration>
+		bool WaitUntil(Ready&& ready, std::chrono::time_point<Clock, Duration> const& deadline) {
+			Backoff backoff;
+			while (!ready()) {
+				if (Clock::now() >= deadline) {
+					return false;
+				}
+				backoff.Pause();
+			}
+			return true;
+		}
+	};
+
+	/**
+	 * @brief Spins briefly, then parks on a futex‑style atomic wait.
+	 *
+	 * Sleepers register in a waiter count before their final re‑check, so
+	 * Notify() only touches the wake counter and issues a wake syscall when
+	 * somebody is actually parked. atomic::wait has no deadline, so timed
+	 * waits park on a condition variable instead, which Notify() only locks
+	 * while a thread is parked on it.
+	 */
+	export class SpinThenParkWait {
+	private:
+		std::atomic<std::uint32_t> m_waiters{ 0 };
+		std::atomic<std::uint32_t> m_epoch{ 0 };
+		std::atomic<std::uint32_t> m_cv_waiters{ 0 };
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+
+	protected:
+		template <class Ready>
+		static bool Spin(Ready& ready) {
+			Backoff backoff;
+			while (backoff.IsSpinning()) {
+				if (ready()) {
+					return true;
+				}
+				backoff.Pause();
+			}
+			return false;
+		}
+
+		/// Parks on the condition variable until ready() returns true, or until `deadline` unless it is null.
+		template <class Ready, class Clock, class Duration>
+		bool ParkOnCondition(Ready& ready, std::chrono::time_point<Clock, Duration> const* deadline) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv_waiters.fetch_add(1, std::memory_order::relaxed);
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			bool satisfied = true;
+			while (!ready()) {
+				if (!deadline) {
+					m_cv.wait(lock);
+				}
+				else if (m_cv.wait_until(lock, *deadline) == std::cv_status::timeout) {
+					satisfied = ready();
+					break;
+				}
+			}
+			m_cv_waiters.fetch_sub(1, std::memory_order::relaxed);
+			return satisfied;
+		}
+
+	public:
+		void Notify() noexcept {
+			// Pairs with the fence in Wait(): either the sleeper's re-check sees
+			// the publish, or this load sees the sleeper.
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+			if (m_waiters.load(std::memory_order::relaxed) != 0) {
+				m_epoch.fetch_add(1, std::memory_order::release);
+				m_epoch.notify_all();
+			}
+			if (m_cv_waiters.load(std::memory_order::relaxed) != 0) {
+				// Taking the mutex orders this wake after the sleeper's re-check.
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+				}
+				m_cv.notify_all();
+			}
+		}
+
+		template <std::predicate Ready>
+		void Wait(Ready&& ready) {
+			if (Spin(ready)) {
+				return;
+			}
+			while (true) {
+				std::uint32_t epoch = m_epoch.load(std::memory_order::acquire);
+				m_waiters.fetch_add(1, std::memory_order::relaxed);
+				std::atomic_thread_fence(std::memory_order::seq_cst);
+				if (ready()) {
+					m_waiters.fetch_sub(1, std::memory_order::relaxed);
+					return;
+				}
+				m_epoch.wait(epoch, std::memory_order::acquire);
+				m_waiters.fetch_sub(1, std::memory_order::relaxed);
+			}
+		}
+
+		template <std::predicate Ready, class Clock, class Duration>
+		bool WaitUntil(Ready&& ready, std::chrono::time_point<Clock, Duration> const& deadline) {
+			return Spin(ready) || ParkOnCondition(ready, &deadline);
+		}
+	};
+
+	/**
+	 * @brief SpinThenParkWait that parks untimed waits on the condition variable too.
+	 *
+	 * Every sleeper then wakes through the same mutex, which suits consumers
+	 * that mostly wait with a deadline.
+	 */
+	export class TimedParkWait : public SpinThenParkWait {
+	public:
+		template <std::predicate Ready>
+		void Wait(Ready&& ready) {
+			if (!Spin(ready)) {
+				ParkOnCondition(ready, static_cast<std::chrono::steady_clock::time_point const*>(nullptr));
+			}
+		}
+	};
+
+} // namespace plastic::concurrency
@@ -0,0 +1,319 @@
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.flags;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace {
+	template <class Enum>
+	constexpr std::size_t EnumSize = []() -> std::size_t {
+		static_assert(std::is_enum_v<Enum>, "Not an enumeration type");
+		static_assert(requires { Enum::Count; },
+			"Enum must have a 'Count' enumerator representing the number of values");
+		return static_cast<std::size_t>(Enum::Count);
+		}();
+}
+
+namespace plastic::ds {
+
+	/**
+	 * @brief Fixed-size set of enumerators stored as plain words.
+	 *
+	 * The single-threaded counterpart of concurrency::AtomicFlags with the same
+	 * query interface. Every operation is constexpr, copies are trivial, and
+	 * range queries mask whole words instead of testing bit by bit, so flag
+	 * sets can be compile-time constants, hash keys and table indices.
+	 *
+	 * @tparam Enum Enumeration with consecutive enumerators ending in `Count`.
+	 */
+	export template <class Enum, class Word = std::size_t> class Flags {
+	public:
+		static_assert(std::is_unsigned_v<Word>, "Word must be an unsigned integral type");
+		static_assert(EnumSize<Enum> > 0, "Enum must have at least one value");
+
+		static constexpr std::size_t kBitsPerWord = sizeof(Word) * 8;
+		static constexpr std::size_t kWordCount = (EnumSize<Enum> + kBitsPerWord - 1) / kBitsPerWord;
+
+		using Words = std::array<Word, kWordCount>;
+
+		struct Range {
+			Enum from;
+			Enum to;
+		};
+
+	private:
+		Words m_bits{};
+
+		struct Location { std::size_t idx; Word mask; };
+
+		static constexpr Word LowMask(std::size_t n) noexcept {
+			if (n >= kBitsPerWord) {
+				return ~static_cast<Word>(0);
+			}
+			return (static_cast<Word>(1) << n) - 1;
+		}
+
+		static constexpr Word kLastWordMask =
+			(EnumSize<Enum> % kBitsPerWord == 0) ?
+			~static_cast<Word>(0) :
+			LowMask(EnumSize<Enum> % kBitsPerWord);
+
+		static constexpr Location Locate(Enum e) noexcept {
+			std::size_t idx = static_cast<std::size_t>(e);
+			return { idx / kBitsPerWord, static_cast<Word>(1) << (idx % kBitsPerWord) };
+		}
+
+		static constexpr bool ValidRange(Enum from, Enum to) noexcept {
+			return static_cast<std::size_t>(from) <= static_cast<std::size_t>(to) &&
+				static_cast<std::size_t>(to) < EnumSize<Enum>;
+		}
+
+	public:
+		constexpr Flags() noexcept = default;
+
+		constexpr explicit Flags(Enum e) noexcept {
+			Set(e);
+		}
+
+		template <class... Enums>
+			requires (sizeof...(Enums) >= 2) && (std::same_as<Enum, std::remove_cvref_t<Enums>> && ...)
+		constexpr Flags(Enums&&... enums) noexcept {
+			(Set(enums), ...);
+		}
+
+		/// All enumerators in [from, to].
+		static constexpr Flags FromRange(Enum from, Enum to) noexcept {
+			assert(ValidRange(from, to) && "Flags::FromRange(): invalid range");
+			Flags result;
+			std::size_t from_idx = static_cast<std::size_t>(from);
+			std::size_t to_idx = static_cast<std::size_t>(to);
+			for (std::size_t w = from_idx / kBitsPerWord; w <= to_idx / kBitsPerWord; ++w) {
+				std::size_t lo = w == from_idx / kBitsPerWord ? from_idx % kBitsPerWord : 0;
+				std::size_t hi = w == to_idx / kBitsPerWord ? to_idx % kBitsPerWord : kBitsPerWord - 1;
+				result.m_bits[w] = LowMask(hi + 1) & ~LowMask(lo);
+			}
+			return result;
+		}
+
+		static constexpr Flags All() noexcept {
+			Flags result;
+			result.SetAll();
+			return result;
+		}
+
+		constexpr bool Test(Enum e) const noexcept {
+			auto [idx, mask] = Locate(e);
+			return (m_bits[idx] & mask) != 0;
+		}
+
+		constexpr bool TestAndSet(Enum e, bool value = true) noexcept {
+			bool was_set = Test(e);
+			Set(e, value);
+			return was_set;
+		}
+
+		constexpr void Set(Enum e, bool value = true) noexcept {
+			auto [idx, mask] = Locate(e);
+			if (value) {
+				m_bits[idx] |= mask;
+			}
+			else {
+				m_bits[idx] &= ~mask;
+			}
+		}
+
+		constexpr void Reset(Enum e) noexcept {
+			Set(e, false);
+		}
+
+		constexpr void Flip(Enum e) noexcept {
+			auto [idx, mask] = Locate(e);
+			m_bits[idx] ^= mask;
+		}
+
+		constexpr void SetAll() noexcept {
+			for (std::size_t i = 0; i < kWordCount - 1; ++i) {
+				m_bits[i] = ~static_cast<Word>(0);
+			}
+			m_bits[kWordCount - 1] = kLastWordMask;
+		}
+
+		constexpr void ResetAll() noexcept {
+			m_bits = {};
+		}
+
+		constexpr void FlipAll() noexcept {
+			for (std::size_t i = 0; i < kWordCount - 1; ++i) {
+				m_bits[i] = ~m_bits[i];
+			}
+			m_bits[kWordCount - 1] ^= kLastWordMask;
+		}
+
+		constexpr bool Any() const noexcept {
+			for (Word w : m_bits) {
+				if (w != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		constexpr bool None() const noexcept {
+			return !Any();
+		}
+
+		constexpr std::size_t Count() const noexcept {
+			std::size_t total = 0;
+			for (Word w : m_bits) {
+				total += static_cast<std::size_t>(std::popcount(w));
+			}
+			return total;
+		}
+
+		/// Lowest enumerator in the set, or std::nullopt if the set is empty.
+		constexpr std::optional<Enum> First() const noexcept {
+			for (std::size_t i = 0; i < kWordCount; ++i) {
+				if (m_bits[i] != 0) {
+					return static_cast<Enum>(i * kBitsPerWord + static_cast<std::size_t>(std::countr_zero(m_bits[i])));
+				}
+			}
+			return std::nullopt;
+		}
+
+		constexpr bool TestAny(Flags const& mask) const noexcept {
+			return (*this & mask).Any();
+		}
+
+		constexpr bool TestAll(Flags const& mask) const noexcept {
+			return (*this & mask) == mask;
+		}
+
+		constexpr bool TestContinuous(Enum from, Enum to) const noexcept {
+			assert(ValidRange(from, to) && "Flags::TestContinuous(): invalid range");
+			return TestAll(FromRange(from, to));
+		}
+
+		constexpr bool TestAnyInRange(Enum from, Enum to) const noexcept {
+			assert(ValidRange(from, to) && "Flags::TestAnyInRange(): invalid range");
+			return TestAny(FromRange(from, to));
+		}
+
+		constexpr std::size_t CountInRange(Enum from, Enum to) const noexcept {
+			assert(ValidRange(from, to) && "Flags::CountInRange(): invalid range");
+			return (*this & FromRange(from, to)).Count();
+		}
+
+		constexpr bool TestSingleInRange(Enum from, Enum to) const noexcept {
+			return CountInRange(from, to) == 1;
+		}
+
+		/// Lowest enumerator of the set within [from, to], or std::nullopt.
+		constexpr std::optional<Enum> FirstInRange(Enum from, Enum to) const noexcept {
+			assert(ValidRange(from, to) && "Flags::FirstInRange(): invalid range");
+			return (*this & FromRange(from, to)).First();
+		}
+
+		constexpr bool CheckMutualExclusion(std::span<Range const> groups) const noexcept {
+			std::size_t active = 0;
+			for (auto const& g : groups) {
+				if (TestAnyInRange(g.from, g.to) && ++active > 1) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr Words const& Snapshot() const noexcept {
+			return m_bits;
+		}
+
+		constexpr void Assign(Words const& words) noexcept {
+			m_bits = words;
+			m_bits[kWordCount - 1] &= kLastWordMask;
+		}
+
+		constexpr Flags& operator|=(Flags const& other) noexcept {
+			for (std::size_t i = 0; i < kWordCount; ++i) {
+				m_bits[i] |= other.m_bits[i];
+			}
+			return *this;
+		}
+
+		constexpr Flags& operator&=(Flags const& other) noexcept {
+			for (std::size_t i = 0; i < kWordCount; ++i) {
+				m_bits[i] &= other.m_bits[i];
+			}
+			return *this;
+		}
+
+		constexpr Flags& operator^=(Flags const& other) noexcept {
+			for (std::size_t i = 0; i < kWordCount; ++i) {
+				m_bits[i] ^= other.m_bits[i];
+			}
+			return *this;
+		}
+
+		constexpr Flags& operator|=(Enum e) noexcept {
+			Set(e);
+			return *this;
+		}
+
+		constexpr Flags& operator^=(Enum e) noexcept {
+			Flip(e);
+			return *this;
+		}
+
+		friend constexpr Flags operator|(Flags lhs, Flags const& rhs) noexcept {
+			return lhs |= rhs;
+		}
+
+		friend constexpr Flags operator&(Flags lhs, Flags const& rhs) noexcept {
+			return lhs &= rhs;
+		}
+
+		friend constexpr Flags operator^(Flags lhs, Flags const& rhs) noexcept {
+			return lhs ^= rhs;
+		}
+
+		friend constexpr Flags operator|(Flags lhs, Enum rhs) noexcept {
+			return lhs |= rhs;
+		}
+
+		friend constexpr Flags operator~(Flags flags) noexcept {
+			flags.FlipAll();
+			return flags;
+		}
+
+		friend constexpr bool operator==(Flags const&, Flags const&) noexcept = default;
+
+		constexpr std::size_t Hash() const noexcept {
+			std::size_t h = 0;
+			for (Word w : m_bits) {
+				h ^= static_cast<std::size_t>(w) + static_cast<std::size_t>(0x9E3779B97F4A7C15ull) + (h << 6) + (h >> 2);
+			}
+			return h;
+		}
+	};
+
+} // namespace plastic::ds
+
+template <class Enum, class Word>
+struct std::hash<plastic::ds::Flags<Enum, Word>> {
+	std::size_t operator()(plastic::ds::Flags<Enum, Word> const& flags) const noexcept {
+		return flags.Hash();
+	}
+};
@@ -0,0 +1,167 @@
+// ============================================================================
+// inplace_function.cppm - Module interface for a non-allocating std::function
+// ============================================================================
+//
+// This module provides InplaceFunction, a copyable type-erased callable that
+// stores its target in a fixed buffer inside the object. Unlike
+// std::function it never allocates: a target that does not fit the buffer
+// is rejected at compile time instead of being moved to the heap. Calls go
+// through one function pointer, with no virtual dispatch.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.inplace_function;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::ds {
+
+	export template <class Signature, std::size_t Capacity = 4 * sizeof(void*)> class InplaceFunction;
+
+	/**
+	 * @brief std::function work-alike with `Capacity` bytes of inline storage.
+	 *
+	 * Targets must be copy constructible and nothrow move constructible, and
+	 * must fit in `Capacity` bytes at an alignment of at most
+	 * alignof(std::max_align_t). Calling an empty InplaceFunction throws
+	 * std::bad_function_call.
+	 */
+	export template <class R, class... Args, std::size_t Capacity>
+	class InplaceFunction<R(Args...), Capacity> {
+	private:
+		struct Operations {
+			R (*invoke)(void* target, Args&&... args);
+			void (*copy)(void* destination, void const* source);
+			void (*move)(void* destination, void* source) noexcept;
+			void (*destroy)(void* target) noexcept;
+		};
+
+		template <class F> static constexpr Operations kOperationsOf{
+			[](void* target, Args&&... args) -> R {
+				return std::invoke(*static_cast<F*>(target), std::forward<Args>(args)...);
+			},
+			[](void* destination, void const* source) {
+				std::construct_at(static_cast<F*>(destination), *static_cast<F const*>(source));
+			},
+			[](void* destination, void* source) noexcept {
+				std::construct_at(static_cast<F*>(destination), std::move(*static_cast<F*>(source)));
+				std::destroy_at(static_cast<F*>(source));
+			},
+			[](void* target) noexcept {
+				std::destroy_at(static_cast<F*>(target));
+			}
+		};
+
+		alignas(std::max_align_t) mutable std::byte m_storage[Capacity];
+		Operations const* m_operations = nullptr;
+
+		template <class F> static constexpr bool kFits =
+			sizeof(F) <= Capacity &&
+			alignof(F) <= alignof(std::max_align_t) &&
+			std::is_nothrow_move_constructible_v<F>;
+
+	public:
+		InplaceFunction() noexcept = default;
+
+		InplaceFunction(std::nullptr_t) noexcept {
+		}
+
+		template <class F>
+			requires (!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+				std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+		InplaceFunction(F&& function) {
+			using Target = std::decay_t<F>;
+			static_assert(kFits<Target>, "Callable does not fit the InplaceFunction buffer; raise Capacity");
+			static_assert(std::is_copy_constructible_v<Target>, "InplaceFunction targets must be copyable");
+			if constexpr (std::is_pointer_v<Target> || std::is_member_pointer_v<Target>) {
+				if (function == nullptr) {
+					return;
+				}
+			}
+			std::construct_at(reinterpret_cast<Target*>(m_storage), std::forward<F>(function));
+			m_operations = &kOperationsOf<Target>;
+		}
+
+		InplaceFunction(InplaceFunction const& other) {
+			if (other.m_operations) {
+				other.m_operations->copy(m_storage, other.m_storage);
+				m_operations = other.m_operations;
+			}
+		}
+
+		InplaceFunction(InplaceFunction&& other) noexcept {
+			if (other.m_operations) {
+				other.m_operations->move(m_storage, other.m_storage);
+				m_operations = std::exchange(other.m_operations, nullptr);
+			}
+		}
+
+		~InplaceFunction() {
+			reset();
+		}
+
+		InplaceFunction& operator=(InplaceFunction const& other) {
+			if (this != &other) {
+				InplaceFunction copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+			if (this != &other) {
+				reset();
+				if (other.m_operations) {
+					other.m_operations->move(m_storage, other.m_storage);
+					m_operations = std::exchange(other.m_operations, nullptr);
+				}
+			}
+			return *this;
+		}
+
+		InplaceFunction& operator=(std::nullptr_t) noexcept {
+			reset();
+			return *this;
+		}
+
+		template <class F>
+			requires (!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+				std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+		InplaceFunction& operator=(F&& function) {
+			return *this = InplaceFunction(std::forward<F>(function));
+		}
+
+		void reset() noexcept {
+			if (m_operations) {
+				std::exchange(m_operations, nullptr)->destroy(m_storage);
+			}
+		}
+
+		explicit operator bool() const noexcept {
+			return m_operations != nullptr;
+		}
+
+		/// Like std::function, invokes the target as a non-const lvalue.
+		R operator()(Args... args) const {
+			if (!m_operations) {
+				throw std::bad_function_call();
+			}
+			return m_operations->invoke(m_storage, std::forward<Args>(args)...);
+		}
+
+		friend bool operator==(InplaceFunction const& function, std::nullptr_t) noexcept {
+			return !function;
+		}
+	};
+
+}
@@ -0,0 +1,352 @@
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <utility>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <concepts>
+#include <new>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.lru;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.static_hash_table;
+
+namespace plastic::ds {
+
+	/**
+	 * @brief Fixed-capacity least-recently-used cache, not thread-safe.
+	 *
+	 * Map must map a key to a List::iterator (e.g. StaticHashTable), List must
+	 * store std::pair<Key const, Value> and provide splice (e.g. StaticList).
+	 * The most recently used entry is kept at the front of the list.
+	 */
+	export template <class Map, class List, std::size_t Capacity> class LRUCache {
+	public:
+		using key_type = typename Map::key_type;
+		using value_type = std::remove_cvref_t<decltype(*std::declval<typename List::iterator>())>;
+		using mapped_type = typename value_type::second_type;
+		using size_type = std::size_t;
+
+		static_assert(Capacity > 0, "Capacity must be greater than 0");
+		static_assert(Map::capacity() >= Capacity, "Map is too small for the cache capacity");
+		static_assert(List::capacity() >= Capacity, "List is too small for the cache capacity");
+
+	private:
+		Map m_map;
+		List m_list;
+
+		constexpr void Touch(typename List::iterator it) noexcept {
+			m_list.splice(m_list.cbegin(), it);
+		}
+
+		constexpr void EvictBack() noexcept {
+			m_map.erase(m_list.back().first);
+			m_list.pop_back();
+		}
+
+		template <class K, class V>
+		constexpr mapped_type& InsertFront(K&& key, V&& value) {
+			if (m_list.size() >= Capacity) {
+				EvictBack();
+			}
+			m_list.push_front(value_type(key, std::forward<V>(value)));
+			m_map.insert(typename Map::value_type(std::forward<K>(key), m_list.begin()));
+			return m_list.front().second;
+		}
+
+	public:
+		constexpr LRUCache() = default;
+
+		constexpr size_type size() const noexcept { return m_list.size(); }
+		constexpr bool empty() const noexcept { return m_list.empty(); }
+		static constexpr size_type capacity() noexcept { return Capacity; }
+
+		constexpr bool Contains(key_type const& key) const noexcept {
+			return m_map.contains(key);
+		}
+
+		/// Returns the cached value and marks it most recently used, throws if absent.
+		constexpr mapped_type& Get(key_type const& key) {
+			auto it = m_map.find(key);
+			if (it == m_map.end()) {
+				throw std::out_of_range("LRUCache::Get: key not found");
+			}
+			Touch(it->second);
+			return it->second->second;
+		}
+
+		/// Returns a pointer to the cached value or nullptr, marks a hit most recently used.
+		constexpr mapped_type* TryGet(key_type const& key) noexcept {
+			auto it = m_map.find(key);
+			if (it == m_map.end()) {
+				return nullptr;
+			}
+			Touch(it->second);
+			return &it->second->second;
+		}
+
+		/// Inserts or overwrites a value, evicting the least recently used entry when full.
+		template <class V>
+		constexpr void Put(key_type const& key, V&& value) {
+			auto it = m_map.find(key);
+			if (it != m_map.end()) {
+				it->second->second = std::forward<V>(value);
+				Touch(it->second);
+				return;
+			}
+			(void)InsertFront(key, std::forward<V>(value));
+		}
+
+		/// Returns the cached value, calling factory() exactly once to fill a miss.
+		template <std::invocable Factory>
+		constexpr mapped_type& GetOrCompute(key_type const& key, Factory&& factory) {
+			if (mapped_type* value = TryGet(key)) {
+				return *value;
+			}
+			return InsertFront(key, std::invoke(std::forward<Factory>(factory)));
+		}
+
+		constexpr bool Erase(key_type const& key) noexcept {
+			auto it = m_map.find(key);
+			if (it == m_map.end()) {
+				return false;
+			}
+			auto list_it = it->second;
+			m_map.erase(it);
+			m_list.erase(list_it);
+			return true;
+		}
+
+		constexpr void Clear() noexcept {
+			m_map.clear();
+			m_list.clear();
+		}
+	};
+
+	/**
+	 * @brief Thread-safe fixed-capacity cache split into lock-striped shards.
+	 *
+	 * Every shard owns a reader/writer lock, a slot array and a StaticSwissTable
+	 * index from key to slot. Lookups only take the shared lock: recency is
+	 * tracked with a per-slot reference bit (CLOCK, an LRU approximation), so a
+	 * hit never needs exclusive access. Inserts take the exclusive lock of one
+	 * shard and sweep the clock hand to find a victim.
+	 *
+	 * @tparam Capacity   Total number of entries across all shards.
+	 * @tparam ShardCount Number of independently locked shards, a power of two.
+	 */
+	export template <
+		class Key, class Value, std::size_t Capacity,
+		std::size_t ShardCount = 8,
+		class Hash = std::hash<Key>,
+		class Equal = std::equal_to<Key>
+	> class ShardedLRUCache {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+
+		static_assert(Capacity > 0, "Capacity must be greater than 0");
+		static_assert(std::has_single_bit(ShardCount), "ShardCount must be a power of two");
+		static_assert(std::is_copy_constructible_v<Key>, "Key must be copy constructible");
+		static_assert(std::is_copy_constructible_v<Value>, "Value must be copy constructible");
+
+	private:
+		static constexpr size_type kShardCapacity = (Capacity + ShardCount - 1) / ShardCount;
+		static constexpr size_type kShardShift = std::numeric_limits<std::size_t>::digits - std::countr_zero(ShardCount);
+
+		using Index = StaticSwissTable<Key, size_type, kShardCapacity, Hash, Equal>;
+
+		struct Slot {
+			std::optional<std::pair<Key const, Value>> data;
+			mutable std::atomic<bool> referenced = false;
+		};
+
+		struct alignas(std::hardware_destructive_interference_size) Shard {
+			mutable std::shared_mutex mutex;
+			Index index;
+			std::array<Slot, kShardCapacity> slots;
+			size_type size = 0;
+			size_type hand = 0;
+		};
+
+		std::array<Shard, ShardCount> m_shards;
+		[[no_unique_address]] Hash m_hasher;
+
+		Shard& ShardFor(Key const& key) noexcept {
+			if constexpr (ShardCount == 1) {
+				return m_shards[0];
+			}
+			else {
+				// Fibonacci hashing picks the shard from the high bits, so the low
+				// bits used by the per-shard index stay independent.
+				std::size_t h = static_cast<std::size_t>(m_hasher(key)) * static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+				return m_shards[h >> kShardShift];
+			}
+		}
+
+		Shard const& ShardFor(Key const& key) const noexcept {
+			return const_cast<ShardedLRUCache*>(this)->ShardFor(key);
+		}
+
+		static void MarkReferenced(Slot const& slot) noexcept {
+			// Skip the store when already set to avoid bouncing the cache line.
+			if (!slot.referenced.load(std::memory_order::relaxed)) {
+				slot.referenced.store(true, std::memory_order::relaxed);
+			}
+		}
+
+		static void EraseSlot(Shard& shard, size_type slot_idx) {
+			Slot& slot = shard.slots[slot_idx];
+			shard.index.erase(slot.data->first);
+			slot.data.reset();
+			slot.referenced.store(false, std::memory_order::relaxed);
+			--shard.size;
+		}
+
+		// Requires the exclusive lock. Returns an empty slot, evicting if necessary.
+		static size_type AcquireSlot(Shard& shard) {
+			while (true) {
+				size_type idx = shard.hand;
+				shard.hand = (shard.hand + 1) % kShardCapacity;
+				Slot& slot = shard.slots[idx];
+				if (!slot.data) {
+					return idx;
+				}
+				if (shard.size < kShardCapacity) {
+					continue;
+				}
+				if (slot.referenced.exchange(false, std::memory_order::relaxed)) {
+					continue;	// second chance
+				}
+				EraseSlot(shard, idx);
+				return idx;
+			}
+		}
+
+		template <class V>
+		static Value const& InsertLocked(Shard& shard, Key const& key, V&& value) {
+			size_type idx = AcquireSlot(shard);
+			Slot& slot = shard.slots[idx];
+			slot.data.emplace(key, std::forward<V>(value));
+			slot.referenced.store(true, std::memory_order::relaxed);
+			shard.index.insert(typename Index::value_type(key, idx));
+			++shard.size;
+			return slot.data->second;
+		}
+
+		static Slot const* FindLocked(Shard const& shard, Key const& key) noexcept {
+			auto it = shard.index.find(key);
+			if (it == shard.index.end()) {
+				return nullptr;
+			}
+			return &shard.slots[it->second];
+		}
+
+	public:
+		ShardedLRUCache() = default;
+		ShardedLRUCache(ShardedLRUCache const&) = delete;
+		ShardedLRUCache& operator=(ShardedLRUCache const&) = delete;
+
+		static constexpr size_type capacity() noexcept { return kShardCapacity * ShardCount; }
+
+		/// Approximate number of entries, shards are sampled one after another.
+		size_type size() const noexcept {
+			size_type total = 0;
+			for (auto const& shard : m_shards) {
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				total += shard.size;
+			}
+			return total;
+		}
+
+		bool Contains(Key const& key) const {
+			Shard const& shard = ShardFor(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			return FindLocked(shard, key) != nullptr;
+		}
+
+		/// Returns a copy of the cached value, or std::nullopt on a miss.
+		std::optional<Value> Get(Key const& key) const {
+			Shard const& shard = ShardFor(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			Slot const* slot = FindLocked(shard, key);
+			if (!slot) {
+				return std::nullopt;
+			}
+			MarkReferenced(*slot);
+			return slot->data->second;
+		}
+
+		/// Inserts or overwrites a value.
+		template <class V>
+		void Put(Key const& key, V&& value) {
+			Shard& shard = ShardFor(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			auto it = shard.index.find(key);
+			if (it != shard.index.end()) {
+				Slot& slot = shard.slots[it->second];
+				slot.data->second = std::forward<V>(value);
+				MarkReferenced(slot);
+				return;
+			}
+			(void)InsertLocked(shard, key, std::forward<V>(value));
+		}
+
+		/**
+		 * @brief Returns the cached value, computing it on a miss.
+		 *
+		 * factory() runs under the shard's exclusive lock, so concurrent callers
+		 * missing on the same key compute the value once. If factory() throws,
+		 * nothing is cached and the exception propagates.
+		 */
+		template <std::invocable Factory>
+		Value GetOrCompute(Key const& key, Factory&& factory) {
+			if (std::optional<Value> cached = Get(key)) {
+				return *std::move(cached);
+			}
+			Shard& shard = ShardFor(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			if (Slot const* slot = FindLocked(shard, key)) {
+				return slot->data->second;
+			}
+			return InsertLocked(shard, key, std::invoke(std::forward<Factory>(factory)));
+		}
+
+		bool Erase(Key const& key) {
+			Shard& shard = ShardFor(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			auto it = shard.index.find(key);
+			if (it == shard.index.end()) {
+				return false;
+			}
+			EraseSlot(shard, it->second);
+			return true;
+		}
+
+		void Clear() {
+			for (auto& shard : m_shards) {
+				std::unique_lock<std::shared_mutex> lock(shard.mutex);
+				for (auto& slot : shard.slots) {
+					slot.data.reset();
+					slot.referenced.store(false, std::memory_order::relaxed);
+				}
+				shard.index.clear();
+				shard.size = 0;
+				shard.hand = 0;
+			}
+		}
+	};
+
+} // namespace plastic::ds
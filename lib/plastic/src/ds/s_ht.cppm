@@ -1,12 +1,24 @@
 module;
 #include <version>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PLASTIC_SWISS_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PLASTIC_SWISS_NEON 1
+#endif
 #if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <iterator>
 #include <stdexcept>
 #include <type_traits>
 #include <array>
 #include <functional>
+#include <limits>
 #include <optional>
 #include <string_view>
 #include <compare>
@@ -38,6 +50,15 @@ namespace plastic::ds {
 		}
 	};
 
+	// MurmurHash3 finalizer: identity hashes (e.g. integers) need mixing before
+	// their bits are split into table indices.
+	constexpr std::uint64_t MixHash(std::uint64_t h) noexcept {
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdull;
+		h ^= h >> 33;
+		return h;
+	}
+
 	export template <
 		class Key, class Value, std::size_t TableSize,
 		class Hash = ConstexprHasher<Key>,
@@ -345,4 +366,717 @@ namespace plastic::ds {
 		constexpr key_equal key_eq() const { return m_equal; }
 	};
 
+	/**
+	 * @brief Fixed-capacity hash table in the Swiss-table layout.
+	 *
+	 * Each slot has a one-byte control entry holding either a state (empty,
+	 * deleted) or 7 bits of the key's hash (H2). A probe compares 16 control
+	 * bytes at once (SSE2 or NEON at run time, a scalar loop in constant
+	 * evaluation), touches slot storage only on an H2 match and stops at the
+	 * first group that has an empty slot. Slots are raw storage constructed in
+	 * place, without a per-slot optional.
+	 *
+	 * The capacity is sized so that TableSize elements stay under 7/8 load.
+	 * Erasing from a group that was never full leaves an empty slot rather
+	 * than a tombstone, and when tombstones would push an insert over the load
+	 * limit the table rehashes in place to reclaim them.
+	 *
+	 * Like StaticHashTable, inserting an existing key replaces its value.
+	 */
+	export template <
+		class Key, class Value, std::size_t TableSize,
+		class Hash = ConstexprHasher<Key>,
+		class Equal = std::equal_to<Key>
+	> class StaticSwissTable {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key const, Value>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using hasher = Hash;
+		using key_equal = Equal;
+		using reference = value_type&;
+		using const_reference = value_type const&;
+
+		static_assert(TableSize > 0, "TableSize must be greater than 0");
+
+	private:
+		using Control = std::int8_t;
+
+		static constexpr Control kEmpty = -128;
+		static constexpr Control kDeleted = -2;
+		static constexpr size_type kGroupWidth = 16;
+		static constexpr size_type kGroupCount = std::bit_ceil(((TableSize * 8 + 6) / 7 + kGroupWidth - 1) / kGroupWidth);
+		static constexpr size_type kCapacity = kGroupCount * kGroupWidth;
+		static constexpr size_type kMaxLoad = kCapacity - kCapacity / 8;
+
+		struct Vacant {};
+
+		// A free slot keeps `vacant` active so tables stay usable as constants.
+		union Storage {
+			Vacant vacant;
+			value_type value;
+
+			constexpr Storage() noexcept
+				: vacant() {}
+			constexpr ~Storage() requires std::is_trivially_destructible_v<value_type> = default;
+			constexpr ~Storage() {}
+		};
+
+		std::array<Control, kCapacity> m_ctrl;
+		std::array<Storage, kCapacity> m_slots;
+		size_type m_size = 0;
+		size_type m_deleted = 0;
+		[[no_unique_address]] Hash m_hasher;
+		[[no_unique_address]] Equal m_equal;
+
+		static constexpr bool IsFull(Control c) noexcept {
+			return c >= 0;
+		}
+
+		constexpr std::uint64_t HashOf(Key const& key) const {
+			return MixHash(static_cast<std::uint64_t>(m_hasher(key)));
+		}
+
+		static constexpr Control H2(std::uint64_t h) noexcept {
+			return static_cast<Control>(h & 0x7F);
+		}
+
+		static constexpr size_type H1(std::uint64_t h) noexcept {
+			return static_cast<size_type>(h >> 7) & (kGroupCount - 1);
+		}
+
+#if defined(PLASTIC_SWISS_NEON)
+		static std::uint32_t MoveMask(uint8x16_t bytes) noexcept {
+			static constexpr std::uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+			uint8x16_t masked = vandq_u8(bytes, vld1q_u8(kBits));
+			return static_cast<std::uint32_t>(vaddv_u8(vget_low_u8(masked))) |
+				(static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(masked))) << 8);
+		}
+#endif // defined(PLASTIC_SWISS_NEON)
+
+		/// Bit i is set if control byte i of `group` equals `value`.
+		constexpr std::uint32_t Match(size_type group, Control value) const noexcept {
+			Control const* ctrl = m_ctrl.data() + group * kGroupWidth;
+			if !consteval {
+#if defined(PLASTIC_SWISS_SSE2)
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl));
+				return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#elif defined(PLASTIC_SWISS_NEON)
+				return MoveMask(vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(value)));
+#endif
+			}
+			std::uint32_t mask = 0;
+			for (size_type i = 0; i < kGroupWidth; ++i) {
+				mask |= static_cast<std::uint32_t>(ctrl[i] == value) << i;
+			}
+			return mask;
+		}
+
+		/// Bit i is set if slot i of `group` is empty or deleted.
+		constexpr std::uint32_t MatchNonFull(size_type group) const noexcept {
+			Control const* ctrl = m_ctrl.data() + group * kGroupWidth;
+			if !consteval {
+#if defined(PLASTIC_SWISS_SSE2)
+				return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))));
+#elif defined(PLASTIC_SWISS_NEON)
+				return MoveMask(vcltq_s8(vld1q_s8(ctrl), vdupq_n_s8(0)));
+#endif
+			}
+			std::uint32_t mask = 0;
+			for (size_type i = 0; i < kGroupWidth; ++i) {
+				mask |= static_cast<std::uint32_t>(!IsFull(ctrl[i])) << i;
+			}
+			return mask;
+		}
+
+		/// Triangular probing over a power-of-two group count visits every group once.
+		static constexpr size_type NextGroup(size_type group, size_type step) noexcept {
+			return (group + step) & (kGroupCount - 1);
+		}
+
+		constexpr size_type FindIndex(Key const& key) const {
+			std::uint64_t h = HashOf(key);
+			Control h2 = H2(h);
+			size_type group = H1(h);
+			for (size_type step = 1; step <= kGroupCount; ++step) {
+				for (std::uint32_t mask = Match(group, h2); mask != 0; mask &= mask - 1) {
+					size_type idx = group * kGroupWidth + static_cast<size_type>(std::countr_zero(mask));
+					if (m_equal(m_slots[idx].value.first, key)) {
+						return idx;
+					}
+				}
+				if (Match(group, kEmpty) != 0) {
+					break;
+				}
+				group = NextGroup(group, step);
+			}
+			return kCapacity;
+		}
+
+		/// First empty or deleted slot on the probe sequence of `h`. One always exists below TableSize elements.
+		constexpr size_type FindInsertSlot(std::uint64_t h) const noexcept {
+			size_type group = H1(h);
+			for (size_type step = 1; ; ++step) {
+				if (std::uint32_t mask = MatchNonFull(group); mask != 0) {
+					return group * kGroupWidth + static_cast<size_type>(std::countr_zero(mask));
+				}
+				group = NextGroup(group, step);
+			}
+		}
+
+		template <class... Args>
+		constexpr void ConstructSlot(size_type idx, Args&&... args) {
+			std::construct_at(&m_slots[idx].value, std::forward<Args>(args)...);
+		}
+
+		constexpr void DestroySlot(size_type idx) noexcept {
+			std::destroy_at(&m_slots[idx].value);
+			std::construct_at(&m_slots[idx].vacant);
+		}
+
+		constexpr void SwapSlots(size_type a, size_type b) {
+			value_type tmp(std::move(m_slots[a].value));
+			DestroySlot(a);
+			ConstructSlot(a, std::move(m_slots[b].value));
+			DestroySlot(b);
+			ConstructSlot(b, std::move(tmp));
+		}
+
+		/**
+		 * @brief Drops every tombstone without extra storage.
+		 *
+		 * Tombstones become empty and live elements are marked deleted, meaning
+		 * "not yet placed". Each marked element then moves to the first free
+		 * slot of its probe sequence, swapping with a marked element that is
+		 * still in the way, or stays put if it already sits in that group.
+		 */
+		constexpr void RehashInPlace() {
+			for (Control& c : m_ctrl) {
+				c = IsFull(c) ? kDeleted : kEmpty;
+			}
+			m_deleted = 0;
+			for (size_type i = 0; i < kCapacity; ++i) {
+				if (m_ctrl[i] != kDeleted) {
+					continue;
+				}
+				std::uint64_t h = HashOf(m_slots[i].value.first);
+				size_type target = FindInsertSlot(h);
+				if (target / kGroupWidth == i / kGroupWidth) {
+					m_ctrl[i] = H2(h);
+				}
+				else if (m_ctrl[target] == kEmpty) {
+					ConstructSlot(target, std::move(m_slots[i].value));
+					DestroySlot(i);
+					m_ctrl[target] = H2(h);
+					m_ctrl[i] = kEmpty;
+				}
+				else {
+					SwapSlots(i, target);
+					m_ctrl[target] = H2(h);
+					--i;	// the element swapped into i still has to be placed
+				}
+			}
+		}
+
+		template <class K, class V>
+		constexpr std::pair<size_type, bool> InsertImpl(K&& key, V&& value) {
+			if (size_type idx = FindIndex(key); idx != kCapacity) {
+				m_slots[idx].value.second = std::forward<V>(value);
+				return { idx, false };
+			}
+			if (m_size >= TableSize) {
+				return { kCapacity, false };	// table full
+			}
+			std::uint64_t h = HashOf(key);
+			size_type target = FindInsertSlot(h);
+			if (m_ctrl[target] == kEmpty && m_deleted != 0 && m_size + m_deleted >= kMaxLoad) {
+				RehashInPlace();
+				target = FindInsertSlot(h);
+			}
+			if (m_ctrl[target] == kDeleted) {
+				--m_deleted;
+			}
+			ConstructSlot(target, std::forward<K>(key), std::forward<V>(value));
+			m_ctrl[target] = H2(h);
+			++m_size;
+			return { target, true };
+		}
+
+		constexpr void EraseAt(size_type idx) {
+			DestroySlot(idx);
+			--m_size;
+			// A group that still has an empty slot has never been full, so no
+			// probe sequence continues past it and the slot can become empty.
+			if (Match(idx / kGroupWidth, kEmpty) != 0) {
+				m_ctrl[idx] = kEmpty;
+			}
+			else {
+				m_ctrl[idx] = kDeleted;
+				++m_deleted;
+			}
+		}
+
+		constexpr void CopyFrom(StaticSwissTable const& other) {
+			m_ctrl = other.m_ctrl;
+			for (size_type i = 0; i < kCapacity; ++i) {
+				if (IsFull(m_ctrl[i])) {
+					ConstructSlot(i, other.m_slots[i].value);
+				}
+			}
+			m_size = other.m_size;
+			m_deleted = other.m_deleted;
+		}
+
+		constexpr void MoveFrom(StaticSwissTable& other) {
+			m_ctrl = other.m_ctrl;
+			for (size_type i = 0; i < kCapacity; ++i) {
+				if (IsFull(m_ctrl[i])) {
+					ConstructSlot(i, std::move(other.m_slots[i].value));
+				}
+			}
+			m_size = other.m_size;
+			m_deleted = other.m_deleted;
+			other.clear();
+		}
+
+	public:
+		template <bool IsConst>
+		class BasicIterator {
+			friend class StaticSwissTable;
+		private:
+			using TablePtr = std::conditional_t<IsConst, StaticSwissTable const*, StaticSwissTable*>;
+			TablePtr m_table = nullptr;
+			size_type m_index = 0;
+
+			constexpr BasicIterator(TablePtr table, size_type index) noexcept
+				: m_table(table), m_index(index) {}
+
+			constexpr void SkipToFull() noexcept {
+				while (m_index < kCapacity && !IsFull(m_table->m_ctrl[m_index])) {
+					++m_index;
+				}
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = StaticSwissTable::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, value_type const*, value_type*>;
+			using reference = std::conditional_t<IsConst, value_type const&, value_type&>;
+
+			constexpr BasicIterator() = default;
+
+			template <bool OtherConst>
+				requires (IsConst && !OtherConst)
+			constexpr BasicIterator(BasicIterator<OtherConst> const& other) noexcept
+				: m_table(other.m_table), m_index(other.m_index) {}
+
+			constexpr reference operator*() const noexcept {
+				return m_table->m_slots[m_index].value;
+			}
+			constexpr pointer operator->() const noexcept {
+				return &m_table->m_slots[m_index].value;
+			}
+
+			constexpr BasicIterator& operator++() noexcept {
+				++m_index;
+				SkipToFull();
+				return *this;
+			}
+			constexpr BasicIterator operator++(int) noexcept {
+				BasicIterator tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			friend constexpr bool operator==(BasicIterator const& a, BasicIterator const& b) noexcept {
+				return a.m_index == b.m_index;
+			}
+		};
+
+		using iterator = BasicIterator<false>;
+		using const_iterator = BasicIterator<true>;
+
+		// constructors
+		constexpr StaticSwissTable() {
+			m_ctrl.fill(kEmpty);
+		}
+
+		constexpr StaticSwissTable(Hash const& hf, Equal const& eqf)
+			: m_hasher(hf), m_equal(eqf) {
+			m_ctrl.fill(kEmpty);
+		}
+
+		constexpr StaticSwissTable(StaticSwissTable const& other)
+			: m_hasher(other.m_hasher), m_equal(other.m_equal) {
+			CopyFrom(other);
+		}
+
+		constexpr StaticSwissTable(StaticSwissTable&& other)
+			: m_hasher(other.m_hasher), m_equal(other.m_equal) {
+			MoveFrom(other);
+		}
+
+		constexpr StaticSwissTable& operator=(StaticSwissTable const& other) {
+			if (this != &other) {
+				clear();
+				m_hasher = other.m_hasher;
+				m_equal = other.m_equal;
+				CopyFrom(other);
+			}
+			return *this;
+		}
+
+		constexpr StaticSwissTable& operator=(StaticSwissTable&& other) {
+			if (this != &other) {
+				clear();
+				m_hasher = other.m_hasher;
+				m_equal = other.m_equal;
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		constexpr ~StaticSwissTable() requires std::is_trivially_destructible_v<value_type> = default;
+		constexpr ~StaticSwissTable() {
+			clear();
+		}
+
+		// capacity
+		constexpr size_type size() const noexcept { return m_size; }
+		constexpr bool empty() const noexcept { return m_size == 0; }
+		static constexpr size_type max_size() noexcept { return TableSize; }
+		static constexpr size_type capacity() noexcept { return kCapacity; }
+
+		// iterators
+		constexpr iterator begin() noexcept {
+			iterator it(this, 0);
+			it.SkipToFull();
+			return it;
+		}
+		constexpr const_iterator begin() const noexcept {
+			const_iterator it(this, 0);
+			it.SkipToFull();
+			return it;
+		}
+		constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+		constexpr iterator end() noexcept { return iterator(this, kCapacity); }
+		constexpr const_iterator end() const noexcept { return const_iterator(this, kCapacity); }
+		constexpr const_iterator cend() const noexcept { return end(); }
+
+		// lookup
+		constexpr iterator find(key_type const& key) {
+			return iterator(this, FindIndex(key));
+		}
+		constexpr const_iterator find(key_type const& key) const {
+			return const_iterator(this, FindIndex(key));
+		}
+
+		constexpr size_type count(key_type const& key) const {
+			return FindIndex(key) != kCapacity ? 1 : 0;
+		}
+		constexpr bool contains(key_type const& key) const {
+			return FindIndex(key) != kCapacity;
+		}
+
+		// insert / emplace
+		constexpr std::pair<iterator, bool> insert(value_type const& value) {
+			auto [idx, inserted] = InsertImpl(value.first, value.second);
+			return { iterator(this, idx), inserted };
+		}
+		constexpr std::pair<iterator, bool> insert(value_type&& value) {
+			auto [idx, inserted] = InsertImpl(std::move(value.first), std::move(value.second));
+			return { iterator(this, idx), inserted };
+		}
+		template <class P>
+		constexpr std::pair<iterator, bool> insert(P&& value) {
+			auto [idx, inserted] = InsertImpl(std::forward<P>(value).first, std::forward<P>(value).second);
+			return { iterator(this, idx), inserted };
+		}
+
+		template <class... Args>
+		constexpr std::pair<iterator, bool> emplace(Args&&... args) {
+			value_type val(std::forward<Args>(args)...);
+			return insert(std::move(val));
+		}
+
+		template <class... Args>
+		constexpr std::pair<iterator, bool> try_emplace(key_type const& k, Args&&... args) {
+			auto [idx, inserted] = InsertImpl(k, mapped_type(std::forward<Args>(args)...));
+			return { iterator(this, idx), inserted };
+		}
+		template <class... Args>
+		constexpr std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) {
+			auto [idx, inserted] = InsertImpl(std::move(k), mapped_type(std::forward<Args>(args)...));
+			return { iterator(this, idx), inserted };
+		}
+
+		// element access
+		constexpr mapped_type& operator[](key_type const& key) {
+			size_type idx = FindIndex(key);
+			if (idx == kCapacity) {
+				idx = InsertImpl(key, mapped_type{}).first;
+			}
+			return m_slots[idx].value.second;
+		}
+		constexpr mapped_type& operator[](key_type&& key) {
+			size_type idx = FindIndex(key);
+			if (idx == kCapacity) {
+				idx = InsertImpl(std::move(key), mapped_type{}).first;
+			}
+			return m_slots[idx].value.second;
+		}
+
+		constexpr mapped_type& at(key_type const& key) {
+			size_type idx = FindIndex(key);
+			if (idx == kCapacity) {
+				throw std::out_of_range("StaticSwissTable::at: key not found");
+			}
+			return m_slots[idx].value.second;
+		}
+		constexpr mapped_type const& at(key_type const& key) const {
+			size_type idx = FindIndex(key);
+			if (idx == kCapacity) {
+				throw std::out_of_range("StaticSwissTable::at: key not found");
+			}
+			return m_slots[idx].value.second;
+		}
+
+		// erase
+		constexpr size_type erase(key_type const& key) {
+			size_type idx = FindIndex(key);
+			if (idx == kCapacity) {
+				return 0;
+			}
+			EraseAt(idx);
+			return 1;
+		}
+
+		constexpr iterator erase(iterator pos) {
+			if (pos == end()) {
+				return end();
+			}
+			EraseAt(pos.m_index);
+			++pos;
+			return pos;
+		}
+
+		constexpr iterator erase(const_iterator pos) {
+			return erase(iterator(this, pos.m_index));
+		}
+
+		// clear
+		constexpr void clear() noexcept {
+			for (size_type i = 0; i < kCapacity; ++i) {
+				if (IsFull(m_ctrl[i])) {
+					DestroySlot(i);
+				}
+				m_ctrl[i] = kEmpty;
+			}
+			m_size = 0;
+			m_deleted = 0;
+		}
+
+		// hash and equality policy
+		constexpr hasher hash_function() const { return m_hasher; }
+		constexpr key_equal key_eq() const { return m_equal; }
+	};
+
+	/**
+	 * @brief Immutable map over a key set fixed at construction, answering every lookup with one probe.
+	 *
+	 * Built by hash and displace: keys are split into N buckets by their hash,
+	 * and each bucket, largest first, searches for a seed that sends all of its
+	 * keys to free slots of a power-of-two slot table. A lookup hashes the key
+	 * once, reads its bucket's seed, rehashes into the slot table and compares
+	 * a single key, so there is no probe loop and a miss costs the same as a
+	 * hit.
+	 *
+	 * Construction is meant for constant evaluation. Duplicate keys, or a key
+	 * set no seed can place, throw, which turns a constexpr map into a compile
+	 * error instead of a table that silently drops entries.
+	 */
+	export template <
+		class Key, class Value, std::size_t N,
+		class Hash = ConstexprHasher<Key>,
+		class Equal = std::equal_to<Key>
+	> class PerfectHashMap {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<Key, Value>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using hasher = Hash;
+		using key_equal = Equal;
+		using const_reference = value_type const&;
+		using const_iterator = value_type const*;
+		using iterator = const_iterator;
+
+		static_assert(N > 0, "PerfectHashMap needs at least one entry");
+
+	private:
+		using Index = std::conditional_t<(N < 0xFF), std::uint8_t,
+			std::conditional_t<(N < 0xFFFF), std::uint16_t, std::uint32_t>>;
+		using Seed = std::uint16_t;
+
+		static constexpr size_type kBucketCount = N;
+		static constexpr size_type kSlotCount = std::bit_ceil(N + N / 4 + 1);
+		static constexpr Index kNoEntry = static_cast<Index>(N);
+
+		std::array<value_type, N> m_entries;
+		std::array<Seed, kBucketCount> m_seeds{};
+		std::array<Index, kSlotCount> m_index{};
+		[[no_unique_address]] Hash m_hasher;
+		[[no_unique_address]] Equal m_equal;
+
+		constexpr std::uint64_t HashOf(Key const& key) const {
+			return MixHash(static_cast<std::uint64_t>(m_hasher(key)));
+		}
+
+		static constexpr size_type BucketOf(std::uint64_t h) noexcept {
+			// Maps the high half onto [0, N) with a multiply instead of a division.
+			return static_cast<size_type>(((h >> 32) * kBucketCount) >> 32);
+		}
+
+		static constexpr size_type SlotOf(std::uint64_t h, Seed seed) noexcept {
+			return static_cast<size_type>(MixHash(h ^ ((seed + 1ull) * 0x9E3779B97F4A7C15ull)) & (kSlotCount - 1));
+		}
+
+		constexpr void Build() {
+			std::array<std::uint64_t, N> hashes{};
+			std::array<size_type, kBucketCount + 1> bucket_begin{};
+			for (size_type i = 0; i < N; ++i) {
+				hashes[i] = HashOf(m_entries[i].first);
+				++bucket_begin[BucketOf(hashes[i]) + 1];
+			}
+			for (size_type b = 0; b < kBucketCount; ++b) {
+				bucket_begin[b + 1] += bucket_begin[b];
+			}
+
+			// Entry indices grouped by bucket.
+			std::array<size_type, N> members{};
+			std::array<size_type, kBucketCount> fill{};
+			for (size_type i = 0; i < N; ++i) {
+				size_type b = BucketOf(hashes[i]);
+				members[bucket_begin[b] + fill[b]++] = i;
+			}
+
+			std::array<size_type, kBucketCount> order{};
+			for (size_type b = 0; b < kBucketCount; ++b) {
+				order[b] = b;
+			}
+			std::sort(order.begin(), order.end(),
+				[&](size_type lhs, size_type rhs) {
+					return fill[lhs] != fill[rhs] ? fill[lhs] > fill[rhs] : lhs < rhs;
+				});
+
+			m_index.fill(kNoEntry);
+			for (size_type b : order) {
+				size_type first = bucket_begin[b];
+				size_type last = bucket_begin[b + 1];
+				if (first == last) {
+					break;
+				}
+
+				for (size_type i = first; i < last; ++i) {
+					for (size_type j = i + 1; j < last; ++j) {
+						if (hashes[members[i]] == hashes[members[j]] &&
+							m_equal(m_entries[members[i]].first, m_entries[members[j]].first)) {
+							throw std::invalid_argument("PerfectHashMap: duplicate key");
+						}
+					}
+				}
+
+				bool placed = false;
+				for (std::uint32_t seed = 0; !placed && seed <= std::numeric_limits<Seed>::max(); ++seed) {
+					size_type i = first;
+					for (; i < last; ++i) {
+						size_type slot = SlotOf(hashes[members[i]], static_cast<Seed>(seed));
+						if (m_index[slot] != kNoEntry) {
+							break;
+						}
+						m_index[slot] = static_cast<Index>(members[i]);
+					}
+					if (i == last) {
+						m_seeds[b] = static_cast<Seed>(seed);
+						placed = true;
+					}
+					else {
+						// Undo the partial placement before trying the next seed.
+						while (i-- > first) {
+							m_index[SlotOf(hashes[members[i]], static_cast<Seed>(seed))] = kNoEntry;
+						}
+					}
+				}
+				if (!placed) {
+					throw std::logic_error("PerfectHashMap: no seed places a bucket");
+				}
+			}
+		}
+
+	public:
+		constexpr explicit PerfectHashMap(std::array<value_type, N> const& entries, Hash const& hf = Hash(), Equal const& eqf = Equal())
+			: m_entries(entries), m_hasher(hf), m_equal(eqf) {
+			Build();
+		}
+
+		// capacity
+		static constexpr size_type size() noexcept { return N; }
+		static constexpr bool empty() noexcept { return false; }
+
+		// iterators, in construction order
+		constexpr const_iterator begin() const noexcept { return m_entries.data(); }
+		constexpr const_iterator end() const noexcept { return m_entries.data() + N; }
+		constexpr const_iterator cbegin() const noexcept { return begin(); }
+		constexpr const_iterator cend() const noexcept { return end(); }
+
+		// lookup
+		constexpr const_iterator find(key_type const& key) const {
+			std::uint64_t h = HashOf(key);
+			Index idx = m_index[SlotOf(h, m_seeds[BucketOf(h)])];
+			if (idx != kNoEntry && m_equal(m_entries[idx].first, key)) {
+				return m_entries.data() + idx;
+			}
+			return end();
+		}
+
+		constexpr size_type count(key_type const& key) const {
+			return find(key) != end() ? 1 : 0;
+		}
+		constexpr bool contains(key_type const& key) const {
+			return find(key) != end();
+		}
+
+		constexpr mapped_type const& at(key_type const& key) const {
+			auto it = find(key);
+			if (it == end()) {
+				throw std::out_of_range("PerfectHashMap::at: key not found");
+			}
+			return it->second;
+		}
+
+		// hash and equality policy
+		constexpr hasher hash_function() const { return m_hasher; }
+		constexpr key_equal key_eq() const { return m_equal; }
+	};
+
+	/**
+	 * @brief Builds a PerfectHashMap from a braced list, deducing its size.
+	 *
+	 * @code
+	 * constexpr auto kStages = MakePerfectHashMap<std::string_view, Stage>({
+	 *     { "vertex", Stage::Vertex },
+	 *     { "fragment", Stage::Fragment },
+	 * });
+	 * @endcode
+	 */
+	export template <class Key, class Value, class Hash = ConstexprHasher<Key>, class Equal = std::equal_to<Key>, std::size_t N>
+	constexpr PerfectHashMap<Key, Value, N, Hash, Equal> MakePerfectHashMap(std::pair<Key, Value> const (&entries)[N]) {
+		return PerfectHashMap<Key, Value, N, Hash, Equal>(std::to_array(entries));
+	}
+
 }
@@ -60,30 +60,13 @@ namespace plastic::ds {
 			std::size_t new_idx = AllocateNode();
 			if (new_idx == Capacity) return Capacity;
 			m_nodes[new_idx].value.emplace(std::forward<Args>(args)...);
-			if (prev_idx == Capacity) {
-				// empty list
-				m_nodes[new_idx].prev = Capacity;
-				m_nodes[new_idx].next = Capacity;
-				m_head = new_idx;
-				m_tail = new_idx;
-			}
-			else {
-				std::size_t next_idx = m_nodes[prev_idx].next;
-				m_nodes[new_idx].prev = prev_idx;
-				m_nodes[new_idx].next = next_idx;
-				m_nodes[prev_idx].next = new_idx;
-				if (next_idx != Capacity) {
-					m_nodes[next_idx].prev = new_idx;
-				}
-				else {
-					m_tail = new_idx;
-				}
-			}
+			LinkBefore(new_idx, prev_idx == Capacity ? m_head : m_nodes[prev_idx].next);
 			++m_size;
 			return new_idx;
 		}
 
-		constexpr void EraseNode(std::size_t idx) noexcept {
+		// Detach a node from the list without returning it to the free list
+		constexpr void UnlinkNode(std::size_t idx) noexcept {
 			std::size_t prev_idx = m_nodes[idx].prev;
 			std::size_t next_idx = m_nodes[idx].next;
 			if (prev_idx != Capacity) {
@@ -98,6 +81,29 @@ namespace plastic::ds {
 			else {
 				m_tail = prev_idx;
 			}
+		}
+
+		// Attach a detached node in front of next_idx (next_idx == Capacity means append)
+		constexpr void LinkBefore(std::size_t idx, std::size_t next_idx) noexcept {
+			std::size_t prev_idx = next_idx == Capacity ? m_tail : m_nodes[next_idx].prev;
+			m_nodes[idx].prev = prev_idx;
+			m_nodes[idx].next = next_idx;
+			if (prev_idx != Capacity) {
+				m_nodes[prev_idx].next = idx;
+			}
+			else {
+				m_head = idx;
+			}
+			if (next_idx != Capacity) {
+				m_nodes[next_idx].prev = idx;
+			}
+			else {
+				m_tail = idx;
+			}
+		}
+
+		constexpr void EraseNode(std::size_t idx) noexcept {
+			UnlinkNode(idx);
 			DeallocateNode(idx);
 			--m_size;
 		}
@@ -279,10 +285,19 @@ namespace plastic::ds {
 			if (pos == end()) return end();
 			Node const* pos_node = pos.m_ptr;
 			std::size_t idx = static_cast<std::size_t>(pos_node - m_nodes.data());
-			iterator next = pos;
-			++next;
+			std::size_t next_idx = m_nodes[idx].next;
 			EraseNode(idx);
-			return next;
+			return next_idx == Capacity ? end() : iterator(&m_nodes[next_idx], this);
+		}
+
+		// splice: relink the node at `it` in front of `pos`, iterators stay valid
+		constexpr void splice(const_iterator pos, const_iterator it) noexcept {
+			if (it == end() || it == pos) return;
+			std::size_t idx = static_cast<std::size_t>(it.m_ptr - m_nodes.data());
+			std::size_t next_idx = pos == end() ? Capacity : static_cast<std::size_t>(pos.m_ptr - m_nodes.data());
+			if (m_nodes[idx].next == next_idx) return;
+			UnlinkNode(idx);
+			LinkBefore(idx, next_idx);
 		}
 
 		// clear
@@ -0,0 +1,464 @@
+// ============================================================================
+// small_vector.cppm - Module interface for a vector with inline storage
+// ============================================================================
+//
+// This module provides SmallVector, a std::vector work-alike that keeps its
+// first N elements inside the object itself. Collections that almost always
+// hold a handful of elements (descriptor set layouts, binding tables) then
+// need no heap allocation, sit next to their owner in memory and are cheap
+// to copy. Once the size exceeds N the elements move to the heap and the
+// container behaves like an ordinary vector.
+
+module;
+#include <version>
+#include <cassert>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#endif // !defined(__cpp_lib_modules)
+export module plastic.small_vector;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace plastic::ds {
+
+	/**
+	 * @brief Contiguous growable array with inline capacity N.
+	 *
+	 * Iterators are plain pointers. Unlike std::vector, moving a SmallVector
+	 * whose elements are inline moves the elements one by one and leaves the
+	 * source empty, so iterators into the source do not survive a move.
+	 */
+	export template <class T, std::size_t N> class SmallVector {
+		static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using const_reference = T const&;
+		using pointer = T*;
+		using const_pointer = T const*;
+		using iterator = T*;
+		using const_iterator = T const*;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		static constexpr size_type inline_capacity = N;
+
+	private:
+		T* m_data;
+		size_type m_size = 0;
+		size_type m_capacity = N;
+		alignas(T) std::byte m_inline[sizeof(T) * N];
+
+		T* InlineData() noexcept {
+			return reinterpret_cast<T*>(m_inline);
+		}
+
+		bool IsInline() const noexcept {
+			return m_data == reinterpret_cast<T const*>(m_inline);
+		}
+
+		/// Moves elements when that cannot throw, copies otherwise (as std::vector does).
+		static void Relocate(T* first, T* last, T* destination) {
+			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+				std::uninitialized_move(first, last, destination);
+			}
+			else {
+				std::uninitialized_copy(first, last, destination);
+			}
+		}
+
+		void ReleaseStorage() noexcept {
+			if (!IsInline()) {
+				std::allocator<T>().deallocate(m_data, m_capacity);
+			}
+			m_data = InlineData();
+			m_capacity = N;
+		}
+
+		size_type GrowthFor(size_type required) const {
+			if (required > max_size()) {
+				throw std::length_error("SmallVector is too long");
+			}
+			return std::max(required, m_capacity + m_capacity / 2);
+		}
+
+		/// Moves the elements into a buffer of exactly `capacity` elements.
+		void Reallocate(size_type capacity) {
+			T* storage = std::allocator<T>().allocate(capacity);
+			try {
+				Relocate(m_data, m_data + m_size, storage);
+			}
+			catch (...) {
+				std::allocator<T>().deallocate(storage, capacity);
+				throw;
+			}
+			std::destroy(m_data, m_data + m_size);
+			ReleaseStorage();
+			m_data = storage;
+			m_capacity = capacity;
+		}
+
+		/// Appends when full. The new element is built first, as `args` may refer into the vector.
+		template <class... Args> T& EmplaceBackSlow(Args&&... args) {
+			size_type capacity = GrowthFor(m_size + 1);
+			T* storage = std::allocator<T>().allocate(capacity);
+			T* element = storage + m_size;
+			try {
+				std::construct_at(element, std::forward<Args>(args)...);
+				try {
+					Relocate(m_data, m_data + m_size, storage);
+				}
+				catch (...) {
+					std::destroy_at(element);
+					throw;
+				}
+			}
+			catch (...) {
+				std::allocator<T>().deallocate(storage, capacity);
+				throw;
+			}
+			std::destroy(m_data, m_data + m_size);
+			ReleaseStorage();
+			m_data = storage;
+			m_capacity = capacity;
+			++m_size;
+			return *element;
+		}
+
+		/// Takes over `other`'s heap buffer, or moves its inline elements.
+		void MoveFrom(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+			if (other.IsInline()) {
+				std::uninitialized_move(other.m_data, other.m_data + other.m_size, m_data);
+				m_size = other.m_size;
+				other.clear();
+			}
+			else {
+				m_data = std::exchange(other.m_data, other.InlineData());
+				m_size = std::exchange(other.m_size, 0);
+				m_capacity = std::exchange(other.m_capacity, N);
+			}
+		}
+
+	public:
+		SmallVector() noexcept
+			: m_data(InlineData()) {
+		}
+
+		explicit SmallVector(size_type count)
+			: SmallVector() {
+			resize(count);
+		}
+
+		SmallVector(size_type count, T const& value)
+			: SmallVector() {
+			resize(count, value);
+		}
+
+		template <std::input_iterator It>
+		SmallVector(It first, It last)
+			: SmallVector() {
+			assign(first, last);
+		}
+
+		SmallVector(std::initializer_list<T> values)
+			: SmallVector(values.begin(), values.end()) {
+		}
+
+		SmallVector(SmallVector const& other)
+			: SmallVector(other.begin(), other.end()) {
+		}
+
+		SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: SmallVector() {
+			MoveFrom(other);
+		}
+
+		~SmallVector() {
+			clear();
+			ReleaseStorage();
+		}
+
+		SmallVector& operator=(SmallVector const& other) {
+			if (this != &other) {
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+			if (this != &other) {
+				clear();
+				ReleaseStorage();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+
+		SmallVector& operator=(std::initializer_list<T> values) {
+			assign(values.begin(), values.end());
+			return *this;
+		}
+
+		template <std::input_iterator It> void assign(It first, It last) {
+			clear();
+			if constexpr (std::forward_iterator<It>) {
+				reserve(static_cast<size_type>(std::distance(first, last)));
+			}
+			for (; first != last; ++first) {
+				emplace_back(*first);
+			}
+		}
+
+		// Element access
+
+		reference operator[](size_type index) noexcept {
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+		const_reference operator[](size_type index) const noexcept {
+			assert(index < m_size);
+			return m_data[index];
+		}
+
+		reference at(size_type index) {
+			if (index >= m_size) {
+				throw std::out_of_range("SmallVector index out of range");
+			}
+			return m_data[index];
+		}
+
+		const_reference at(size_type index) const {
+			if (index >= m_size) {
+				throw std::out_of_range("SmallVector index out of range");
+			}
+			return m_data[index];
+		}
+
+		reference front() noexcept {
+			return (*this)[0];
+		}
+
+		const_reference front() const noexcept {
+			return (*this)[0];
+		}
+
+		reference back() noexcept {
+			return (*this)[m_size - 1];
+		}
+
+		const_reference back() const noexcept {
+			return (*this)[m_size - 1];
+		}
+
+		T* data() noexcept {
+			return m_data;
+		}
+
+		T const* data() const noexcept {
+			return m_data;
+		}
+
+		// Iterators
+
+		iterator begin() noexcept {
+			return m_data;
+		}
+
+		const_iterator begin() const noexcept {
+			return m_data;
+		}
+
+		const_iterator cbegin() const noexcept {
+			return m_data;
+		}
+
+		iterator end() noexcept {
+			return m_data + m_size;
+		}
+
+		const_iterator end() const noexcept {
+			return m_data + m_size;
+		}
+
+		const_iterator cend() const noexcept {
+			return m_data + m_size;
+		}
+
+		reverse_iterator rbegin() noexcept {
+			return reverse_iterator(end());
+		}
+
+		const_reverse_iterator rbegin() const noexcept {
+			return const_reverse_iterator(end());
+		}
+
+		reverse_iterator rend() noexcept {
+			return reverse_iterator(begin());
+		}
+
+		const_reverse_iterator rend() const noexcept {
+			return const_reverse_iterator(begin());
+		}
+
+		// Capacity
+
+		[[nodiscard]] bool empty() const noexcept {
+			return m_size == 0;
+		}
+
+		size_type size() const noexcept {
+			return m_size;
+		}
+
+		size_type capacity() const noexcept {
+			return m_capacity;
+		}
+
+		static constexpr size_type max_size() noexcept {
+			return static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(T);
+		}
+
+		void reserve(size_type capacity) {
+			if (capacity > m_capacity) {
+				if (capacity > max_size()) {
+					throw std::length_error("SmallVector is too long");
+				}
+				Reallocate(capacity);
+			}
+		}
+
+		/// Moves heap elements back inline when they fit, otherwise trims the heap buffer.
+		void shrink_to_fit() {
+			if (IsInline() || m_size == m_capacity) {
+				return;
+			}
+			if (m_size <= N) {
+				T* heap = m_data;
+				size_type capacity = m_capacity;
+				Relocate(heap, heap + m_size, InlineData());
+				std::destroy(heap, heap + m_size);
+				std::allocator<T>().deallocate(heap, capacity);
+				m_data = InlineData();
+				m_capacity = N;
+			}
+			else {
+				Reallocate(m_size);
+			}
+		}
+
+		// Modifiers
+
+		void clear() noexcept {
+			std::destroy(m_data, m_data + m_size);
+			m_size = 0;
+		}
+
+		template <class... Args> reference emplace_back(Args&&... args) {
+			if (m_size == m_capacity) {
+				return EmplaceBackSlow(std::forward<Args>(args)...);
+			}
+			T* element = std::construct_at(m_data + m_size, std::forward<Args>(args)...);
+			++m_size;
+			return *element;
+		}
+
+		void push_back(T const& value) {
+			emplace_back(value);
+		}
+
+		void push_back(T&& value) {
+			emplace_back(std::move(value));
+		}
+
+		void pop_back() noexcept {
+			assert(m_size > 0);
+			std::destroy_at(m_data + --m_size);
+		}
+
+		template <class... Args> iterator emplace(const_iterator position, Args&&... args) {
+			auto index = static_cast<size_type>(position - begin());
+			assert(index <= m_size);
+			emplace_back(std::forward<Args>(args)...);
+			std::rotate(begin() + index, end() - 1, end());
+			return begin() + index;
+		}
+
+		iterator insert(const_iterator position, T const& value) {
+			return emplace(position, value);
+		}
+
+		iterator insert(const_iterator position, T&& value) {
+			return emplace(position, std::move(value));
+		}
+
+		iterator erase(const_iterator position) {
+			return erase(position, position + 1);
+		}
+
+		iterator erase(const_iterator first, const_iterator last) {
+			iterator target = begin() + (first - begin());
+			iterator source = begin() + (last - begin());
+			iterator new_end = std::move(source, end(), target);
+			std::destroy(new_end, end());
+			m_size = static_cast<size_type>(new_end - begin());
+			return target;
+		}
+
+		void resize(size_type count) {
+			if (count < m_size) {
+				erase(begin() + count, end());
+				return;
+			}
+			reserve(count);
+			std::uninitialized_value_construct(m_data + m_size, m_data + count);
+			m_size = count;
+		}
+
+		void resize(size_type count, T const& value) {
+			if (count < m_size) {
+				erase(begin() + count, end());
+				return;
+			}
+			while (m_size < count) {
+				emplace_back(value);
+			}
+		}
+
+		void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+			SmallVector temporary(std::move(other));
+			other = std::move(*this);
+			*this = std::move(temporary);
+		}
+
+		friend void swap(SmallVector& lhs, SmallVector& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+			lhs.swap(rhs);
+		}
+
+		friend bool operator==(SmallVector const& lhs, SmallVector const& rhs)
+			requires std::equality_comparable<T> {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+
+		friend auto operator<=>(SmallVector const& lhs, SmallVector const& rhs)
+			requires std::three_way_comparable<T> {
+			return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
+	};
+
+}
@@ -15,6 +15,7 @@ export module fyuu_engine:asset_base;
 #if defined(__cpp_lib_modules)
 import std;
 #endif // defined(__cpp_lib_modules)
+import :binary_configuration;
 namespace fs = std::filesystem;
 namespace fyuu_engine::asset {
 	
@@ -41,6 +42,8 @@ namespace fyuu_engine::asset {
 		*/
 	
 		fs::path conf_path;
+		// Size of the configuration file the asset was parsed from; zero for new assets.
+		std::size_t conf_bytes = 0;
 		std::atomic_size_t ref_count;
 		std::vector<AssetBase*> dependencies;
 
@@ -48,6 +51,10 @@ namespace fyuu_engine::asset {
 
 } // namespace fyuu_engine::asset
 
+// A uuid is 16 plain bytes.
+template <> struct fyuu_engine::serialization::binary::IsBytewiseSerializable<fyuu_engine::asset::AssetID>
+	: std::true_type {};
+
 export {
 	BOOST_DESCRIBE_ENUM(fyuu_engine::asset::AssetType, Invalid)
 	BOOST_DESCRIBE_STRUCT(fyuu_engine::asset::AssetBase, (), (id, type, timestamp, dependency_ids))
@@ -1,7 +1,6 @@
 module;
 #include <version>
 #if !defined(__cpp_lib_modules)
-#include <functional>
 #include <filesystem>
 #include <string_view>
 #endif // !defined(__cpp_lib_modules)
@@ -10,6 +9,7 @@ export module fyuu_engine:asset_common;
 import std;
 #endif // defined(__cpp_lib_modules)
 import :asset_base;
+import plastic.inplace_function;
 namespace fs = std::filesystem;
 
 namespace {
@@ -19,8 +19,8 @@ namespace {
 
 namespace fyuu_engine::asset {
 
-	export std::function<void(std::string_view)> Warning;
-	export std::function<void(std::string_view)> Error;
+	export plastic::ds::InplaceFunction<void(std::string_view)> Warning;
+	export plastic::ds::InplaceFunction<void(std::string_view)> Error;
 
 	export fs::path ResolveFullPath(fs::path const& path) {
 
@@ -38,4 +38,8 @@ namespace fyuu_engine::asset {
 		s_asset_dir = dir;
 	}
 
+	fs::path const& AssetRootDir() noexcept {
+		return s_asset_dir;
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,308 @@
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#include <boost/container_hash/hash.hpp>
+#include <boost/uuid.hpp>
+export module fyuu_engine:asset_graph;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import :asset_base;
+import :asset_common;
+import :managed_asset;
+import :job_system;
+import plastic.job_system;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+	// Serializes filling AssetBase::dependencies, which concurrent graph loads may race to resolve.
+	std::mutex s_resolve_mutex;
+
+}
+
+namespace fyuu_engine::asset {
+
+	/**
+	 * @brief One resolution of the transitive dependencies of an asset.
+	 *
+	 * Every reachable asset is a node, loaded by its own job on the engine
+	 * job system. Loading a node registers its dependencies as children and
+	 * starts jobs for the ones seen first, so independent branches load in
+	 * parallel. A node completes once all its children have completed, which
+	 * orders completion topologically, leaves first. Completing a node fills
+	 * AssetBase::dependencies, giving the asset one reference per dependency.
+	 * Nodes on or above a cycle never complete; that is how cycles are found
+	 * once every job has finished.
+	 */
+	class DependencyGraph {
+	private:
+		struct Node {
+			AssetID id;
+			AssetBase* asset = nullptr;
+			// The root is held by the caller; every other node holds one reference while the graph lives.
+			bool owns_reference = true;
+			std::vector<Node*> children;
+			std::vector<Node*> parents;
+			// Children that have not completed, plus one while the node itself is being expanded.
+			std::atomic_size_t pending = 1;
+			std::exception_ptr error;
+			bool completed = false;
+		};
+
+		// Guards m_nodes and the `parents` and `completed` members of every node.
+		std::mutex m_mutex;
+		std::unordered_map<AssetID, std::unique_ptr<Node>, boost::hash<AssetID>> m_nodes;
+		plastic::concurrency::JobCounter m_counter;
+
+		void Load(Node* node) {
+			try {
+				node->asset = AcquireLoaded(node->id);
+				if (!node->asset) {
+					auto location = ManifestLocationOf(node->id);
+					if (!location) {
+						throw std::invalid_argument(
+							std::format("LoadWithDependencies(): asset {} is neither loaded nor in the manifest", boost::uuids::to_string(node->id))
+						);
+					}
+					auto ops = AssetTypeOpsOf(location->second);
+					if (!ops) {
+						throw std::invalid_argument(
+							std::format("LoadWithDependencies(): asset type {} is not registered", static_cast<std::size_t>(location->second))
+						);
+					}
+					node->asset = ops->load(location->first);
+					if (node->asset->id != node->id) {
+						std::string msg = std::format("LoadWithDependencies(): manifest entry of {} is stale", boost::uuids::to_string(node->id));
+						ops->release(std::exchange(node->asset, nullptr));
+						throw std::runtime_error(msg);
+					}
+				}
+			}
+			catch (std::exception const&) {
+				node->error = std::current_exception();
+			}
+			Expand(node);
+		}
+
+		void Expand(Node* node) {
+			bool resolved = true;
+			if (node->asset && !node->error) {
+				std::lock_guard lock(s_resolve_mutex);
+				resolved = node->asset->dependencies.size() == node->asset->dependency_ids.size();
+			}
+			// A resolved asset keeps its whole subtree alive, so there is nothing below it to load.
+			if (!resolved) {
+				auto& jobs = fyuu_engine::concurrency::Jobs();
+				for (AssetID const& id : node->asset->dependency_ids) {
+					std::lock_guard lock(m_mutex);
+					auto [it, inserted] = m_nodes.try_emplace(id, nullptr);
+					if (inserted) {
+						it->second = std::make_unique<Node>();
+						it->second->id = id;
+						jobs.Submit(
+							[this, child = it->second.get()]() { Load(child); },
+							plastic::concurrency::JobPriority::Normal,
+							&m_counter
+						);
+					}
+					Node* child = it->second.get();
+					node->children.push_back(child);
+					if (!child->completed) {
+						child->parents.push_back(node);
+						node->pending.fetch_add(1u, std::memory_order::relaxed);
+					}
+				}
+			}
+			if (node->pending.fetch_sub(1u, std::memory_order::acq_rel) == 1u) {
+				Complete(node);
+			}
+		}
+
+		void Complete(Node* node) {
+			for (Node* child : node->children) {
+				if (!node->error && child->error) {
+					node->error = child->error;
+				}
+			}
+			if (!node->error && !node->children.empty()) {
+				std::lock_guard lock(s_resolve_mutex);
+				// Another load may have resolved the asset since Expand() looked at it.
+				if (node->asset->dependencies.empty()) {
+					node->asset->dependencies.reserve(node->children.size());
+					for (Node* child : node->children) {
+						child->asset->ref_count.fetch_add(1u, std::memory_order::relaxed);
+						node->asset->dependencies.push_back(child->asset);
+					}
+				}
+			}
+			std::vector<Node*> parents;
+			{
+				std::lock_guard lock(m_mutex);
+				node->completed = true;
+				parents.swap(node->parents);
+			}
+			for (Node* parent : parents) {
+				if (parent->pending.fetch_sub(1u, std::memory_order::acq_rel) == 1u) {
+					Complete(parent);
+				}
+			}
+		}
+
+		/// A cycle among the nodes that never completed, as "a -> b -> a".
+		std::string FindCycle(Node* root) const {
+			std::vector<Node*> path;
+			std::unordered_map<Node*, bool> on_path;
+			auto Visit = [&](auto&& self, Node* node) -> bool {
+				path.push_back(node);
+				on_path[node] = true;
+				for (Node* child : node->children) {
+					if (child->completed) {
+						continue;
+					}
+					auto it = on_path.find(child);
+					if (it != on_path.end() && it->second) {
+						path.push_back(child);
+						return true;
+					}
+					if (it == on_path.end() && self(self, child)) {
+						return true;
+					}
+				}
+				on_path[node] = false;
+				path.pop_back();
+				return false;
+			};
+			Visit(Visit, root);
+
+			std::string cycle;
+			auto first = std::find(path.begin(), path.end() - 1, path.back());
+			for (auto it = first; it != path.end(); ++it) {
+				if (!cycle.empty()) {
+					cycle += " -> ";
+				}
+				cycle += (*it)->asset ? (*it)->asset->conf_path.string() : boost::uuids::to_string((*it)->id);
+			}
+			return cycle;
+		}
+
+	public:
+		DependencyGraph() = default;
+		DependencyGraph(DependencyGraph const&) = delete;
+		DependencyGraph& operator=(DependencyGraph const&) = delete;
+
+		~DependencyGraph() {
+			for (auto& [id, node] : m_nodes) {
+				if (node->asset && node->owns_reference) {
+					AssetTypeOpsOf(node->asset->type)->release(node->asset);
+				}
+			}
+		}
+
+		/**
+		 * @brief Loads and resolves everything `root` depends on, blocking until done.
+		 * @throws the first error of any dependency, or std::runtime_error on a cycle.
+		 */
+		void Resolve(AssetBase* root) {
+			Node* root_node;
+			{
+				std::lock_guard lock(m_mutex);
+				auto& node = m_nodes[root->id];
+				node = std::make_unique<Node>();
+				node->id = root->id;
+				node->asset = root;
+				node->owns_reference = false;
+				root_node = node.get();
+			}
+			Expand(root_node);
+			fyuu_engine::concurrency::Jobs().Wait(m_counter);
+
+			if (!root_node->completed) {
+				throw std::runtime_error(std::format("LoadWithDependencies(): dependency cycle {}", FindCycle(root_node)));
+			}
+			if (root_node->error) {
+				std::rethrow_exception(root_node->error);
+			}
+		}
+	};
+
+	/**
+	 * @brief Loads an asset and its transitive dependencies, filling AssetBase::dependencies throughout.
+	 *
+	 * Dependencies are found by id: among the loaded assets first, then in
+	 * the manifest, so their files must have been parsed before (or listed
+	 * in a manifest passed to LoadAssetManifest()), and their types passed to
+	 * RegisterAssetType(). Each resolved asset holds a reference on each of
+	 * its dependencies until it is released itself.
+	 */
+	export template <std::derived_from<AssetBase> Derived> ManagedAsset<Derived> LoadWithDependencies(fs::path const& rel_path) {
+		ManagedAsset<Derived> root = LoadRelatively<Derived>(rel_path);
+		DependencyGraph graph;
+		graph.Resolve(root.Get());
+		return root;
+	}
+
+	export template <std::derived_from<AssetBase> Derived> auto LoadWithDependencies(fs::path const& rel_path, AsyncFlag) {
+
+		struct Awaitable {
+
+			fs::path rel_path;
+			std::optional<ManagedAsset<Derived>> result;
+			std::exception_ptr ex;
+
+			static constexpr bool await_ready() noexcept {
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> coro) {
+				fyuu_engine::concurrency::Jobs().Submit(
+					[this, coro]() {
+						try {
+							result.emplace(LoadWithDependencies<Derived>(rel_path));
+						}
+						catch (std::exception const&) {
+							ex = std::current_exception();
+						}
+
+						try {
+							coro();
+						}
+						catch (std::exception const& ex) {
+							std::string msg = std::format("LoadWithDependencies(): Unhandled exception in coroutine, {}", ex.what());
+							Error(msg);
+						}
+					}
+				);
+			}
+
+			ManagedAsset<Derived> await_resume() {
+				if (ex) {
+					std::rethrow_exception(ex);
+				}
+				return std::move(*result);
+			}
+
+		};
+
+		return Awaitable{ rel_path, std::nullopt, nullptr };
+
+	}
+
+}
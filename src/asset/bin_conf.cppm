@@ -0,0 +1,422 @@
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif // !defined(__cpp_lib_modules)
+#include <boost/describe.hpp>
+#include <boost/mp11.hpp>
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif // !defined(NOMINMAX)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif // !defined(WIN32_LEAN_AND_MEAN)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // defined(_WIN32)
+export module fyuu_engine:binary_configuration;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+
+namespace fs = std::filesystem;
+
+namespace fyuu_engine::serialization::binary {
+
+	/*
+		File layout (native byte order):
+
+		Header       fixed size, versioned, carries a hash of the schema
+		fixed        one 8-byte aligned slot per described member, in
+		             declaration order; FixedMember values are stored in
+		             place, strings, paths and vectors as an Extent
+		variable     the payloads the extents point to, each 8-byte aligned
+
+		The schema hash covers every member's name, encoding and size, so a
+		file written for another layout of the struct is rejected instead of
+		misread.
+	*/
+
+	/// Read-only view of a whole file mapped into memory.
+	class MappedFile {
+	private:
+		std::byte const* m_data = nullptr;
+		std::size_t m_size = 0;
+
+	public:
+		explicit MappedFile(fs::path const& path) {
+#if defined(_WIN32)
+			HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				throw std::runtime_error(std::format("MappedFile(): Failed to open {}", path.string()));
+			}
+			LARGE_INTEGER size{};
+			if (!GetFileSizeEx(file, &size)) {
+				CloseHandle(file);
+				throw std::runtime_error(std::format("MappedFile(): Failed to query the size of {}", path.string()));
+			}
+			m_size = static_cast<std::size_t>(size.QuadPart);
+			if (m_size != 0) {
+				HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping) {
+					m_data = static_cast<std::byte const*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					// The view keeps the mapping alive.
+					CloseHandle(mapping);
+				}
+			}
+			CloseHandle(file);
+#else
+			int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				throw std::runtime_error(std::format("MappedFile(): Failed to open {}", path.string()));
+			}
+			struct stat info{};
+			if (::fstat(fd, &info) != 0) {
+				::close(fd);
+				throw std::runtime_error(std::format("MappedFile(): Failed to query the size of {}", path.string()));
+			}
+			m_size = static_cast<std::size_t>(info.st_size);
+			if (m_size != 0) {
+				void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				m_data = data != MAP_FAILED ? static_cast<std::byte const*>(data) : nullptr;
+			}
+			::close(fd);
+#endif // defined(_WIN32)
+			if (m_size != 0 && !m_data) {
+				throw std::runtime_error(std::format("MappedFile(): Failed to map {}", path.string()));
+			}
+		}
+
+		~MappedFile() {
+			if (!m_data) {
+				return;
+			}
+#if defined(_WIN32)
+			UnmapViewOfFile(m_data);
+#else
+			::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif // defined(_WIN32)
+		}
+
+		MappedFile(MappedFile const&) = delete;
+		MappedFile& operator=(MappedFile const&) = delete;
+
+		std::span<std::byte const> Bytes() const noexcept {
+			return { m_data, m_size };
+		}
+	};
+
+	export constexpr std::uint32_t kMagic = 0x4D425946u; // "FYBM"
+	export constexpr std::uint16_t kVersion = 1u;
+
+	struct Header {
+		std::uint32_t magic;
+		std::uint16_t version;
+		std::uint16_t member_count;
+		std::uint64_t schema;
+		std::uint32_t fixed_size;
+		std::uint32_t reserved;
+		std::uint64_t file_size;
+	};
+
+	/// Location of a variable-length payload: a byte offset from the start of the file and an element count.
+	struct Extent {
+		std::uint32_t offset;
+		std::uint32_t count;
+	};
+
+	/**
+	 * @brief Opt-in for types that are written to disk byte for byte.
+	 *
+	 * Arithmetic types, enums, std::chrono durations and time points, and
+	 * std::arrays of bytewise types are admitted already. Specialize this
+	 * for other trivially copyable types that hold no addresses or handles;
+	 * a struct with a pointer, std::string_view or std::span member must
+	 * not be, as its file would hold raw addresses.
+	 */
+	export template <class T> struct IsBytewiseSerializable : std::false_type {};
+
+	template <class T> struct IsBytewise
+		: std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> || IsBytewiseSerializable<T>::value> {};
+	template <class Rep, class Period> struct IsBytewise<std::chrono::duration<Rep, Period>>
+		: IsBytewise<Rep> {};
+	template <class Clock, class Duration> struct IsBytewise<std::chrono::time_point<Clock, Duration>>
+		: IsBytewise<Duration> {};
+	template <class T, std::size_t N> struct IsBytewise<std::array<T, N>>
+		: IsBytewise<T> {};
+
+	template <class T> concept FixedMember = std::is_trivially_copyable_v<T> && IsBytewise<T>::value;
+
+	template <class T> struct IsFixedMemberVector : std::false_type {};
+	template <class T, class Allocator> struct IsFixedMemberVector<std::vector<T, Allocator>>
+		: std::bool_constant<FixedMember<T>> {};
+
+	template <class T> concept VariableMember =
+		std::same_as<T, std::string> || std::same_as<T, fs::path> || IsFixedMemberVector<T>::value;
+
+	/// Elements of a variable member as stored on disk: bytes for strings and paths.
+	template <class T> constexpr std::size_t kElementSize = 1;
+	template <class T, class Allocator> constexpr std::size_t kElementSize<std::vector<T, Allocator>> = sizeof(T);
+
+	// The members ManagedAsset persists in every format.
+	template <class T> using DescribedMembers = boost::describe::describe_members<T, boost::describe::mod_any_access>;
+
+	template <class T, class Descriptor> using MemberType =
+		std::remove_cvref_t<decltype(std::declval<T&>().*Descriptor::pointer)>;
+
+	constexpr std::size_t AlignUp(std::size_t value) noexcept {
+		return (value + 7u) & ~std::size_t{ 7u };
+	}
+
+	/// Members that are neither fixed nor variable are skipped, as the text formats skip them.
+	template <class T> constexpr std::size_t SlotSizeOf() noexcept {
+		if constexpr (FixedMember<T>) {
+			return AlignUp(sizeof(T));
+		}
+		else if constexpr (VariableMember<T>) {
+			return sizeof(Extent);
+		}
+		else {
+			return 0u;
+		}
+	}
+
+	constexpr std::uint64_t HashBytes(std::uint64_t hash, char const* bytes, std::size_t count) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	constexpr std::uint64_t HashValue(std::uint64_t hash, std::uint64_t value) noexcept {
+		for (std::size_t i = 0; i < 8; ++i) {
+			hash = (hash ^ ((value >> (i * 8)) & 0xFFu)) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	/// Compile-time layout of the fixed section of T.
+	template <class T> struct Layout {
+		using Members = DescribedMembers<T>;
+
+		static constexpr std::size_t kMemberCount = boost::mp11::mp_size<Members>::value;
+
+		static constexpr std::array<std::uint32_t, kMemberCount> kOffsets = [] {
+			std::array<std::uint32_t, kMemberCount> offsets{};
+			std::size_t index = 0;
+			std::size_t offset = 0;
+			boost::mp11::mp_for_each<Members>(
+				[&](auto desc) {
+					offsets[index++] = static_cast<std::uint32_t>(offset);
+					offset += SlotSizeOf<MemberType<T, decltype(desc)>>();
+				}
+			);
+			return offsets;
+		}();
+
+		static constexpr std::uint32_t kFixedSize = [] {
+			std::size_t size = 0;
+			boost::mp11::mp_for_each<Members>(
+				[&](auto desc) {
+					size += SlotSizeOf<MemberType<T, decltype(desc)>>();
+				}
+			);
+			return static_cast<std::uint32_t>(size);
+		}();
+
+		static constexpr std::uint64_t kSchema = [] {
+			std::uint64_t hash = 0xCBF29CE484222325ull;
+			boost::mp11::mp_for_each<Members>(
+				[&](auto desc) {
+					using Member = MemberType<T, decltype(desc)>;
+					hash = HashBytes(hash, desc.name, std::char_traits<char>::length(desc.name));
+					if constexpr (FixedMember<Member>) {
+						hash = HashValue(hash, 1u);
+						hash = HashValue(hash, sizeof(Member));
+					}
+					else if constexpr (VariableMember<Member>) {
+						hash = HashValue(hash, 2u);
+						hash = HashValue(hash, kElementSize<Member>);
+					}
+				}
+			);
+			return hash;
+		}();
+	};
+
+	/**
+	 * @brief Encodes the described members of `obj` into the binary layout.
+	 * @throws std::length_error if the result does not fit 32-bit offsets.
+	 */
+	export template <class T> std::vector<std::byte> Encode(T const& obj) {
+		using L = Layout<T>;
+		std::vector<std::byte> bytes(sizeof(Header) + L::kFixedSize);
+
+		auto Append = [&bytes](void const* data, std::size_t size, std::size_t count) {
+			std::size_t offset = AlignUp(bytes.size());
+			if (offset + size > std::numeric_limits<std::uint32_t>::max()) {
+				throw std::length_error("binary::Encode(): metadata exceeds 4 GiB");
+			}
+			bytes.resize(offset + size);
+			if (size != 0) {
+				std::memcpy(bytes.data() + offset, data, size);
+			}
+			return Extent{ static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(count) };
+		};
+
+		std::size_t index = 0;
+		boost::mp11::mp_for_each<typename L::Members>(
+			[&](auto desc) {
+				using Member = MemberType<T, decltype(desc)>;
+				auto const& value = obj.*desc.pointer;
+				std::size_t slot = sizeof(Header) + L::kOffsets[index++];
+				if constexpr (FixedMember<Member>) {
+					std::memcpy(bytes.data() + slot, &value, sizeof(Member));
+				}
+				else if constexpr (VariableMember<Member>) {
+					Extent extent;
+					if constexpr (std::same_as<Member, fs::path>) {
+						std::u8string utf8 = value.u8string();
+						extent = Append(utf8.data(), utf8.size(), utf8.size());
+					}
+					else {
+						extent = Append(value.data(), value.size() * kElementSize<Member>, value.size());
+					}
+					std::memcpy(bytes.data() + slot, &extent, sizeof(Extent));
+				}
+			}
+		);
+
+		Header header{
+			.magic = kMagic,
+			.version = kVersion,
+			.member_count = static_cast<std::uint16_t>(L::kMemberCount),
+			.schema = L::kSchema,
+			.fixed_size = L::kFixedSize,
+			.reserved = 0u,
+			.file_size = bytes.size()
+		};
+		std::memcpy(bytes.data(), &header, sizeof(Header));
+		return bytes;
+	}
+
+	/**
+	 * @brief Decodes `bytes` produced by Encode() into the described members of `obj`.
+	 *
+	 * Every member is copied straight out of its slot or extent; nothing is
+	 * parsed or looked up by name.
+	 * @throws std::runtime_error if the header, schema or an extent does not match.
+	 */
+	export template <class T> void Decode(std::span<std::byte const> bytes, T& obj) {
+		using L = Layout<T>;
+		Header header;
+		if (bytes.size() < sizeof(Header)) {
+			throw std::runtime_error("binary::Decode(): data is too small for a header");
+		}
+		std::memcpy(&header, bytes.data(), sizeof(Header));
+		if (header.magic != kMagic || header.version != kVersion) {
+			throw std::runtime_error(std::format("binary::Decode(): unsupported format, version {}", header.version));
+		}
+		if (header.schema != L::kSchema || header.fixed_size != L::kFixedSize || header.member_count != L::kMemberCount) {
+			throw std::runtime_error("binary::Decode(): data was written for a different member layout");
+		}
+		if (header.file_size != bytes.size() || bytes.size() < sizeof(Header) + L::kFixedSize) {
+			throw std::runtime_error("binary::Decode(): data is truncated");
+		}
+
+		std::size_t index = 0;
+		boost::mp11::mp_for_each<typename L::Members>(
+			[&](auto desc) {
+				using Member = MemberType<T, decltype(desc)>;
+				auto& value = obj.*desc.pointer;
+				std::byte const* slot = bytes.data() + sizeof(Header) + L::kOffsets[index++];
+				if constexpr (FixedMember<Member>) {
+					std::memcpy(&value, slot, sizeof(Member));
+				}
+				else if constexpr (VariableMember<Member>) {
+					Extent extent;
+					std::memcpy(&extent, slot, sizeof(Extent));
+					std::uint64_t size = std::uint64_t{ extent.count } * kElementSize<Member>;
+					if (extent.offset > bytes.size() || size > bytes.size() - extent.offset) {
+						throw std::runtime_error(std::format("binary::Decode(): member {} points outside the data", desc.name));
+					}
+					std::byte const* payload = bytes.data() + extent.offset;
+					if constexpr (std::same_as<Member, fs::path>) {
+						value = fs::path(std::u8string(reinterpret_cast<char8_t const*>(payload), extent.count));
+					}
+					else if constexpr (std::same_as<Member, std::string>) {
+						value.assign(reinterpret_cast<char const*>(payload), extent.count);
+					}
+					else {
+						value.resize(extent.count);
+						if (size != 0) {
+							std::memcpy(value.data(), payload, size);
+						}
+					}
+				}
+			}
+		);
+	}
+
+	/**
+	 * @brief Encodes the object and replaces the file with it.
+	 *
+	 * Writes a sibling file and renames it over `path`. On POSIX systems,
+	 * readers that have the old file mapped keep seeing it whole instead of
+	 * faulting on a truncated mapping. Windows refuses to replace a file
+	 * while a view of it is mapped; the old file is then left in place.
+	 *
+	 * @throws std::runtime_error if the file could not be written or replaced.
+	 */
+	export template <class T> void Save(T const& obj, fs::path const& path) {
+		std::vector<std::byte> bytes = Encode(obj);
+		fs::path staging = path;
+		staging += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		{
+			std::ofstream f(staging, std::ios::binary | std::ios::trunc);
+			f.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!f) {
+				std::error_code ec;
+				fs::remove(staging, ec);
+				throw std::runtime_error(std::format("binary::Save(): Failed to write {}", path.string()));
+			}
+		}
+		std::error_code ec;
+		fs::rename(staging, path, ec);
+		if (ec) {
+			std::error_code remove_ec;
+			fs::remove(staging, remove_ec);
+			throw std::runtime_error(std::format("binary::Save(): Failed to replace {}: {}", path.string(), ec.message()));
+		}
+	}
+
+	/// Maps the file and decodes it in place.
+	export template <class T> void Load(fs::path const& path, T& obj) {
+		MappedFile file(path);
+		Decode(file.Bytes(), obj);
+	}
+
+}
@@ -7,15 +7,27 @@ module;
 #include <fstream>
 #include <functional>
 #include <filesystem>
+#include <list>
+#include <mutex>
 #include <concepts>
 #include <coroutine>
 #include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #endif // !defined(__cpp_lib_modules)
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif // defined(__linux__)
 #include <boost/describe.hpp>
 #include <boost/mp11.hpp>
 #include <boost/uuid.hpp>
 #include <tbb/concurrent_hash_map.h>
-#include <tbb/task_group.h>
 #include <yaml-cpp/yaml.h>
 #include <nlohmann/json.hpp>
 export module fyuu_engine:managed_asset;
@@ -24,7 +36,11 @@ import std;
 #endif // defined(__cpp_lib_modules)
 import :asset_base;
 import :asset_common;
+import :binary_configuration;
+import :job_system;
 import :log;
+import plastic.job_system;
+import plastic.static_hash_table;
 
 namespace fs = std::filesystem;
 
@@ -32,9 +48,16 @@ namespace {
 
 	using namespace fyuu_engine::asset;
 
-	tbb::task_group s_task_group;
 	tbb::concurrent_hash_map<boost::uuids::uuid, AssetBase*> s_loaded_assets;
 
+	struct InFlightEntry {
+		void const* type = nullptr;
+		std::shared_ptr<void> flight;
+	};
+
+	// Loads in progress by PathKey(); see JoinOrStartLoad().
+	tbb::concurrent_hash_map<std::string, InFlightEntry> s_in_flight_loads;
+
 }
 
 namespace fyuu_engine::asset {
@@ -42,9 +65,335 @@ namespace fyuu_engine::asset {
 	export enum class ConfigurationType : std::uint8_t {
 		Unknown,
 		YAML,
-		JSON
+		JSON,
+		Binary
 	};
 
+	constexpr auto kConfigurationTypes = plastic::ds::MakePerfectHashMap<std::string_view, ConfigurationType>({
+		{ ".json", ConfigurationType::JSON },
+		{ ".yaml", ConfigurationType::YAML },
+		{ ".yml", ConfigurationType::YAML },
+		{ ".fybin", ConfigurationType::Binary },
+		});
+
+	ConfigurationType ConfigurationTypeOf(fs::path const& path) {
+		std::string ext = path.extension().string();
+		auto it = kConfigurationTypes.find(ext);
+		return it != kConfigurationTypes.end() ? it->second : ConfigurationType::Unknown;
+	}
+
+	/**
+	 * @brief Key of the per-path tables: the absolute, lexically normalized path of the file.
+	 *
+	 * Every spelling of one file ("./a.yaml", "x/../a.yaml", relative or
+	 * absolute) gets the same key, so they share one load and one resident
+	 * entry.
+	 */
+	std::string PathKey(fs::path const& rel_path) {
+		return fs::absolute(AssetRootDir() / rel_path).lexically_normal().generic_string();
+	}
+
+	/// 64-bit FNV-1a of a configuration file's contents.
+	std::uint64_t ContentHash(std::span<std::byte const> contents) noexcept {
+		return fyuu_engine::serialization::binary::HashBytes(
+			0xCBF29CE484222325ull,
+			reinterpret_cast<char const*>(contents.data()),
+			contents.size()
+		);
+	}
+
+}
+
+namespace {
+
+	struct ResidentPath {
+		AssetID id;
+		void const* type = nullptr;
+		ConfigurationType conf_type = ConfigurationType::Unknown;
+	};
+
+	// Resident assets by PathKey(). Entries are not removed when their asset is released;
+	// lookups check that the id is still loaded, and the next load overwrites them.
+	tbb::concurrent_hash_map<std::string, ResidentPath> s_resident_paths;
+
+	struct ManifestEntry {
+		AssetID id;
+		AssetType type = AssetType::Invalid;
+		std::uint64_t content_hash = 0;
+	};
+
+	// Every configuration file parsed so far, by PathKey(); see SaveAssetManifest().
+	tbb::concurrent_hash_map<std::string, ManifestEntry> s_manifest;
+
+	// PathKey() of the file each id was last parsed from; resolves AssetBase::dependency_ids.
+	tbb::concurrent_hash_map<AssetID, std::string> s_manifest_keys;
+
+	struct AssetTypeOps {
+		AssetBase* (*load)(std::string const& key);
+		void (*release)(AssetBase* asset) noexcept;
+	};
+
+	// Filled by RegisterAssetType(); lets dependencies be loaded and released without their static type.
+	tbb::concurrent_hash_map<AssetType, AssetTypeOps> s_asset_types;
+
+	// Unreferenced assets of a type may stay resident up to this many bytes; see SetResidencyBudget().
+	constexpr std::size_t kDefaultResidencyBudget = 64u * 1024u * 1024u;
+
+	/// An unreferenced asset kept resident, with what is needed to evict it without its static type.
+	struct ColdAsset {
+		AssetBase* asset;
+		ConfigurationType conf_type;
+		std::size_t bytes;
+		void (*evict)(AssetBase* asset, ConfigurationType conf_type) noexcept;
+	};
+
+	struct TypeResidency {
+		// Most recently released first.
+		std::list<ColdAsset> cold;
+		std::size_t cold_bytes = 0;
+		std::size_t budget = kDefaultResidencyBudget;
+		std::size_t hits = 0;
+		std::size_t misses = 0;
+		std::size_t evictions = 0;
+	};
+
+	// Guards the residency tables below. Never held while evicting, so eviction may release dependencies.
+	std::mutex s_residency_mutex;
+	std::unordered_map<AssetType, TypeResidency> s_residency;
+	std::unordered_map<AssetBase const*, std::list<ColdAsset>::iterator> s_cold_assets;
+	// Assets taken off the cold list and not yet deleted; they cannot be revived.
+	std::unordered_set<AssetBase const*> s_evicting;
+
+}
+
+namespace fyuu_engine::asset {
+
+	/// Takes an unreferenced asset back off the cold list. Fails if it is not on it (released or being evicted).
+	bool Revive(AssetBase& asset) noexcept {
+		std::lock_guard lock(s_residency_mutex);
+		auto it = s_cold_assets.find(&asset);
+		if (it == s_cold_assets.end()) {
+			return false;
+		}
+		TypeResidency& type = s_residency[asset.type];
+		type.cold_bytes -= it->second->bytes;
+		++type.hits;
+		type.cold.erase(it->second);
+		s_cold_assets.erase(it);
+		asset.ref_count.fetch_add(1u, std::memory_order::relaxed);
+		return true;
+	}
+
+	/**
+	 * @brief Takes a reference to a published asset.
+	 *
+	 * Referenced assets only need a compare-and-swap; unreferenced ones are
+	 * revived from the cold list. Fails once the asset is being evicted, or
+	 * while its last reference is still on its way to the cold list.
+	 */
+	bool TryAcquire(AssetBase& asset) noexcept {
+		std::size_t count = asset.ref_count.load(std::memory_order::relaxed);
+		while (count != 0u) {
+			if (asset.ref_count.compare_exchange_weak(count, count + 1u, std::memory_order::relaxed)) {
+				return true;
+			}
+		}
+		return Revive(asset);
+	}
+
+	/// Finds the loaded-asset entry of `asset`; false if a reload has replaced it there (or it is gone).
+	bool FindPublished(typename decltype(s_loaded_assets)::accessor& acc, AssetBase const* asset) {
+		return s_loaded_assets.find(acc, asset->id) && acc->second == asset;
+	}
+
+	/// Takes the least recently released assets of `type` off the cold list until it fits its budget.
+	void TakeOverBudget(TypeResidency& type, std::vector<ColdAsset>& victims) {
+		while (type.cold_bytes > type.budget) {
+			ColdAsset victim = type.cold.back();
+			type.cold.pop_back();
+			type.cold_bytes -= victim.bytes;
+			++type.evictions;
+			s_cold_assets.erase(victim.asset);
+			s_evicting.insert(victim.asset);
+			victims.push_back(victim);
+		}
+	}
+
+	void EvictAll(std::vector<ColdAsset> const& victims) noexcept {
+		for (ColdAsset const& victim : victims) {
+			victim.evict(victim.asset, victim.conf_type);
+		}
+	}
+
+	/**
+	 * @brief Moves an asset whose last reference was just released onto the cold list of its type.
+	 *
+	 * Evicts the least recently released assets of the type if that brings
+	 * it over budget. Copies that a reload has replaced are evicted at once.
+	 */
+	void Retire(ColdAsset const& released) {
+		std::vector<ColdAsset> victims;
+		{
+			// Holding the entry until the asset is on the cold list keeps a reload from replacing it in between.
+			typename decltype(s_loaded_assets)::accessor entry;
+			bool published = FindPublished(entry, released.asset);
+			std::lock_guard lock(s_residency_mutex);
+			TypeResidency& type = s_residency[released.asset->type];
+			if (published && released.bytes <= type.budget) {
+				type.cold.push_front(released);
+				type.cold_bytes += released.bytes;
+				s_cold_assets.emplace(released.asset, type.cold.begin());
+			}
+			else {
+				++type.evictions;
+				s_evicting.insert(released.asset);
+				victims.push_back(released);
+			}
+			TakeOverBudget(type, victims);
+		}
+		EvictAll(victims);
+	}
+
+	/// Called by an evicted asset once it can no longer be found, just before it is deleted.
+	void ForgetEvicted(AssetBase const* asset) noexcept {
+		std::lock_guard lock(s_residency_mutex);
+		s_evicting.erase(asset);
+	}
+
+	void CountResidencyMiss(AssetType type) {
+		std::lock_guard lock(s_residency_mutex);
+		++s_residency[type].misses;
+	}
+
+	/**
+	 * @brief Bytes an unreferenced asset is charged against its type's budget.
+	 *
+	 * ResidentBytes() if the asset has one. Otherwise the size of its
+	 * configuration file stands in for what it holds outside the object.
+	 */
+	template <class Derived> std::size_t ResidentBytesOf(Derived const& asset) noexcept {
+		if constexpr (requires { { asset.ResidentBytes() } -> std::convertible_to<std::size_t>; }) {
+			return asset.ResidentBytes();
+		}
+		else {
+			return sizeof(Derived) + asset.conf_bytes;
+		}
+	}
+
+	void IndexPath(std::string const& key, ResidentPath const& entry) {
+		typename decltype(s_resident_paths)::accessor acc;
+		s_resident_paths.insert(acc, key);
+		acc->second = entry;
+	}
+
+	void RecordManifest(std::string const& key, AssetID const& id, AssetType type, std::uint64_t content_hash) {
+		{
+			typename decltype(s_manifest)::accessor acc;
+			s_manifest.insert(acc, key);
+			acc->second = { id, type, content_hash };
+		}
+		typename decltype(s_manifest_keys)::accessor acc;
+		s_manifest_keys.insert(acc, id);
+		acc->second = key;
+	}
+
+	std::optional<AssetTypeOps> AssetTypeOpsOf(AssetType type) {
+		typename decltype(s_asset_types)::const_accessor acc;
+		if (!s_asset_types.find(acc, type)) {
+			return std::nullopt;
+		}
+		return acc->second;
+	}
+
+	/// Drops the references a released asset held on its resolved dependencies.
+	void ReleaseDependencies(std::vector<AssetBase*> const& dependencies) noexcept {
+		for (AssetBase* dependency : dependencies) {
+			// Only registered types are ever resolved, see LoadWithDependencies().
+			if (auto ops = AssetTypeOpsOf(dependency->type)) {
+				ops->release(dependency);
+			}
+		}
+	}
+
+	template <class Derived, class Serializer> void DeserializeMembers(Derived& asset, Serializer const& serializer) {
+		boost::mp11::mp_for_each<boost::describe::describe_members<Derived, boost::describe::mod_any_access>>(
+			[&](auto&& desc) {
+				fyuu_engine::serialization::Deserialize(desc.name, asset.*desc.pointer, serializer);
+			}
+		);
+	}
+
+	/// Asks the OS to start reading `path` into the page cache without waiting for it.
+	void ReadAhead(fs::path const& path) noexcept {
+#if defined(__linux__)
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd >= 0) {
+			::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+			::close(fd);
+		}
+#else
+		(void)path;
+#endif // defined(__linux__)
+	}
+
+	std::string ReadFile(fs::path const& path) {
+		std::ifstream f(path, std::ios::binary | std::ios::ate);
+		if (!f) {
+			throw std::invalid_argument(std::format("ReadFile(): {} does not exist", path.string()));
+		}
+		std::string contents(static_cast<std::size_t>(f.tellg()), '\0');
+		f.seekg(0);
+		f.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+		if (!f) {
+			throw std::runtime_error(std::format("ReadFile(): Failed to read {}", path.string()));
+		}
+		return contents;
+	}
+
+	/// A configuration file in memory: binary files are mapped and decoded in place, text files are read.
+	class ConfigurationData {
+	private:
+		std::string m_text;
+		std::unique_ptr<fyuu_engine::serialization::binary::MappedFile> m_mapped;
+
+	public:
+		ConfigurationData() = default;
+
+		ConfigurationData(fs::path const& path, ConfigurationType type) {
+			if (type == ConfigurationType::Binary) {
+				m_mapped = std::make_unique<fyuu_engine::serialization::binary::MappedFile>(path);
+			}
+			else {
+				m_text = ReadFile(path);
+			}
+		}
+
+		std::span<std::byte const> Bytes() const noexcept {
+			return m_mapped ? m_mapped->Bytes() : std::as_bytes(std::span(m_text));
+		}
+
+		std::string const& Text() const noexcept {
+			return m_text;
+		}
+	};
+
+	/// Parses a configuration file that was already brought into memory.
+	template <class Derived> void ParseConfiguration(ConfigurationType type, ConfigurationData const& data, Derived& asset) {
+		switch (type) {
+		case ConfigurationType::JSON:
+			DeserializeMembers(asset, nlohmann::json::parse(data.Text()));
+			break;
+		case ConfigurationType::YAML:
+			DeserializeMembers(asset, YAML::Load(data.Text()));
+			break;
+		case ConfigurationType::Binary:
+			fyuu_engine::serialization::binary::Decode(data.Bytes(), asset);
+			break;
+		default:
+			throw std::invalid_argument("ParseConfiguration(): unknown type of configuration file");
+		}
+	}
+
 	export template <std::derived_from<AssetBase> Derived> class ManagedAsset final {
 	private:
 		Derived* m_impl;
@@ -72,6 +421,10 @@ namespace fyuu_engine::asset {
 			f << j.dump(4);
 		}
 
+		void SaveBinary() const {
+			fyuu_engine::serialization::binary::Save(*m_impl, m_impl->conf_path);
+		}
+
 	public:
 		ManagedAsset(Derived* asset, ConfigurationType conf_type) noexcept
 			: m_impl(asset),
@@ -90,34 +443,54 @@ namespace fyuu_engine::asset {
 			m_conf_type(std::exchange(other.m_conf_type, ConfigurationType::Unknown)) {
 		}
 
-		~ManagedAsset() noexcept {
-			try {
-				if (m_impl->ref_count.fetch_sub(1u, std::memory_order::relaxed) == 1u) {
-				
+		/**
+		 * @brief Finalizes an evicted asset, saves it if it is still the loaded copy, then deletes it.
+		 *
+		 * A copy that a reload has replaced is never saved: its contents would
+		 * overwrite the file the live copy came from.
+		 */
+		static void Evict(AssetBase* asset, ConfigurationType conf_type) noexcept {
+			ManagedAsset evicted(static_cast<Derived*>(asset), conf_type);
+			{
+				// Holding the entry keeps a reload from publishing over the asset until it is saved and removed.
+				typename decltype(s_loaded_assets)::accessor entry;
+				bool published = FindPublished(entry, asset);
+				try {
 					if constexpr (requires{ Derived::Finalize(); }) {
-						m_impl->Finalize();
+						evicted.m_impl->Finalize();
 					}
-		
-					m_impl->timestamp = std::chrono::steady_clock::now();
-
-					switch (m_conf_type) {
-					case ConfigurationType::YAML:
-						SaveYAML();
-						break;
-					case ConfigurationType::JSON:
-						SaveJSON();
-						break;
-					default:
-						break;
+
+					if (published) {
+						evicted.SaveConfiguration();
 					}
-	
-					// Remove from global cache before deletion
-					s_loaded_assets.erase(m_impl->id);
-					delete m_impl;
+				}
+				catch (std::exception const& ex) {
+					log::Warning(ex.what());
+				}
+
+				// Remove from global cache before deletion
+				if (published) {
+					s_loaded_assets.erase(entry);
 				}
 			}
-			catch (std::exception const& ex) {
-				log::Warning(ex.what());
+			ForgetEvicted(asset);
+			auto dependencies = std::move(asset->dependencies);
+			delete std::exchange(evicted.m_impl, nullptr);
+			ReleaseDependencies(dependencies);
+		}
+
+		/// The last release keeps the asset resident on the cold list; it is evicted under budget pressure.
+		~ManagedAsset() noexcept {
+			if (!m_impl) {
+				return;
+			}
+			if (m_impl->ref_count.fetch_sub(1u, std::memory_order::acq_rel) == 1u) {
+				try {
+					Retire({ m_impl, m_conf_type, ResidentBytesOf(*m_impl), &ManagedAsset::Evict });
+				}
+				catch (std::exception const& ex) {
+					log::Warning(ex.what());
+				}
 			}
 		}
 
@@ -132,6 +505,9 @@ namespace fyuu_engine::asset {
 			case ConfigurationType::JSON:
 				SaveJSON();
 				break;
+			case ConfigurationType::Binary:
+				SaveBinary();
+				break;
 			default:
 				break;
 			}
@@ -153,6 +529,9 @@ namespace fyuu_engine::asset {
 			case ConfigurationType::JSON:
 				SaveJSON();
 				break;
+			case ConfigurationType::Binary:
+				SaveBinary();
+				break;
 			default:
 				break;
 			}
@@ -171,167 +550,539 @@ namespace fyuu_engine::asset {
 	
 	export struct AsyncFlag {};
 
-	export template <std::derived_from<AssetBase> Derived> auto LoadRelatively(fs::path const& rel_path, AsyncFlag) {
-		
-		fs::path full_path = ResolveFullPath(rel_path);
-		
+	/// Identifies Derived in the per-path tables, which are shared by all asset types.
+	template <class Derived> void const* LoadTypeTag() noexcept {
+		static constexpr char tag = 0;
+		return &tag;
+	}
+
+	/// Takes a reference to the asset resident at `key` without touching the file, if there is one.
+	template <std::derived_from<AssetBase> Derived> std::optional<ManagedAsset<Derived>> FindResident(std::string const& key) {
+		ResidentPath entry;
+		{
+			typename decltype(s_resident_paths)::const_accessor acc;
+			if (!s_resident_paths.find(acc, key) || acc->second.type != LoadTypeTag<Derived>()) {
+				return std::nullopt;
+			}
+			entry = acc->second;
+		}
+		// The accessor keeps ~ManagedAsset from erasing (and deleting) the asset under us.
+		typename decltype(s_loaded_assets)::const_accessor acc;
+		if (!s_loaded_assets.find(acc, entry.id) || !TryAcquire(*acc->second)) {
+			return std::nullopt;
+		}
+		return std::optional<ManagedAsset<Derived>>(std::in_place, static_cast<Derived*>(acc->second), entry.conf_type);
+	}
+
+	/// Takes a reference to the resident asset that `key` held when it had `content_hash`, if there is one.
+	template <std::derived_from<AssetBase> Derived> std::optional<ManagedAsset<Derived>> FindByManifest(
+		std::string const& key,
+		std::uint64_t content_hash,
+		ConfigurationType conf_type
+	) {
+		AssetID id;
+		{
+			typename decltype(s_manifest)::const_accessor acc;
+			if (!s_manifest.find(acc, key) || acc->second.content_hash != content_hash) {
+				return std::nullopt;
+			}
+			id = acc->second.id;
+		}
+		typename decltype(s_loaded_assets)::const_accessor acc;
+		if (!s_loaded_assets.find(acc, id) || !TryAcquire(*acc->second)) {
+			return std::nullopt;
+		}
+		return std::optional<ManagedAsset<Derived>>(std::in_place, static_cast<Derived*>(acc->second), conf_type);
+	}
+
+	/**
+	 * @brief Reads, parses and publishes one asset on the calling thread.
+	 *
+	 * Parsing is skipped when the file is unchanged since it was last parsed
+	 * and the asset it held is still resident.
+	 */
+	template <std::derived_from<AssetBase> Derived> ManagedAsset<Derived> LoadConfiguration(fs::path const& full_path, std::string const& key) {
+
 		if (!fs::exists(full_path)) {
 			std::string msg = std::format("LoadRelatively(): {} does not exist", full_path.string());
 			throw std::invalid_argument(msg);
 		}
 
-		struct Awaitable {
+		ConfigurationType conf_type = ConfigurationTypeOf(full_path);
+		if (conf_type == ConfigurationType::Unknown) {
+			std::string msg = std::format("LoadRelatively(): {} is an unknown type of configuration file", full_path.string());
+			throw std::invalid_argument(msg);
+		}
 
-			fs::path full_path;
-			Derived* asset;
-			ConfigurationType conf_type;
-			std::exception_ptr ex;
+		ConfigurationData contents(full_path, conf_type);
+		std::uint64_t content_hash = ContentHash(contents.Bytes());
+		if (auto resident = FindByManifest<Derived>(key, content_hash, conf_type)) {
+			IndexPath(key, { resident->Get()->id, LoadTypeTag<Derived>(), conf_type });
+			return std::move(*resident);
+		}
 
-			static constexpr bool await_ready() noexcept {
-				return false;
+		Derived* asset = new Derived{};
+
+		try {
+			ParseConfiguration(conf_type, contents, *asset);
+			asset->conf_path = full_path;
+			asset->conf_bytes = contents.Bytes().size();
+
+			typename decltype(s_loaded_assets)::accessor acc;
+			if (s_loaded_assets.insert(acc, std::make_pair(asset->id, static_cast<AssetBase*>(asset))) || !TryAcquire(*acc->second)) {
+				// New, or replacing a resident copy whose last reference is being released
+				acc->second = asset;
+				CountResidencyMiss(asset->type);
+				if constexpr (requires{ Derived::Initialize(); }) {
+					asset->Initialize();
+				}
+				asset->ref_count.fetch_add(1u, std::memory_order::relaxed);
+			}
+			else {
+				// Already exists, use existing (TryAcquire() took our reference)
+				auto existing_asset = static_cast<Derived*>(acc->second);
+				delete asset;
+				asset = existing_asset;
+				// conf_type may be mismatched, but existing asset already has correct type
 			}
+		} catch (...) {
+			delete asset;
+			throw;
+		}
 
-			void await_suspend(std::coroutine_handle<> coro) {
-				s_task_group.run(
-					[this, coro]() {
-						try {
+		RecordManifest(key, asset->id, asset->type, content_hash);
+		IndexPath(key, { asset->id, LoadTypeTag<Derived>(), conf_type });
+		return { asset, conf_type };
+	}
 
-							asset = new Derived{};
-							std::string ext = full_path.extension().string();
+	/**
+	 * @brief A load in progress, shared by every loader of the same path.
+	 *
+	 * The counter tracks the one job that performs the load. The flight keeps
+	 * its own reference to the result, so loaders that join late can still
+	 * copy it after the first loader has released the asset.
+	 */
+	template <std::derived_from<AssetBase> Derived> struct InFlightLoad {
+		plastic::concurrency::JobCounter counter;
+		std::optional<ManagedAsset<Derived>> result;
+		std::exception_ptr error;
 
-							if (ext == ".json") {
-								std::ifstream f(full_path);
-								nlohmann::json j = nlohmann::json::parse(f);
-								boost::mp11::mp_for_each<boost::describe::describe_members<Derived, boost::describe::mod_any_access>>(
-									[&](auto&& desc) {
-										fyuu_engine::serialization::Deserialize(desc.name, asset->*desc.pointer, j);
-									}
-								);
-								conf_type = ConfigurationType::JSON;
-							}
-							else if (ext == ".yaml" || ext == ".yml") {
-								YAML::Node node = YAML::LoadFile(full_path.string());
-								boost::mp11::mp_for_each<boost::describe::describe_members<Derived, boost::describe::mod_any_access>>(
-									[&](auto&& desc) {
-										fyuu_engine::serialization::Deserialize(desc.name, asset->*desc.pointer, node);
-									}
-								);
-								conf_type = ConfigurationType::YAML;
-							}
-							else {
-								std::string msg = std::format("LoadRelatively(): {} is an unknown type of configuration file", full_path.string());
-								throw std::invalid_argument(msg);
-							}
+		ManagedAsset<Derived> Result() const {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+			return *result;
+		}
+	};
 
-							// Store the asset path for later saving
-							asset->conf_path = full_path;
+	/// The in-flight load of `full_path` if one is running, without starting one.
+	template <std::derived_from<AssetBase> Derived> std::shared_ptr<InFlightLoad<Derived>> FindInFlightLoad(std::string const& key) {
+		typename decltype(s_in_flight_loads)::const_accessor acc;
+		if (!s_in_flight_loads.find(acc, key) || acc->second.type != LoadTypeTag<Derived>()) {
+			return nullptr;
+		}
+		return std::static_pointer_cast<InFlightLoad<Derived>>(acc->second.flight);
+	}
 
-							// Try to insert the asset into the cache (avoid duplicates)
-							typename decltype(s_loaded_assets)::accessor acc;
-							if (s_loaded_assets.insert(acc, std::make_pair(asset->id, static_cast<AssetBase*>(asset)))) {
-								if constexpr (requires{ Derived::Initialize(); }) {
-									asset->Initialize();
-								}
-							}
-							else {
-								// Another thread already loaded this asset; use that one instead
-								auto existing_asset = static_cast<Derived*>(acc->second);
-								delete asset;
-								asset = existing_asset;
-								conf_type = ConfigurationType::Unknown; // will be set from existing? not needed
-							}
+	/**
+	 * @brief Joins the load of `full_path` that is already running, or starts one on the job system.
+	 *
+	 * Only the first loader reads and parses the file; everyone else waits
+	 * for its counter. `key` is the PathKey() of the requested path. The
+	 * entry is removed once the load finished, so a later load of the same
+	 * path (after the asset was released) starts over.
+	 */
+	template <std::derived_from<AssetBase> Derived> std::shared_ptr<InFlightLoad<Derived>> JoinOrStartLoad(fs::path const& full_path, std::string const& key) {
+		auto flight = std::make_shared<InFlightLoad<Derived>>();
+		typename decltype(s_in_flight_loads)::accessor acc;
+		bool registered = s_in_flight_loads.insert(acc, key);
+		if (!registered && acc->second.type == LoadTypeTag<Derived>()) {
+			return std::static_pointer_cast<InFlightLoad<Derived>>(acc->second.flight);
+		}
+		if (registered) {
+			acc->second = { LoadTypeTag<Derived>(), flight };
+		}
+		// Submitted under the accessor, so nobody can join before the counter is raised.
+		fyuu_engine::concurrency::Jobs().Submit(
+			[flight, full_path, key, registered]() {
+				try {
+					flight->result.emplace(LoadConfiguration<Derived>(full_path, key));
+				}
+				catch (std::exception const&) {
+					flight->error = std::current_exception();
+				}
+				if (registered) {
+					s_in_flight_loads.erase(key);
+				}
+			},
+			plastic::concurrency::JobPriority::Normal,
+			&flight->counter
+		);
+		return flight;
+	}
 
-						}
-						catch (std::exception const&) {
-							ex = std::current_exception();
-						}
+	export template <std::derived_from<AssetBase> Derived> auto LoadRelatively(fs::path const& rel_path, AsyncFlag) {
 
-						try	{
-							coro();
-						}
-						catch (std::exception const& ex) {
-							std::string msg = std::format("LoadRelatively(): Unhandled exception in coroutine, {}", ex.what());
-							Error(msg);
-						}
+		struct Awaitable {
 
-					}
-				);
+			fs::path full_path;
+			std::string key;
+			std::optional<ManagedAsset<Derived>> resident;
+			std::shared_ptr<InFlightLoad<Derived>> flight;
+
+			/// A resident asset is returned without suspending.
+			bool await_ready() const noexcept {
+				return resident.has_value();
+			}
+
+			/// Resumes on the thread that finishes the load, or right away if it already finished.
+			bool await_suspend(std::coroutine_handle<> coro) {
+				flight = JoinOrStartLoad<Derived>(full_path, key);
+				auto awaiter = flight->counter.operator co_await();
+				return !awaiter.await_ready() && awaiter.await_suspend(coro);
 			}
 
 			ManagedAsset<Derived> await_resume() {
-				if (ex) {
-					std::rethrow_exception(ex);
+				if (resident) {
+					return std::move(*resident);
 				}
-				asset->ref_count.fetch_add(1u, std::memory_order::relaxed);
-				return { asset, conf_type };
+				return flight->Result();
 			}
 
 		};
 
-		return Awaitable{ full_path, nullptr, ConfigurationType::Unknown, nullptr };
+		std::string key = PathKey(rel_path);
+		auto resident = FindResident<Derived>(key);
+		fs::path full_path = resident ? fs::path() : ResolveFullPath(rel_path);
+		return Awaitable{ std::move(full_path), std::move(key), std::move(resident), nullptr };
 
 	}
 
 	export template <std::derived_from<AssetBase> Derived> ManagedAsset<Derived> LoadRelatively(fs::path const& rel_path) {
+		std::string key = PathKey(rel_path);
+		if (auto resident = FindResident<Derived>(key)) {
+			return std::move(*resident);
+		}
+		auto flight = JoinOrStartLoad<Derived>(ResolveFullPath(rel_path), key);
+		fyuu_engine::concurrency::Jobs().Wait(flight->counter);
+		return flight->Result();
+	}
 
-		fs::path full_path = ResolveFullPath(rel_path);
+	/// LoadRelatively() by PathKey(); the key is itself a path to the file.
+	template <std::derived_from<AssetBase> Derived> ManagedAsset<Derived> LoadKey(std::string const& key) {
+		if (auto resident = FindResident<Derived>(key)) {
+			return std::move(*resident);
+		}
+		auto flight = JoinOrStartLoad<Derived>(fs::path(key), key);
+		fyuu_engine::concurrency::Jobs().Wait(flight->counter);
+		return flight->Result();
+	}
 
-		if (!fs::exists(full_path)) {
-			std::string msg = std::format("LoadRelatively(): {} does not exist", full_path.string());
-			throw std::invalid_argument(msg);
+	/**
+	 * @brief Lets assets of `type` be loaded as dependencies of other assets.
+	 *
+	 * Dependencies are referenced only by id, so LoadWithDependencies() finds
+	 * their file in the manifest and their static type here.
+	 */
+	export template <std::derived_from<AssetBase> Derived> void RegisterAssetType(AssetType type) {
+		AssetTypeOps ops{
+			[](std::string const& key) -> AssetBase* {
+				ManagedAsset<Derived> asset = LoadKey<Derived>(key);
+				// Keep the reference past `asset`; it is given back by `release`.
+				asset.Get()->ref_count.fetch_add(1u, std::memory_order::relaxed);
+				return asset.Get();
+			},
+			[](AssetBase* asset) noexcept {
+				// Adopts the reference and drops it, so the last one runs ~ManagedAsset as usual.
+				ManagedAsset<Derived> released(static_cast<Derived*>(asset), ConfigurationTypeOf(asset->conf_path));
+			}
+		};
+		typename decltype(s_asset_types)::accessor acc;
+		s_asset_types.insert(acc, type);
+		acc->second = ops;
+	}
+
+	/// Takes a reference to asset `id` if it is loaded, whatever path it came from, and of a registered type.
+	AssetBase* AcquireLoaded(AssetID const& id) noexcept {
+		typename decltype(s_loaded_assets)::const_accessor acc;
+		if (!s_loaded_assets.find(acc, id) || !AssetTypeOpsOf(acc->second->type) || !TryAcquire(*acc->second)) {
+			return nullptr;
 		}
+		return acc->second;
+	}
 
-		Derived* asset = new Derived{};
-		ConfigurationType conf_type = ConfigurationType::Unknown;
+	/// The PathKey() of the file `id` was last parsed from, and the asset type it had.
+	std::optional<std::pair<std::string, AssetType>> ManifestLocationOf(AssetID const& id) {
+		std::string key;
+		{
+			typename decltype(s_manifest_keys)::const_accessor acc;
+			if (!s_manifest_keys.find(acc, id)) {
+				return std::nullopt;
+			}
+			key = acc->second;
+		}
+		typename decltype(s_manifest)::const_accessor acc;
+		if (!s_manifest.find(acc, key) || acc->second.id != id) {
+			return std::nullopt;
+		}
+		return std::make_pair(std::move(key), acc->second.type);
+	}
 
-		try {
-			std::string ext = full_path.extension().string();
-			if (ext == ".json") {
-				std::ifstream f(full_path);
-				nlohmann::json j = nlohmann::json::parse(f);
-				boost::mp11::mp_for_each<boost::describe::describe_members<Derived, boost::describe::mod_any_access>>(
-					[&](auto&& desc) {
-						fyuu_engine::serialization::Deserialize(desc.name, asset->*desc.pointer, j);
-					}
-				);
-				conf_type = ConfigurationType::JSON;
+	/// Outcome of one file of a LoadMany() batch: either `asset` or `error` is set.
+	export template <std::derived_from<AssetBase> Derived> struct LoadResult {
+		fs::path path;
+		std::optional<ManagedAsset<Derived>> asset;
+		std::exception_ptr error;
+	};
+
+	// Files read back to back by one I/O job; their reads are announced to the OS together.
+	constexpr std::size_t kLoadBatchSize = 16;
+
+	/**
+	 * @brief Loads many assets at once; results are in the order of `rel_paths`.
+	 *
+	 * Reading and parsing are pipelined on the engine job system: each I/O
+	 * job announces a batch of files to the OS, reads them, and hands every
+	 * file to a parse job as soon as it is in memory. The new assets are
+	 * then initialized in parallel and published to the loaded-asset table
+	 * in one pass. A file that fails to load only fails its own
+	 * LoadResult. Resident files, and files already being loaded by
+	 * LoadRelatively(), are not read again.
+	 */
+	export template <std::derived_from<AssetBase> Derived> std::vector<LoadResult<Derived>> LoadMany(std::span<fs::path const> rel_paths) {
+
+		std::size_t count = rel_paths.size();
+		std::vector<LoadResult<Derived>> results(count);
+		std::vector<std::string> keys(count);
+		std::vector<ConfigurationData> contents(count);
+		std::vector<std::uint64_t> content_hashes(count, 0);
+		std::vector<Derived*> assets(count, nullptr);
+		std::vector<ConfigurationType> types(count, ConfigurationType::Unknown);
+		std::vector<std::shared_ptr<InFlightLoad<Derived>>> joined(count);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			results[i].path = ResolveFullPath(rel_paths[i]);
+			types[i] = ConfigurationTypeOf(results[i].path);
+			keys[i] = PathKey(rel_paths[i]);
+			// Resident files, and files that another loader is already reading, are not read again.
+			if (auto resident = FindResident<Derived>(keys[i])) {
+				results[i].asset.emplace(std::move(*resident));
+			}
+			else {
+				joined[i] = FindInFlightLoad<Derived>(keys[i]);
+			}
+		}
+
+		auto& jobs = fyuu_engine::concurrency::Jobs();
+		plastic::concurrency::JobCounter counter;
+
+		auto Parse = [&](std::size_t i) {
+			try {
+				auto asset = std::make_unique<Derived>();
+				content_hashes[i] = ContentHash(contents[i].Bytes());
+				ParseConfiguration(types[i], contents[i], *asset);
+				asset->conf_path = results[i].path;
+				asset->conf_bytes = contents[i].Bytes().size();
+				assets[i] = asset.release();
 			}
-			else if (ext == ".yaml" || ext == ".yml") {
-				YAML::Node node = YAML::LoadFile(full_path.string());
-				boost::mp11::mp_for_each<boost::describe::describe_members<Derived, boost::describe::mod_any_access>>(
-					[&](auto&& desc) {
-						fyuu_engine::serialization::Deserialize(desc.name, asset->*desc.pointer, node);
+			catch (std::exception const&) {
+				results[i].error = std::current_exception();
+			}
+			contents[i] = {};
+		};
+
+		for (std::size_t first = 0; first < count; first += kLoadBatchSize) {
+			std::size_t last = std::min(count, first + kLoadBatchSize);
+			jobs.Submit(
+				[&, first, last]() {
+					for (std::size_t i = first; i < last; ++i) {
+						if (!joined[i] && !results[i].asset && types[i] != ConfigurationType::Unknown) {
+							ReadAhead(results[i].path);
+						}
 					}
-				);
-				conf_type = ConfigurationType::YAML;
+					for (std::size_t i = first; i < last; ++i) {
+						if (joined[i] || results[i].asset) {
+							continue;
+						}
+						try {
+							if (types[i] == ConfigurationType::Unknown) {
+								throw std::invalid_argument(
+									std::format("LoadMany(): {} is an unknown type of configuration file", results[i].path.string())
+								);
+							}
+							contents[i] = ConfigurationData(results[i].path, types[i]);
+						}
+						catch (std::exception const&) {
+							results[i].error = std::current_exception();
+							continue;
+						}
+						jobs.Submit([&Parse, i]() { Parse(i); }, plastic::concurrency::JobPriority::Normal, &counter);
+					}
+				},
+				plastic::concurrency::JobPriority::Normal,
+				&counter
+			);
+		}
+		jobs.Wait(counter);
+		for (std::size_t i = 0; i < count; ++i) {
+			if (joined[i]) {
+				jobs.Wait(joined[i]->counter);
 			}
-			else {
-				std::string msg = std::format("LoadRelatively(): {} is an unknown type of configuration file", full_path.string());
-				throw std::invalid_argument(msg);
+		}
+
+		// Resolve parsed assets against the loaded-asset table: copies of a resident asset are dropped,
+		// and of several copies of a new id in the batch only the first, its `owner`, is kept.
+		constexpr std::size_t kNoOwner = static_cast<std::size_t>(-1);
+		std::vector<std::size_t> owner(count, kNoOwner);
+		std::vector<std::size_t> created;
+		std::unordered_map<AssetID, std::size_t> creators;
+		for (std::size_t i = 0; i < count; ++i) {
+			if (!assets[i]) {
+				continue;
+			}
+			if (auto creator = creators.find(assets[i]->id); creator != creators.end()) {
+				delete std::exchange(assets[i], nullptr);
+				owner[i] = creator->second;
+				continue;
 			}
+			{
+				typename decltype(s_loaded_assets)::const_accessor acc;
+				if (s_loaded_assets.find(acc, assets[i]->id) && TryAcquire(*acc->second)) {
+					auto existing_asset = static_cast<Derived*>(acc->second);
+					delete assets[i];
+					assets[i] = existing_asset;
+					continue;
+				}
+			}
+			owner[i] = i;
+			created.push_back(i);
+			creators.emplace(assets[i]->id, i);
+		}
 
-			asset->conf_path = full_path;
+		// New assets are initialized before they are published, so no other loader can see one half-initialized.
+		if constexpr (requires{ Derived::Initialize(); }) {
+			jobs.ParallelFor(
+				0, created.size(),
+				[&](std::size_t k) {
+					std::size_t i = created[k];
+					try {
+						assets[i]->Initialize();
+					}
+					catch (std::exception const&) {
+						results[i].error = std::current_exception();
+					}
+				},
+				1
+			);
+		}
 
+		for (std::size_t i : created) {
+			if (results[i].error) {
+				delete std::exchange(assets[i], nullptr);
+				continue;
+			}
 			typename decltype(s_loaded_assets)::accessor acc;
-			if (s_loaded_assets.insert(acc, std::make_pair(asset->id, static_cast<AssetBase*>(asset)))) {
-				if constexpr (requires{ Derived::Initialize(); }) {
-					asset->Initialize();
-				}
+			if (s_loaded_assets.insert(acc, std::make_pair(assets[i]->id, static_cast<AssetBase*>(assets[i]))) || !TryAcquire(*acc->second)) {
+				// New, or replacing a resident copy whose last reference is being released.
+				// The batch's reference is taken under the accessor, as in LoadConfiguration().
+				acc->second = assets[i];
+				assets[i]->ref_count.fetch_add(1u, std::memory_order::relaxed);
+				CountResidencyMiss(assets[i]->type);
 			}
 			else {
-				// Already exists, use existing
+				// Published by another loader since it was looked up above (TryAcquire() took our reference)
 				auto existing_asset = static_cast<Derived*>(acc->second);
-				delete asset;
-				asset = existing_asset;
-				// conf_type may be mismatched, but existing asset already has correct type
+				try {
+					if constexpr (requires{ Derived::Finalize(); }) {
+						assets[i]->Finalize();
+					}
+				}
+				catch (std::exception const& ex) {
+					log::Warning(ex.what());
+				}
+				delete assets[i];
+				assets[i] = existing_asset;
 			}
-		} catch (...) {
-			delete asset;
-			throw;
 		}
 
-		asset->ref_count.fetch_add(1u, std::memory_order::relaxed);
-		return { asset, conf_type };
+		for (std::size_t i = 0; i < count; ++i) {
+			if (results[i].asset) {
+				continue;
+			}
+			if (joined[i]) {
+				if (joined[i]->error) {
+					results[i].error = joined[i]->error;
+				}
+				else {
+					results[i].asset.emplace(*joined[i]->result);
+				}
+				continue;
+			}
+			if (owner[i] != kNoOwner && owner[i] != i) {
+				if (results[owner[i]].error) {
+					results[i].error = results[owner[i]].error;
+					continue;
+				}
+				// The owner's reference keeps the asset alive while this one is taken.
+				assets[i] = assets[owner[i]];
+				assets[i]->ref_count.fetch_add(1u, std::memory_order::relaxed);
+			}
+			if (results[i].error) {
+				continue;
+			}
+			// Adopts the reference taken above.
+			results[i].asset.emplace(assets[i], types[i]);
+			RecordManifest(keys[i], assets[i]->id, assets[i]->type, content_hashes[i]);
+			IndexPath(keys[i], { assets[i]->id, LoadTypeTag<Derived>(), types[i] });
+		}
+
+		return results;
+	}
+
+	export template <std::derived_from<AssetBase> Derived> auto LoadMany(std::span<fs::path const> rel_paths, AsyncFlag) {
+
+		struct Awaitable {
+
+			std::span<fs::path const> rel_paths;
+			std::vector<LoadResult<Derived>> results;
+			std::exception_ptr ex;
+
+			static constexpr bool await_ready() noexcept {
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> coro) {
+				fyuu_engine::concurrency::Jobs().Submit(
+					[this, coro]() {
+						try {
+							results = LoadMany<Derived>(rel_paths);
+						}
+						catch (std::exception const&) {
+							ex = std::current_exception();
+						}
+
+						try {
+							coro();
+						}
+						catch (std::exception const& ex) {
+							std::string msg = std::format("LoadMany(): Unhandled exception in coroutine, {}", ex.what());
+							Error(msg);
+						}
+					}
+				);
+			}
+
+			std::vector<LoadResult<Derived>> await_resume() {
+				if (ex) {
+					std::rethrow_exception(ex);
+				}
+				return std::move(results);
+			}
+
+		};
+
+		return Awaitable{ rel_paths, {}, nullptr };
+
 	}
 
 	export template <std::derived_from<AssetBase> Derived> ManagedAsset<Derived> CreateRelatively(
@@ -365,7 +1116,131 @@ namespace fyuu_engine::asset {
 		}
 
 		asset->ref_count.fetch_add(1u, std::memory_order::relaxed);
+		IndexPath(PathKey(rel_path), { uuid, LoadTypeTag<Derived>(), conf_type });
 		return { asset, conf_type };
 	}
 
+	/// The id of the asset at `rel_path` if it is resident or recorded in the manifest; never touches the file.
+	export std::optional<AssetID> AssetIDOf(fs::path const& rel_path) {
+		std::string key = PathKey(rel_path);
+		{
+			typename decltype(s_resident_paths)::const_accessor acc;
+			if (s_resident_paths.find(acc, key)) {
+				return acc->second.id;
+			}
+		}
+		typename decltype(s_manifest)::const_accessor acc;
+		if (s_manifest.find(acc, key)) {
+			return acc->second.id;
+		}
+		return std::nullopt;
+	}
+
+	/**
+	 * @brief Writes the manifest of every configuration file parsed so far, as YAML.
+	 *
+	 * Each entry maps a path to the id, asset type and content hash the file
+	 * had when it was parsed. Must not run concurrently with loads.
+	 */
+	export void SaveAssetManifest(fs::path const& path) {
+		YAML::Node root;
+		for (auto const& [key, entry] : s_manifest) {
+			YAML::Node node;
+			node["id"] = boost::uuids::to_string(entry.id);
+			node["type"] = static_cast<std::size_t>(entry.type);
+			node["hash"] = entry.content_hash;
+			root[key] = node;
+		}
+		std::ofstream f(path);
+		f << root;
+	}
+
+	/**
+	 * @brief Merges a manifest written by SaveAssetManifest() into the current one.
+	 *
+	 * A missing manifest is not an error; a project starts without one.
+	 */
+	export void LoadAssetManifest(fs::path const& path) {
+		if (!fs::exists(path)) {
+			return;
+		}
+		YAML::Node root = YAML::LoadFile(path.string());
+		boost::uuids::string_generator parse_id;
+		for (auto const& item : root) {
+			RecordManifest(
+				item.first.as<std::string>(),
+				parse_id(item.second["id"].as<std::string>()),
+				static_cast<AssetType>(item.second["type"].as<std::size_t>()),
+				item.second["hash"].as<std::uint64_t>()
+			);
+		}
+	}
+
+	export struct ResidencyStats {
+		/// Loads served by reviving an unreferenced asset.
+		std::size_t hits = 0;
+		/// Loads that had to parse a file.
+		std::size_t misses = 0;
+		std::size_t evictions = 0;
+		std::size_t cold_assets = 0;
+		std::size_t cold_bytes = 0;
+		std::size_t budget = 0;
+	};
+
+	/**
+	 * @brief Sets how many bytes of unreferenced assets of `type` stay resident.
+	 *
+	 * Assets are charged ResidentBytes() if they have it, and otherwise
+	 * sizeof() plus the size of their configuration file. A budget of zero
+	 * evicts on the last release, as if there were no cold list. Lowering
+	 * the budget evicts at once.
+	 */
+	export void SetResidencyBudget(AssetType type, std::size_t bytes) {
+		std::vector<ColdAsset> victims;
+		{
+			std::lock_guard lock(s_residency_mutex);
+			TypeResidency& residency = s_residency[type];
+			residency.budget = bytes;
+			TakeOverBudget(residency, victims);
+		}
+		EvictAll(victims);
+	}
+
+	export ResidencyStats ResidencyStatsOf(AssetType type) {
+		std::lock_guard lock(s_residency_mutex);
+		TypeResidency const& residency = s_residency[type];
+		return {
+			.hits = residency.hits,
+			.misses = residency.misses,
+			.evictions = residency.evictions,
+			.cold_assets = residency.cold.size(),
+			.cold_bytes = residency.cold_bytes,
+			.budget = residency.budget
+		};
+	}
+
+	/**
+	 * @brief Evicts every unreferenced asset, finalizing and saving it.
+	 *
+	 * Releasing the last reference does not save an asset, so cold assets
+	 * are only written back when they are evicted. The application calls
+	 * this on shutdown; call it under memory pressure too. Dependencies
+	 * that become unreferenced through an eviction are evicted too.
+	 */
+	export void TrimResidency() {
+		std::vector<ColdAsset> victims;
+		do {
+			victims.clear();
+			{
+				std::lock_guard lock(s_residency_mutex);
+				for (auto& [type, residency] : s_residency) {
+					std::size_t budget = std::exchange(residency.budget, 0u);
+					TakeOverBudget(residency, victims);
+					residency.budget = budget;
+				}
+			}
+			EvictAll(victims);
+		} while (!victims.empty());
+	}
+
 }
\ No newline at end of file
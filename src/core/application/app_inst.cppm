@@ -17,6 +17,7 @@ export module fyuu_engine:app_instance;
 import std;
 #endif // defined(__cpp_lib_modules)
 import :log;
+import :managed_asset;
 import :renderer_instance;
 
 namespace fs = std::filesystem;
@@ -159,6 +160,8 @@ namespace fyuu_engine::application {
 		if (s_app->Shutdown) {
 			s_app->Shutdown(s_app);
 		}
+		// Finalizes and saves the assets the application released.
+		asset::TrimResidency();
 		DestroyMainSurface();
 		log::Info("Engine shutdown successfully");
 		log::Shutdown();
@@ -0,0 +1,89 @@
+module;
+#include <version>
+#if !defined(__cpp_lib_modules)
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#endif // !defined(__cpp_lib_modules)
+#include "fyuu_job.h"
+export module fyuu_engine:job_system;
+#if defined(__cpp_lib_modules)
+import std;
+#endif // defined(__cpp_lib_modules)
+import plastic.job_system;
+import :log;
+
+namespace fyuu_engine::concurrency {
+
+	/// The engine-wide scheduler shared by asset I/O, pipeline compilation and the application.
+	export plastic::concurrency::JobSystem& Jobs() {
+		static plastic::concurrency::JobSystem s_jobs;
+		return s_jobs;
+	}
+
+}
+
+namespace {
+
+	plastic::concurrency::JobCounter* ToJobCounter(Fyuu_JobCounter* counter) noexcept {
+		return reinterpret_cast<plastic::concurrency::JobCounter*>(counter);
+	}
+
+	plastic::concurrency::JobPriority ToJobPriority(Fyuu_JobPriority priority) noexcept {
+		switch (priority) {
+		case FYUU_JOB_PRIORITY_HIGH:
+			return plastic::concurrency::JobPriority::High;
+		case FYUU_JOB_PRIORITY_LOW:
+			return plastic::concurrency::JobPriority::Low;
+		default:
+			return plastic::concurrency::JobPriority::Normal;
+		}
+	}
+
+}
+
+extern "C" {
+
+	LIB_API uint32_t LIB_CALL Fyuu_GetJobWorkerCount(void) {
+		return static_cast<uint32_t>(fyuu_engine::concurrency::Jobs().WorkerCount());
+	}
+
+	LIB_API Fyuu_JobCounter* LIB_CALL Fyuu_CreateJobCounter(void) {
+		return reinterpret_cast<Fyuu_JobCounter*>(new plastic::concurrency::JobCounter());
+	}
+
+	LIB_API void LIB_CALL Fyuu_DestroyJobCounter(Fyuu_JobCounter* counter) {
+		delete ToJobCounter(counter);
+	}
+
+	LIB_API void LIB_CALL Fyuu_SubmitJob(Fyuu_JobFunc func, void* user_data, Fyuu_JobPriority priority, Fyuu_JobCounter* counter) {
+		fyuu_engine::concurrency::Jobs().Submit(
+			[func, user_data]() {
+				func(user_data);
+			},
+			ToJobPriority(priority),
+			ToJobCounter(counter)
+		);
+	}
+
+	LIB_API void LIB_CALL Fyuu_WaitJobCounter(Fyuu_JobCounter* counter) {
+		try {
+			fyuu_engine::concurrency::Jobs().Wait(*ToJobCounter(counter));
+		}
+		catch (std::exception const& ex) {
+			fyuu_engine::log::Error(std::format("Fyuu_WaitJobCounter(): {}", ex.what()));
+		}
+	}
+
+	LIB_API void LIB_CALL Fyuu_ParallelFor(size_t first, size_t last, size_t grain, Fyuu_RangeFunc func, void* user_data) {
+		fyuu_engine::concurrency::Jobs().ParallelFor(
+			first, last,
+			[func, user_data](std::size_t begin, std::size_t end) {
+				func(begin, end, user_data);
+			},
+			grain
+		);
+	}
+
+}
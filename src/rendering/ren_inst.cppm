@@ -47,6 +47,7 @@ import std;
 #endif // defined(__cpp_lib_modules)
 import :log;
 import fyuu_rhi;
+import plastic.static_hash_table;
 
 namespace {
 
@@ -304,15 +305,6 @@ namespace {
 #endif // defined(_WIN32)
 	}
 
-	constexpr std::size_t HashCString(std::string_view sv) noexcept {
-		std::size_t hash = 14695981039346656037ULL; // FNV offset basis
-		for (char c : sv) {
-			hash ^= static_cast<std::size_t>(c);
-			hash *= 1099511628211ULL; // FNV prime
-		}
-		return hash;
-	}
-
 }
 
 namespace fyuu_engine::rendering {
@@ -321,47 +313,26 @@ namespace fyuu_engine::rendering {
 
 		using InitFunc = void(*)(SDL_Window*, Fyuu_App*);
 
-		struct APIEntry {
-			std::size_t hash;
-			InitFunc Init;
-		};
-
-		using Table = std::array<APIEntry, 5u>;
-
-		static constexpr Table api_table = []() {
-			Table table{};
-			std::size_t idx = 0;
-
-			auto Add = [&](std::string_view name, InitFunc f) {
-				table[idx++] = { HashCString(name), f };
-				};
-
-			Add("platformdefault", InitializePlatformDefault);
-			Add("webgpu", InitializeWebGPU);
+		static constexpr auto api_table = plastic::ds::MakePerfectHashMap<std::string_view, InitFunc>({
+			{ "platformdefault", InitializePlatformDefault },
+			{ "webgpu", InitializeWebGPU },
 #if defined(_WIN32)
-			Add("d3d12", InitializeD3D12);
-			Add("vulkan", InitializeVulkan);
-			Add("opengl", InitializeOpenGL);
+			{ "d3d12", InitializeD3D12 },
+			{ "vulkan", InitializeVulkan },
+			{ "opengl", InitializeOpenGL },
 #elif defined(__APPLE__)
-			Add("metal", InitializeMetal);
+			{ "metal", InitializeMetal },
 #elif defined(__linux__)
-			Add("vulkan", InitializeVulkan);
-			Add("opengl", InitializeOpenGL);
+			{ "vulkan", InitializeVulkan },
+			{ "opengl", InitializeOpenGL },
 #elif defined(__ANDROID__)
-			Add("vulkan", InitializeVulkan);
-			Add("opengl", InitializeOpenGL);
+			{ "vulkan", InitializeVulkan },
+			{ "opengl", InitializeOpenGL },
 #endif // defined(_WIN32)
-			return table;
-			}();
+			});
 
-		InitFunc Init = nullptr;
-		std::size_t hash = HashCString(graphics_api);
-		for (auto const& entry : api_table) {
-			if (entry.hash == hash) {
-				Init = entry.Init;
-				break;
-			}
-		}
+		auto entry = api_table.find(graphics_api);
+		InitFunc Init = entry != api_table.end() ? entry->second : nullptr;
 
 		if (!Init) {
 			throw std::runtime_error("rendering::Initialize(): Unknown graphics API to initialize with");